@@ -0,0 +1,17 @@
+#ifndef BENCHMARKS_ALLOCATIONCOUNTER_HPP
+#define BENCHMARKS_ALLOCATIONCOUNTER_HPP
+
+#include <cstddef>
+
+namespace PrismBench {
+
+/**
+ * @brief Gets the number of calls to the global operator new since the program started.
+ * @note prismBench replaces the global allocation functions, so allocations made inside
+ * libPrism are counted as well.
+ */
+size_t allocationCount();
+
+} // namespace PrismBench
+
+#endif // BENCHMARKS_ALLOCATIONCOUNTER_HPP
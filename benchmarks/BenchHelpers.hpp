@@ -0,0 +1,106 @@
+#ifndef BENCHMARKS_BENCHHELPERS_HPP
+#define BENCHMARKS_BENCHHELPERS_HPP
+
+#include "AllocationCounter.hpp"
+#include "Prism/aabb.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/vector.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace PrismBench {
+
+using Prism::ld;
+
+/**
+ * @brief Bounded sphere used to build the fixed benchmark scenes.
+ */
+class Sphere : public Prism::Object {
+  public:
+    Sphere(const Prism::Point3& center, ld radius) : center(center), radius(radius) {
+    }
+
+    bool hit(const Prism::Ray& ray, ld t_min, ld t_max, Prism::HitRecord& rec) const override {
+        Prism::Vector3 oc = ray.origin - center;
+        ld half_b = oc.dot(ray.direction);
+        ld c = oc.dot(oc) - radius * radius;
+        ld discriminant = half_b * half_b - c;
+        if (discriminant < 0) {
+            return false;
+        }
+
+        ld sqrtd = std::sqrt(discriminant);
+        ld root = -half_b - sqrtd;
+        if (root <= t_min || root >= t_max) {
+            root = -half_b + sqrtd;
+            if (root <= t_min || root >= t_max) {
+                return false;
+            }
+        }
+
+        rec.t = root;
+        rec.p = ray.origin + ray.direction * root;
+        rec.material = nullptr;
+        rec.set_face_normal(ray, (rec.p - center) / radius);
+        return true;
+    }
+
+    bool boundingBox(Prism::AABB& box) const override {
+        Prism::Vector3 extent(radius, radius, radius);
+        box = Prism::AABB(center + extent * -1, center + extent);
+        return true;
+    }
+
+    Prism::Point3 center;
+    ld radius;
+};
+
+/**
+ * @brief Publishes the allocations made while rays were processed, and fails the benchmark if
+ * there were any: the per-ray paths must never touch the heap.
+ * @param state The benchmark state.
+ * @param allocations Number of allocations counted inside the measured loop.
+ * @param rays Number of rays processed inside the measured loop.
+ */
+inline void ReportAllocationsPerRay(benchmark::State& state, size_t allocations, size_t rays) {
+    state.counters["allocs_per_ray"] =
+        rays == 0 ? 0.0 : static_cast<double>(allocations) / static_cast<double>(rays);
+    if (allocations != 0) {
+        state.SkipWithError("heap allocation inside the per-ray loop");
+    }
+}
+
+/**
+ * @brief Builds an n x n vertex grid spanning [-size / 2, size / 2) in x and y, two triangles per
+ * cell, without normals or materials.
+ * @param n The number of vertices along each side.
+ * @param size The extent of the grid along x and y.
+ * @param height Called as height(x, y) for the z coordinate of every vertex.
+ */
+template <typename Height> Prism::MeshData GridMesh(uint32_t n, float size, Height&& height) {
+    Prism::MeshData grid;
+    for (uint32_t j = 0; j < n; ++j) {
+        for (uint32_t i = 0; i < n; ++i) {
+            const float x = size * (float(i) / n - 0.5f), y = size * (float(j) / n - 0.5f);
+            grid.positions.insert(grid.positions.end(), {x, y, height(x, y)});
+        }
+    }
+    for (uint32_t j = 0; j + 1 < n; ++j) {
+        for (uint32_t i = 0; i + 1 < n; ++i) {
+            const uint32_t a = j * n + i;
+            grid.indices.insert(grid.indices.end(), {a, a + 1, a + n + 1, a, a + n + 1, a + n});
+        }
+    }
+    grid.normal_indices.assign(grid.indices.size(), Prism::MeshData::kNoIndex);
+    grid.material_ids.assign(grid.indices.size() / 3, Prism::MeshData::kNoIndex);
+    return grid;
+}
+
+} // namespace PrismBench
+
+#endif // BENCHMARKS_BENCHHELPERS_HPP
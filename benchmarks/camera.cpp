@@ -0,0 +1,78 @@
+#include "AllocationCounter.hpp"
+#include "BenchHelpers.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/ray_packet.hpp"
+#include "Prism/vector.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace Prism;
+using PrismBench::allocationCount;
+using PrismBench::ReportAllocationsPerRay;
+
+// Generates every primary ray of the image through CameraIterator.
+static void BM_CameraIterator(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, size, size);
+
+    size_t allocations = 0;
+    size_t rays = 0;
+    for (auto _ : state) {
+        const size_t before = allocationCount();
+        for (const Ray& ray : cam) {
+            benchmark::DoNotOptimize(ray);
+        }
+        allocations += allocationCount() - before;
+        rays += static_cast<size_t>(size) * size;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(rays));
+    ReportAllocationsPerRay(state, allocations, rays);
+}
+BENCHMARK(BM_CameraIterator)->Arg(64)->Arg(256);
+
+// Generates the same rays a RayPacket tile at a time.
+static void BM_CameraPacket(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, size, size);
+
+    size_t rays = 0;
+    RayPacket packet;
+    for (auto _ : state) {
+        for (int y0 = 0; y0 < size; y0 += RayPacket::kHeight) {
+            for (int x0 = 0; x0 < size; x0 += RayPacket::kWidth) {
+                cam.getPacket(x0, y0, packet);
+                benchmark::DoNotOptimize(packet);
+            }
+        }
+        rays += static_cast<size_t>(size) * size;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(rays));
+}
+BENCHMARK(BM_CameraPacket)->Arg(64)->Arg(256);
+
+// Moves the camera to a new view per frame, by rebuilding it (arg 0) or through its setters
+// (arg 1), as an animation does between frames.
+static void BM_CameraUpdate(benchmark::State& state) {
+    const bool rebuild = state.range(0) == 0;
+    Camera cam(Point3(0, 0, 4), Point3(0, 0, 0), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 256, 256);
+
+    size_t frame = 0;
+    size_t allocations = 0;
+    for (auto _ : state) {
+        const Point3 position(frame % 7, 1, 4);
+        const size_t before = allocationCount();
+        if (rebuild) {
+            Camera moved(position, Point3(0, 0, 0), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 256, 256);
+            benchmark::DoNotOptimize(moved.getRay(0, 0));
+        } else {
+            cam.lookAt(position, Point3(0, 0, 0));
+            benchmark::DoNotOptimize(cam.getRay(0, 0));
+        }
+        allocations += allocationCount() - before;
+        ++frame;
+    }
+    state.counters["allocs/update"] =
+        benchmark::Counter(static_cast<double>(allocations) / static_cast<double>(frame));
+}
+BENCHMARK(BM_CameraUpdate)->Arg(0)->Arg(1);
@@ -0,0 +1,84 @@
+#include "AllocationCounter.hpp"
+#include "BenchHelpers.hpp"
+#include "Prism/fixed_matrix.hpp"
+#include "Prism/matrix.hpp"
+#include "Prism/point.hpp"
+#include "Prism/vector.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+
+using namespace Prism;
+
+static void BM_Vector3Normalize(benchmark::State& state) {
+    Vector3 v(1, 2, 3);
+    for (auto _ : state) {
+        Vector3 n = v.normalize();
+        benchmark::DoNotOptimize(n);
+        v.x += 1e-3;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Vector3Normalize);
+
+static void BM_Vector3DotCross(benchmark::State& state) {
+    Vector3 a(1, 2, 3);
+    const Vector3 b(-2, 0.5, 4);
+    for (auto _ : state) {
+        Vector3 c = a.cross(b);
+        ld d = a.dot(c);
+        benchmark::DoNotOptimize(c);
+        benchmark::DoNotOptimize(d);
+        a.y += 1e-3;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Vector3DotCross);
+
+// Heap-backed Matrix product for square sizes given by the argument.
+static void BM_MatrixMultiply(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    Matrix<ld> a(n, n);
+    Matrix<ld> b(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            a[i][j] = static_cast<ld>(i + 2 * j) / n;
+            b[i][j] = static_cast<ld>(2 * i + j) / n;
+        }
+    }
+    size_t allocations = 0;
+    for (auto _ : state) {
+        const size_t before = PrismBench::allocationCount();
+        Matrix<ld> c = a * b;
+        allocations += PrismBench::allocationCount() - before;
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs_per_op"] = benchmark::Counter(
+        static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_MatrixMultiply)->Arg(3)->Arg(4)->Arg(16);
+
+// The same 4x4 product with the stack-allocated Mat4, for comparison with BM_MatrixMultiply/4.
+static void BM_Mat4Multiply(benchmark::State& state) {
+    Mat4 a = rotation(Vector3(1, 1, 0), 0.3) * translation(Vector3(1, 2, 3));
+    const Mat4 b = scaling(Vector3(2, 2, 2)) * rotation(Vector3(0, 0, 1), 1.1);
+    for (auto _ : state) {
+        Mat4 c = a * b;
+        benchmark::DoNotOptimize(c);
+        a[0][3] += 1e-3;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Mat4Multiply);
+
+static void BM_Mat4TransformPoint(benchmark::State& state) {
+    const Mat4 m = rotation(Vector3(1, 1, 0), 0.3) * translation(Vector3(1, 2, 3));
+    Point3 p(1, 2, 3);
+    for (auto _ : state) {
+        Point3 q = transformPoint(m, p);
+        benchmark::DoNotOptimize(q);
+        p.x += 1e-3;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Mat4TransformPoint);
@@ -0,0 +1,137 @@
+#include "ObjReader/ObjReader.hpp"
+#include "Prism/aabb.hpp"
+#include "Prism/bvh.hpp"
+#include "Prism/mesh_cache.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/thread_pool.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * Writes (once) a size x size vertex grid as an OBJ file in the v/vt/vn face form that objReader
+ * expects, and returns its path and size in bytes.
+ */
+std::string syntheticObj(int size, int64_t& bytes) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                       ("prism_bench_grid_" + std::to_string(size) + ".obj");
+    if (!std::filesystem::exists(path)) {
+        std::ofstream out(path);
+        out << "vt 0 0\n";
+        for (int j = 0; j < size; ++j) {
+            for (int i = 0; i < size; ++i) {
+                const double x = double(i) / size;
+                const double z = double(j) / size;
+                out << "v " << x << " " << 0.25 * x * z << " " << -z << "\n";
+                out << "vn " << -0.25 * z << " 1 " << 0.25 * x << "\n";
+            }
+        }
+        for (int j = 0; j + 1 < size; ++j) {
+            for (int i = 0; i + 1 < size; ++i) {
+                const int a = j * size + i + 1;
+                const int b = a + 1;
+                const int c = a + size;
+                const int d = c + 1;
+                out << "f " << a << "/1/" << a << " " << b << "/1/" << b << " " << d << "/1/" << d
+                    << "\n";
+                out << "f " << a << "/1/" << a << " " << d << "/1/" << d << " " << c << "/1/" << c
+                    << "\n";
+            }
+        }
+    }
+    bytes = static_cast<int64_t>(std::filesystem::file_size(path));
+    return path.string();
+}
+
+} // namespace
+
+static void BM_ObjReader(benchmark::State& state) {
+    int64_t bytes = 0;
+    const std::string path = syntheticObj(static_cast<int>(state.range(0)), bytes);
+    for (auto _ : state) {
+        objReader reader(path);
+        benchmark::DoNotOptimize(reader.getFaces().size());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_ObjReader)->Arg(128)->Arg(512)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadObj(benchmark::State& state) {
+    int64_t bytes = 0;
+    const std::string path = syntheticObj(static_cast<int>(state.range(0)), bytes);
+    for (auto _ : state) {
+        Prism::MeshData mesh = Prism::loadObj(path);
+        benchmark::DoNotOptimize(mesh.triangleCount());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_LoadObj)->Arg(128)->Arg(512)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadObjParallel(benchmark::State& state) {
+    int64_t bytes = 0;
+    const std::string path = syntheticObj(static_cast<int>(state.range(0)), bytes);
+    Prism::ThreadPool pool;
+    for (auto _ : state) {
+        Prism::MeshData mesh = Prism::loadObj(path, &pool);
+        benchmark::DoNotOptimize(mesh.triangleCount());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["threads"] = static_cast<double>(pool.size());
+}
+BENCHMARK(BM_LoadObjParallel)->Arg(128)->Arg(512)->Unit(benchmark::kMillisecond);
+
+// Reopens the binary cache of the same mesh and sums its indices, so every page is read.
+static void BM_MeshCacheOpen(benchmark::State& state) {
+    int64_t bytes = 0;
+    const std::string obj_path = syntheticObj(static_cast<int>(state.range(0)), bytes);
+    const std::string path = obj_path + ".pmesh";
+    Prism::writeMeshCache(path, Prism::loadObj(obj_path));
+    for (auto _ : state) {
+        Prism::MeshCache cache(path);
+        uint64_t sum = 0;
+        for (uint32_t index : cache.indices()) {
+            sum += index;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_MeshCacheOpen)->Arg(128)->Arg(512)->Unit(benchmark::kMillisecond);
+
+// BVH build over the triangles of the loaded grid. Arg 1 is the method: 0 sweep, 1 binned, 2
+// binned on a pool of every hardware thread. The "sah" counter compares the tree quality.
+static void BM_BuildMeshBVH(benchmark::State& state) {
+    int64_t bytes = 0;
+    const Prism::MeshData mesh =
+        Prism::loadObj(syntheticObj(static_cast<int>(state.range(0)), bytes));
+    std::vector<Prism::AABB> bounds(mesh.triangleCount());
+    for (size_t t = 0; t < bounds.size(); ++t) {
+        for (size_t k = 3 * t; k < 3 * t + 3; ++k) {
+            const float* p = &mesh.positions[3 * size_t(mesh.indices[k])];
+            bounds[t].expand(Prism::Point3(p[0], p[1], p[2]));
+        }
+    }
+
+    Prism::ThreadPool pool;
+    Prism::BVHBuildOptions options;
+    options.method = state.range(1) == 0 ? Prism::BVHBuildMethod::Sweep
+                                         : Prism::BVHBuildMethod::Binned;
+    options.pool = state.range(1) == 2 ? &pool : nullptr;
+    Prism::BVHTree tree;
+    for (auto _ : state) {
+        tree = Prism::BVHTree(bounds, options);
+        benchmark::DoNotOptimize(tree.nodes().data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bounds.size()));
+    state.counters["sah"] = static_cast<double>(tree.sahCost());
+    state.counters["threads"] = options.pool != nullptr ? static_cast<double>(pool.size()) : 1;
+}
+BENCHMARK(BM_BuildMeshBVH)
+    ->ArgsProduct({{128, 512}, {0, 1, 2}})
+    ->ArgNames({"grid", "method"})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,122 @@
+#include "AllocationCounter.hpp"
+#include "BenchHelpers.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/vector.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace Prism;
+using PrismBench::allocationCount;
+using PrismBench::ReportAllocationsPerRay;
+
+static void BM_RayConstruction(benchmark::State& state) {
+    const Point3 origin(0, 0, 0);
+    Point3 target(1, 2, 3);
+    size_t allocations = 0;
+    size_t rays = 0;
+
+    for (auto _ : state) {
+        const size_t before = allocationCount();
+        Ray ray(origin, target);
+        benchmark::DoNotOptimize(ray);
+        allocations += allocationCount() - before;
+        rays++;
+        target.x += 1e-3;
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(rays));
+    ReportAllocationsPerRay(state, allocations, rays);
+}
+BENCHMARK(BM_RayConstruction);
+
+// Camera ray generation followed by a scene query for every pixel: the single-threaded core of
+// the render loop.
+static void BM_RenderLoopPrimaryRays(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, size, size);
+
+    std::vector<std::unique_ptr<PrismBench::Sphere>> spheres;
+    std::vector<Object*> objects;
+    for (int i = -2; i <= 2; ++i) {
+        for (int j = -2; j <= 2; ++j) {
+            spheres.push_back(
+                std::make_unique<PrismBench::Sphere>(Point3(i * 0.8, j * 0.8, -4), 0.35));
+            objects.push_back(spheres.back().get());
+        }
+    }
+    Scene scene(objects);
+
+    size_t allocations = 0;
+    size_t rays = 0;
+    for (auto _ : state) {
+        const size_t before = allocationCount();
+        size_t hits = 0;
+        for (const Ray& ray : cam) {
+            HitRecord rec;
+            hits += scene.hit(ray, 0.001, 1000.0, rec) ? 1 : 0;
+        }
+        allocations += allocationCount() - before;
+        rays += static_cast<size_t>(size) * size;
+        benchmark::DoNotOptimize(hits);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(rays));
+    ReportAllocationsPerRay(state, allocations, rays);
+}
+BENCHMARK(BM_RenderLoopPrimaryRays)->Arg(64)->Arg(256);
+
+// Ray::Gethit over a plain object list: the linear scan the BVH replaces.
+static void BM_RayGethitObjects(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    std::vector<std::unique_ptr<PrismBench::Sphere>> spheres;
+    std::vector<Object*> objects;
+    for (int i = 0; i < count; ++i) {
+        spheres.push_back(std::make_unique<PrismBench::Sphere>(
+            Point3((i % 8) * 0.5 - 2, (i / 8 % 8) * 0.5 - 2, -4 - i / 64), 0.2));
+        objects.push_back(spheres.back().get());
+    }
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 32, 32);
+    std::vector<Ray> rays(cam.begin(), cam.end());
+
+    size_t processed = 0;
+    for (auto _ : state) {
+        for (Ray& ray : rays) {
+            HitRecord rec = ray.Gethit(objects, 0.001, 1000.0);
+            benchmark::DoNotOptimize(rec);
+        }
+        processed += rays.size();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(processed));
+}
+BENCHMARK(BM_RayGethitObjects)->Arg(16)->Arg(256);
+
+// Ray::Gethit through a Scene, over the same objects.
+static void BM_RayGethitScene(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    std::vector<std::unique_ptr<PrismBench::Sphere>> spheres;
+    std::vector<Object*> objects;
+    for (int i = 0; i < count; ++i) {
+        spheres.push_back(std::make_unique<PrismBench::Sphere>(
+            Point3((i % 8) * 0.5 - 2, (i / 8 % 8) * 0.5 - 2, -4 - i / 64), 0.2));
+        objects.push_back(spheres.back().get());
+    }
+    Scene scene(objects);
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 32, 32);
+    std::vector<Ray> rays(cam.begin(), cam.end());
+
+    size_t processed = 0;
+    for (auto _ : state) {
+        for (Ray& ray : rays) {
+            HitRecord rec = ray.Gethit(scene, 0.001, 1000.0);
+            benchmark::DoNotOptimize(rec);
+        }
+        processed += rays.size();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(processed));
+}
+BENCHMARK(BM_RayGethitScene)->Arg(16)->Arg(256);
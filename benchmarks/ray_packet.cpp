@@ -0,0 +1,93 @@
+#include "AllocationCounter.hpp"
+#include "BenchHelpers.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/ray_packet.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/triangle_mesh.hpp"
+#include "Prism/vector.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Prism;
+using PrismBench::allocationCount;
+using PrismBench::ReportAllocationsPerRay;
+
+namespace {
+
+// A bumpy 128x128 grid filling the view, with a row of spheres in front of it.
+struct PrimaryScene {
+    PrimaryScene() {
+        mesh = std::make_unique<TriangleMesh>(PrismBench::GridMesh(
+            128, 8, [](float x, float y) { return -4 + 0.2f * std::sin(3 * x * y); }));
+
+        std::vector<Object*> objects = {mesh.get()};
+        for (int i = -2; i <= 2; ++i) {
+            spheres.push_back(std::make_unique<PrismBench::Sphere>(Point3(i * 0.8, 0, -2), 0.3));
+            objects.push_back(spheres.back().get());
+        }
+        scene = Scene(objects);
+    }
+
+    std::unique_ptr<TriangleMesh> mesh;
+    std::vector<std::unique_ptr<PrismBench::Sphere>> spheres;
+    Scene scene;
+};
+
+} // namespace
+
+// Primary visibility one ray at a time, as the render loop traces it.
+static void BM_PrimaryRaysSingle(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, size, size);
+    PrimaryScene primary;
+
+    size_t rays = 0;
+    for (auto _ : state) {
+        size_t hits = 0;
+        for (const Ray& ray : cam) {
+            HitRecord rec;
+            hits += primary.scene.hit(ray, 0.001, 1000.0, rec) ? 1 : 0;
+        }
+        rays += static_cast<size_t>(size) * size;
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(rays));
+}
+BENCHMARK(BM_PrimaryRaysSingle)->Arg(256);
+
+// The same image traced in RayPacket tiles: one BVH traversal per tile.
+static void BM_PrimaryRaysPacket(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, size, size);
+    PrimaryScene primary;
+
+    size_t allocations = 0;
+    size_t rays = 0;
+    RayPacket packet;
+    PacketHit hits;
+    for (auto _ : state) {
+        const size_t before = allocationCount();
+        size_t hit_count = 0;
+        for (int y0 = 0; y0 < size; y0 += RayPacket::kHeight) {
+            for (int x0 = 0; x0 < size; x0 += RayPacket::kWidth) {
+                cam.getPacket(x0, y0, packet);
+                primary.scene.hit(packet, 0.001, 1000.0, hits);
+                for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+                    hit_count += hits.hit[lane] ? 1 : 0;
+                }
+            }
+        }
+        allocations += allocationCount() - before;
+        rays += static_cast<size_t>(size) * size;
+        benchmark::DoNotOptimize(hit_count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(rays));
+    ReportAllocationsPerRay(state, allocations, rays);
+}
+BENCHMARK(BM_PrimaryRaysPacket)->Arg(256);
@@ -0,0 +1,239 @@
+#include "BenchHelpers.hpp"
+#include "Prism/accumulator.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/image.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/renderer.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/shadow_queue.hpp"
+#include "Prism/triangle_mesh.hpp"
+#include "Prism/vector.hpp"
+#include "Prism/wavefront.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Prism;
+
+namespace {
+
+// Renders the scene at 256x256 with normal shading; items per second are primary rays. The
+// argument is the renderer thread count (0 = hardware threads).
+void RenderScene(benchmark::State& state, const Scene& scene) {
+    const int size = 256;
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, size, size);
+    Renderer renderer(static_cast<size_t>(state.range(0)));
+    const Renderer::Shader shade = [&scene](const Ray& ray) {
+        HitRecord rec;
+        if (!scene.hit(ray, 0.001, 1000.0, rec)) {
+            return Vector3(0, 0, 0);
+        }
+        return (rec.normal + Vector3(1, 1, 1)) * 0.5;
+    };
+
+    size_t rays = 0;
+    for (auto _ : state) {
+        Image image = renderer.render(cam, shade);
+        benchmark::DoNotOptimize(image);
+        rays += static_cast<size_t>(size) * size;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(rays));
+    state.counters["threads"] = static_cast<double>(renderer.threadCount());
+}
+
+// An n x n vertex grid spanning [-4, 4] in x and y around z = -4, with a gentle bump.
+MeshData BumpyGrid(uint32_t n) {
+    return PrismBench::GridMesh(
+        n, 8, [](float x, float y) { return -4 + 0.2f * std::sin(3 * x * y); });
+}
+
+// Adds a 10x10 wall of spheres centred on the z axis, `spacing` apart, sphere (i, j) at depth
+// depth(i, j). The spheres are owned by `spheres` and listed in `objects`.
+template <typename Depth>
+void AddSphereWall(std::vector<std::unique_ptr<PrismBench::Sphere>>& spheres,
+                   std::vector<Object*>& objects, ld spacing, ld radius, Depth&& depth) {
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            spheres.push_back(std::make_unique<PrismBench::Sphere>(
+                Point3((i - 4.5) * spacing, (j - 4.5) * spacing, depth(i, j)), radius));
+            objects.push_back(spheres.back().get());
+        }
+    }
+}
+
+// The inside of the box [-5, 5]^3, as 12 triangles.
+MeshData Room() {
+    MeshData room;
+    for (int i = 0; i < 8; ++i) {
+        room.positions.insert(room.positions.end(), {i & 1 ? 5.0f : -5.0f, i & 2 ? 5.0f : -5.0f,
+                                                     i & 4 ? 5.0f : -5.0f});
+    }
+    room.indices = {0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1,
+                    2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3};
+    room.normal_indices.assign(room.indices.size(), MeshData::kNoIndex);
+    room.material_ids.assign(room.indices.size() / 3, MeshData::kNoIndex);
+    return room;
+}
+
+} // namespace
+
+// Fixed scene: a 10x10 wall of spheres.
+static void BM_RenderSpheres(benchmark::State& state) {
+    std::vector<std::unique_ptr<PrismBench::Sphere>> spheres;
+    std::vector<Object*> objects;
+    AddSphereWall(spheres, objects, 0.4, 0.18,
+                  [](int i, int j) { return -4 - 0.1 * ((i + j) % 3); });
+    RenderScene(state, Scene(objects));
+}
+BENCHMARK(BM_RenderSpheres)->Arg(1)->Arg(0)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Fixed scene: a bumpy 128x128 triangle grid filling the view.
+static void BM_RenderMesh(benchmark::State& state) {
+    TriangleMesh mesh(BumpyGrid(128));
+    RenderScene(state, Scene({&mesh}));
+}
+BENCHMARK(BM_RenderMesh)->Arg(1)->Arg(0)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Shadow rays from points on the bumpy grid to 16 lights behind a wall of spheres, as a
+// light-heavy direct lighting pass would trace them. Arg 0 answers each with a closest-hit
+// query clipped at the light, arg 1 with Scene::occluded.
+static void BM_ShadowRays(benchmark::State& state) {
+    const bool any_hit = state.range(0) == 1;
+    TriangleMesh mesh(BumpyGrid(128));
+    std::vector<std::unique_ptr<PrismBench::Sphere>> spheres;
+    std::vector<Object*> objects{&mesh};
+    AddSphereWall(spheres, objects, 0.8, 0.3, [](int, int) { return -2.5; });
+    const Scene scene(objects);
+
+    std::vector<Point3> lights;
+    for (int i = 0; i < 16; ++i) {
+        lights.emplace_back(3 * std::cos(i * 0.4), 3 * std::sin(i * 0.4), 2);
+    }
+    std::vector<Point3> points;
+    for (int j = 0; j < 32; ++j) {
+        for (int i = 0; i < 32; ++i) {
+            const ld x = (i - 15.5) * 0.2, y = (j - 15.5) * 0.2;
+            points.emplace_back(x, y, -4 + 0.2 * std::sin(3 * x * y) + 0.01);
+        }
+    }
+
+    size_t rays = 0;
+    for (auto _ : state) {
+        int blocked = 0;
+        for (const Point3& p : points) {
+            for (const Point3& light : lights) {
+                const Vector3 to_light = light - p;
+                const ld distance = to_light.magnitude();
+                const Ray ray(p, to_light);
+                if (any_hit) {
+                    blocked += scene.occluded(ray, 0.001, distance);
+                } else {
+                    HitRecord rec;
+                    blocked += scene.hit(ray, 0.001, distance, rec);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(blocked);
+        state.counters["blocked"] = static_cast<double>(blocked);
+        rays += points.size() * lights.size();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(rays));
+}
+BENCHMARK(BM_ShadowRays)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// The same lights over a bumpy 512x512 grid, from random points and in random order like the
+// secondary rays of a path tracer. Arg 0 answers each with a closest-hit query clipped at the
+// light, arg 1 with Scene::occluded, arg 2 queues them in a ShadowQueue and traces them sorted.
+static void BM_ShadowRaysIncoherent(benchmark::State& state) {
+    const int mode = static_cast<int>(state.range(0));
+    TriangleMesh mesh(BumpyGrid(512));
+    std::vector<std::unique_ptr<PrismBench::Sphere>> spheres;
+    std::vector<Object*> objects{&mesh};
+    AddSphereWall(spheres, objects, 0.8, 0.3, [](int, int) { return -2.5; });
+    const Scene scene(objects);
+
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<double> coord(-3.9, 3.9);
+    std::vector<Ray> rays;
+    std::vector<ld> distances;
+    for (int i = 0; i < 4096; ++i) {
+        const ld x = coord(gen), y = coord(gen);
+        const Point3 p(x, y, -4 + 0.2 * std::sin(3 * x * y) + 0.01);
+        for (int k = 0; k < 16; ++k) {
+            const Point3 light(3 * std::cos(k * 0.4), 3 * std::sin(k * 0.4), 2);
+            rays.emplace_back(p, light - p);
+            distances.push_back((light - p).magnitude());
+        }
+    }
+    std::vector<size_t> order(rays.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), gen);
+
+    ShadowQueue queue;
+    size_t traced = 0;
+    for (auto _ : state) {
+        size_t blocked = 0;
+        for (size_t i : order) {
+            if (mode == 2) {
+                queue.push(rays[i], 0.001, distances[i], Vector3(1, 1, 1));
+            } else if (mode == 1) {
+                blocked += scene.occluded(rays[i], 0.001, distances[i]);
+            } else {
+                HitRecord rec;
+                blocked += scene.hit(rays[i], 0.001, distances[i], rec);
+            }
+        }
+        if (mode == 2) {
+            blocked = queue.trace(scene, [](const ShadowRay&) {});
+        }
+        benchmark::DoNotOptimize(blocked);
+        state.counters["blocked"] = static_cast<double>(blocked);
+        traced += rays.size();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(traced));
+}
+BENCHMARK(BM_ShadowRaysIncoherent)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
+
+// High-bounce interior: the camera inside a closed room over a wall of spheres, lit by two point
+// lights. One pass of 128x128 paths with up to 8 bounces; items per second are extension and
+// shadow rays, and the counters give the share of the time spent in each stage.
+static void BM_WavefrontInterior(benchmark::State& state) {
+    TriangleMesh room(Room());
+    std::vector<std::unique_ptr<PrismBench::Sphere>> spheres;
+    std::vector<Object*> objects{&room};
+    AddSphereWall(spheres, objects, 0.8, 0.3, [](int, int) { return -3.0; });
+    const Scene scene(objects);
+    const int size = 128;
+    Camera cam(Point3(0, 0, 4), Point3(0, 0, -3), Vector3(0, 1, 0), 1.0, 2.0, 2.0, size, size);
+
+    WavefrontSettings settings;
+    settings.max_depth = 8;
+    WavefrontIntegrator integrator(static_cast<size_t>(state.range(0)), settings);
+    integrator.setLights({{Point3(-3, 4, 0), Vector3(30, 30, 30)},
+                          {Point3(3, -4, 2), Vector3(20, 20, 30)}});
+    Accumulator accumulator(size, size);
+    for (auto _ : state) {
+        integrator.renderPass(cam, scene, accumulator);
+    }
+
+    const WavefrontStats& stats = integrator.stats();
+    state.SetItemsProcessed(static_cast<int64_t>(stats.extension_rays + stats.shadow_rays));
+    double total = 0;
+    for (double seconds : stats.stage_seconds) {
+        total += seconds;
+    }
+    for (int stage = 0; stage < kWavefrontStageCount; ++stage) {
+        state.counters[wavefrontStageName(static_cast<WavefrontStage>(stage))] =
+            total > 0 ? stats.stage_seconds[stage] / total : 0;
+    }
+    state.counters["threads"] = static_cast<double>(integrator.threadCount());
+}
+BENCHMARK(BM_WavefrontInterior)->Arg(1)->Arg(0)->UseRealTime()->Unit(benchmark::kMillisecond);
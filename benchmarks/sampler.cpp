@@ -0,0 +1,46 @@
+#include "Prism/sampler.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+
+using namespace Prism;
+
+// Draws the pixel jitter and two light-sample dimensions of every sample of a 64x64 tile, as a
+// progressive pass would.
+template <typename Draw> static void DrawTile(benchmark::State& state, Draw draw) {
+    const uint32_t samples = static_cast<uint32_t>(state.range(0));
+    for (auto _ : state) {
+        for (uint32_t index = 0; index < samples; ++index) {
+            for (int y = 0; y < 64; ++y) {
+                for (int x = 0; x < 64; ++x) {
+                    draw(x, y, index);
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * samples * 64 * 64);
+}
+
+// Baseline: independent values from std::mt19937, the usual default.
+static void BM_SamplerMt19937(benchmark::State& state) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<ld> uniform(0, 1);
+    DrawTile(state, [&](int, int, uint32_t) {
+        benchmark::DoNotOptimize(uniform(gen) + uniform(gen));
+        benchmark::DoNotOptimize(uniform(gen) + uniform(gen));
+    });
+}
+BENCHMARK(BM_SamplerMt19937)->Arg(4);
+
+template <typename S> static void BM_Sampler(benchmark::State& state) {
+    S sampler;
+    DrawTile(state, [&](int x, int y, uint32_t index) {
+        sampler.startPixelSample(x, y, index);
+        const Sample2D pixel = sampler.get2D();
+        const Sample2D light = sampler.get2D();
+        benchmark::DoNotOptimize(pixel.u + pixel.v);
+        benchmark::DoNotOptimize(light.u + light.v);
+    });
+}
+BENCHMARK_TEMPLATE(BM_Sampler, SobolSampler)->Arg(4);
+BENCHMARK_TEMPLATE(BM_Sampler, BlueNoiseSampler)->Arg(4);
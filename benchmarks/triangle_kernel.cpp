@@ -0,0 +1,105 @@
+#include "BenchHelpers.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/triangle_kernel.hpp"
+#include "Prism/triangle_mesh.hpp"
+#include "Prism/vector.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Prism;
+
+namespace {
+
+// Switches the kernel for one benchmark, or skips it if the processor lacks the instructions.
+bool UseLevel(benchmark::State& state, SimdLevel level) {
+    const SimdLevel best = detectSimdLevel();
+    if (static_cast<int>(level) > static_cast<int>(best)) {
+        state.SkipWithError("Instruction set not supported by this processor");
+        return false;
+    }
+    setSimdLevel(level);
+    state.SetLabel(simdLevelName(level));
+    return true;
+}
+
+} // namespace
+
+// Raw kernel throughput: random rays against a ring of random triangle blocks.
+static void BM_TriangleBlock(benchmark::State& state) {
+    if (!UseLevel(state, static_cast<SimdLevel>(state.range(0)))) {
+        return;
+    }
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> pos(-1.0f, 1.0f);
+    std::vector<TriangleBlock> blocks(256);
+    for (TriangleBlock& block : blocks) {
+        for (int lane = 0; lane < kTriangleBlockWidth; ++lane) {
+            const float p0[3] = {pos(gen), pos(gen), pos(gen) - 3};
+            const float p1[3] = {pos(gen), pos(gen), pos(gen) - 3};
+            const float p2[3] = {pos(gen), pos(gen), pos(gen) - 3};
+            block.set(lane, p0, p1, p2);
+        }
+    }
+    std::vector<BlockRay> rays(64);
+    for (BlockRay& ray : rays) {
+        const float dx = pos(gen) / 3, dy = pos(gen) / 3;
+        const float inv = 1 / std::sqrt(dx * dx + dy * dy + 1);
+        ray = {{0, 0, 0}, {dx * inv, dy * inv, -inv}};
+    }
+
+    size_t tests = 0;
+    int hits = 0;
+    for (auto _ : state) {
+        for (const BlockRay& ray : rays) {
+            for (const TriangleBlock& block : blocks) {
+                BlockHit hit;
+                hits += intersectTriangleBlock(block, ray, 0.001f, 1e30f, hit) >= 0;
+            }
+        }
+        tests += rays.size() * blocks.size() * kTriangleBlockWidth;
+    }
+    benchmark::DoNotOptimize(hits);
+    state.counters["Mintersections/s"] =
+        benchmark::Counter(static_cast<double>(tests) / 1e6, benchmark::Counter::kIsRate);
+    setSimdLevel(detectSimdLevel());
+}
+BENCHMARK(BM_TriangleBlock)
+    ->Arg(static_cast<int>(SimdLevel::Scalar))
+    ->Arg(static_cast<int>(SimdLevel::SSE4))
+    ->Arg(static_cast<int>(SimdLevel::AVX2));
+
+// Closest-hit queries through a TriangleMesh: a bumpy 256x256 grid seen from above.
+static void BM_TriangleMeshHit(benchmark::State& state) {
+    if (!UseLevel(state, static_cast<SimdLevel>(state.range(0)))) {
+        return;
+    }
+    TriangleMesh mesh(PrismBench::GridMesh(
+        256, 1, [](float x, float y) { return 0.05f * std::sin(40 * x * y); }));
+
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> pos(-0.5, 0.5);
+    std::vector<Ray> rays;
+    for (int i = 0; i < 4096; ++i) {
+        rays.emplace_back(Point3(pos(gen), pos(gen), 2), Point3(pos(gen), pos(gen), 0));
+    }
+
+    size_t queries = 0;
+    for (auto _ : state) {
+        int hits = 0;
+        for (const Ray& ray : rays) {
+            HitRecord rec;
+            hits += mesh.hit(ray, 0.001, 1000.0, rec);
+        }
+        benchmark::DoNotOptimize(hits);
+        queries += rays.size();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(queries));
+    setSimdLevel(detectSimdLevel());
+}
+BENCHMARK(BM_TriangleMeshHit)
+    ->Arg(static_cast<int>(SimdLevel::Scalar))
+    ->Arg(static_cast<int>(SimdLevel::AVX2));
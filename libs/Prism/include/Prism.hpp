@@ -3,4 +3,27 @@
 #include "Prism/ray.hpp"
 #include "Prism/utils.hpp"
 #include "Prism/camera.hpp"
-#include "Prism/matrix.hpp"
\ No newline at end of file
+#include "Prism/matrix.hpp"
+#include "Prism/fixed_matrix.hpp"
+#include "Prism/aabb.hpp"
+#include "Prism/bvh.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/thread_pool.hpp"
+#include "Prism/image.hpp"
+#include "Prism/renderer.hpp"
+#include "Prism/mapped_file.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/array_view.hpp"
+#include "Prism/mesh_cache.hpp"
+#include "Prism/material.hpp"
+#include "Prism/triangle_mesh.hpp"
+#include "Prism/triangle_kernel.hpp"
+#include "Prism/ray_packet.hpp"
+#include "Prism/stats.hpp"
+#include "Prism/image_writer.hpp"
+#include "Prism/accumulator.hpp"
+#include "Prism/sampler.hpp"
+#include "Prism/instance.hpp"
+#include "Prism/camera_path.hpp"
+#include "Prism/shadow_queue.hpp"
+#include "Prism/wavefront.hpp"
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef PRISM_AABB_HPP_
+#define PRISM_AABB_HPP_
+
+#include "Prism/point.hpp"
+#include "Prism/scalar.hpp"
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+
+namespace Prism {
+
+struct RayPacket;
+
+/**
+ * @class AABB
+ * @brief Axis-aligned bounding box used by the acceleration structures.
+ *
+ * A default constructed box is empty (min > max), so expanding it by any point or box yields
+ * exactly that point or box.
+ */
+class PRISM_EXPORT AABB {
+  public:
+    /**
+     * @brief Constructs an empty bounding box.
+     */
+    AABB();
+
+    /**
+     * @brief Constructs a bounding box from its two extreme corners.
+     * @param min The corner with the smallest coordinates.
+     * @param max The corner with the largest coordinates.
+     */
+    AABB(const Point3& min, const Point3& max);
+
+    /**
+     * @brief Grows the box so that it contains the given point.
+     * @param p The point to include.
+     */
+    inline void expand(const Point3& p) {
+        grow(p, p);
+    }
+
+    /**
+     * @brief Grows the box so that it contains another box.
+     * @param box The box to include.
+     */
+    inline void expand(const AABB& box) {
+        grow(box.min, box.max);
+    }
+
+    /**
+     * @brief Checks whether the box contains no points.
+     * @return True if the box was never expanded, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Computes the center of the box.
+     * @return The midpoint between min and max.
+     */
+    Point3 centroid() const;
+
+    /**
+     * @brief Computes the surface area of the box, used by the SAH cost model.
+     * @return The surface area, or 0 for an empty box.
+     */
+    ld surfaceArea() const;
+
+    /**
+     * @brief Returns the index (0 = x, 1 = y, 2 = z) of the longest side of the box.
+     */
+    int longestAxis() const;
+
+    /**
+     * @brief Slab test against a ray given by its origin and inverse direction.
+     * @param origin The ray origin.
+     * @param inv_dir The component-wise inverse of the ray direction.
+     * @param t_min The minimum distance for a valid hit.
+     * @param t_max The maximum distance for a valid hit.
+     * @return True if the ray overlaps the box inside [t_min, t_max].
+     */
+    inline bool hit(const Point3& origin, const Vector3& inv_dir, ld t_min, ld t_max) const {
+        return slab(min.x, max.x, origin.x, inv_dir.x, t_min, t_max) &&
+               slab(min.y, max.y, origin.y, inv_dir.y, t_min, t_max) &&
+               slab(min.z, max.z, origin.z, inv_dir.z, t_min, t_max);
+    }
+
+    /**
+     * @brief Slab test against the rays of a packet, stopping at the first lane that overlaps.
+     * @param packet The rays to test; inactive lanes are skipped.
+     * @param t_min The minimum distance for a valid hit.
+     * @param t_max The maximum distance for a valid hit, per lane.
+     * @param first The lane tested first, typically the one that overlapped the parent box.
+     * @return A lane whose ray overlaps the box, or -1 if none does.
+     */
+    int hitAny(const RayPacket& packet, ld t_min, const ld* t_max, int first = 0) const;
+
+    Point3 min; ///< The corner with the smallest coordinates.
+    Point3 max; ///< The corner with the largest coordinates.
+
+  private:
+    // Inline, since BVH builders call it several times per primitive and level.
+    inline void grow(const Point3& lo, const Point3& hi) {
+        min.x = lo.x < min.x ? lo.x : min.x;
+        min.y = lo.y < min.y ? lo.y : min.y;
+        min.z = lo.z < min.z ? lo.z : min.z;
+        max.x = hi.x > max.x ? hi.x : max.x;
+        max.y = hi.y > max.y ? hi.y : max.y;
+        max.z = hi.z > max.z ? hi.z : max.z;
+    }
+
+    static inline bool slab(ld lo, ld hi, ld origin, ld inv_dir, ld& t_min, ld& t_max) {
+        ld t0 = (lo - origin) * inv_dir;
+        ld t1 = (hi - origin) * inv_dir;
+        if (inv_dir < 0) {
+            ld tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+        t_min = t0 > t_min ? t0 : t_min;
+        t_max = t1 < t_max ? t1 : t_max;
+        return t_min <= t_max;
+    }
+};
+
+} // namespace Prism
+
+#endif // PRISM_AABB_HPP_
@@ -0,0 +1,121 @@
+#ifndef PRISM_ACCUMULATOR_HPP_
+#define PRISM_ACCUMULATOR_HPP_
+
+#include "Prism/image.hpp"
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Prism {
+
+/**
+ * @class Accumulator
+ * @brief Per-pixel running sums of radiance samples, used for progressive rendering.
+ *
+ * Every pixel keeps a single-precision RGB sum and its own sample count, so the buffer can be
+ * resolved into a valid image at any time, even in the middle of a pass, and saved to disk to
+ * resume rendering later. The sum of squared luminances is kept too, giving the variance that
+ * adaptive sampling uses to tell converged pixels apart.
+ */
+class PRISM_EXPORT Accumulator {
+  public:
+    static constexpr uint32_t kVersion = 2; ///< Version of the file format written by save().
+
+    /**
+     * @brief Constructs a buffer without samples.
+     * @throws std::invalid_argument if either dimension is not positive.
+     */
+    Accumulator(int width, int height);
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    /**
+     * @brief Adds a sample to a pixel. Different pixels may be updated concurrently.
+     */
+    void add(int x, int y, const Vector3& color) {
+        const size_t i = index(x, y);
+        sums_[3 * i] += static_cast<float>(color.x);
+        sums_[3 * i + 1] += static_cast<float>(color.y);
+        sums_[3 * i + 2] += static_cast<float>(color.z);
+        const float lum = luminance(color);
+        squares_[i] += lum * lum;
+        ++counts_[i];
+    }
+
+    /**
+     * @brief Gets the number of samples taken in a pixel.
+     */
+    uint32_t samples(int x, int y) const {
+        return counts_[index(x, y)];
+    }
+
+    /**
+     * @brief Gets the mean of the samples of a pixel, or black if it has none.
+     */
+    Vector3 mean(int x, int y) const;
+
+    /**
+     * @brief Gets the unbiased sample variance of the luminance of a pixel, or 0 with fewer than
+     * two samples.
+     */
+    ld variance(int x, int y) const;
+
+    /**
+     * @brief Gets the standard error of the mean luminance of a pixel, sqrt(variance / samples).
+     */
+    ld standardError(int x, int y) const;
+
+    /**
+     * @brief Gets the Rec. 709 luminance of a color.
+     */
+    static float luminance(const Vector3& color) {
+        return static_cast<float>(ld(0.2126) * color.x + ld(0.7152) * color.y +
+                                  ld(0.0722) * color.z);
+    }
+
+    /**
+     * @brief Gets the number of samples taken over the whole image.
+     */
+    uint64_t totalSamples() const;
+
+    /**
+     * @brief Averages every pixel into an image.
+     */
+    Image resolve() const;
+
+    /**
+     * @brief Writes the buffer to a file, replacing it atomically.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * @brief Reads a buffer written by save().
+     * @throws std::runtime_error if the file cannot be read or is not a valid buffer.
+     */
+    static Accumulator load(const std::string& path);
+
+  private:
+    size_t index(int x, int y) const {
+        return static_cast<size_t>(y) * width_ + x;
+    }
+
+    int width_;
+    int height_;
+    std::vector<float> sums_;      ///< RGB sums, three per pixel.
+    std::vector<float> squares_;   ///< Sums of squared luminances.
+    std::vector<uint32_t> counts_; ///< Samples per pixel.
+};
+
+} // namespace Prism
+
+#endif // PRISM_ACCUMULATOR_HPP_
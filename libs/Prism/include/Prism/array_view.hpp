@@ -0,0 +1,60 @@
+#ifndef PRISM_ARRAY_VIEW_HPP_
+#define PRISM_ARRAY_VIEW_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace Prism {
+
+/**
+ * @class ArrayView
+ * @brief Non-owning view of a contiguous array, used to hand out data that lives in a vector or
+ * in a memory-mapped file without copying it.
+ *
+ * The viewed memory must outlive the view.
+ */
+template <typename T> class ArrayView {
+  public:
+    constexpr ArrayView() = default;
+
+    constexpr ArrayView(const T* data, size_t size) : data_(data), size_(size) {
+    }
+
+    ArrayView(const std::vector<T>& vector) : data_(vector.data()), size_(vector.size()) {
+    }
+
+    constexpr const T* data() const {
+        return data_;
+    }
+
+    constexpr size_t size() const {
+        return size_;
+    }
+
+    constexpr bool empty() const {
+        return size_ == 0;
+    }
+
+    constexpr const T* begin() const {
+        return data_;
+    }
+
+    constexpr const T* end() const {
+        return data_ + size_;
+    }
+
+    /**
+     * @brief Accesses an element without bounds checking.
+     */
+    constexpr const T& operator[](size_t i) const {
+        return data_[i];
+    }
+
+  private:
+    const T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace Prism
+
+#endif // PRISM_ARRAY_VIEW_HPP_
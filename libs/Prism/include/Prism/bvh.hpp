@@ -0,0 +1,375 @@
+#ifndef PRISM_BVH_HPP_
+#define PRISM_BVH_HPP_
+
+#include "Prism/aabb.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/ray_packet.hpp"
+#include "Prism/scalar.hpp"
+#include "Prism/stats.hpp"
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Prism {
+
+class ThreadPool;
+
+/**
+ * @brief Algorithms available to build a BVHTree.
+ */
+enum class BVHBuildMethod {
+    Sweep,  ///< Exact SAH over every sorted split position. Best trees, single-threaded.
+    Binned, ///< SAH over a fixed number of bins per axis. Linear per level and parallel.
+};
+
+/**
+ * @struct BVHBuildOptions
+ * @brief Parameters of a BVHTree build.
+ */
+struct PRISM_EXPORT BVHBuildOptions {
+    BVHBuildMethod method = BVHBuildMethod::Sweep;
+    size_t max_leaf_size = 4;   ///< Leaves hold at most this many primitives (see BVHTree).
+    size_t leaf_width = 1;      ///< Primitives the caller intersects at once (see BVHTree).
+    size_t bin_count = 16;      ///< Binned builds: candidate split planes per axis, plus one.
+    ThreadPool* pool = nullptr; ///< Binned builds: pool to build on, or nullptr for the caller.
+};
+
+/**
+ * @struct BVHNode
+ * @brief A node of a flattened bounding volume hierarchy.
+ *
+ * Nodes are stored depth-first: the first child of an interior node is always the next node in
+ * the array, so only the index of the second child has to be stored.
+ */
+struct PRISM_EXPORT BVHNode {
+    AABB bounds;     ///< Bounds of every primitive below this node.
+    uint32_t offset; ///< Leaf: first entry in the primitive order. Interior: second child index.
+    uint16_t count;  ///< Number of primitives in a leaf, 0 for interior nodes.
+    uint16_t axis;   ///< Axis the node was split on, used to order the traversal.
+
+    bool isLeaf() const {
+        return count > 0;
+    }
+};
+
+/**
+ * @class BVHTree
+ * @brief SAH-built bounding volume hierarchy over an arbitrary set of primitive bounds.
+ *
+ * The tree only knows about boxes; the caller keeps the primitives and is handed their indices
+ * during traversal. This lets the same builder and traversal serve both scene objects and mesh
+ * triangles.
+ */
+class PRISM_EXPORT BVHTree {
+  public:
+    /**
+     * @brief Constructs an empty tree. Traversing it never reports a hit.
+     */
+    BVHTree() = default;
+
+    /**
+     * @brief Builds the tree with a full sweep over the surface area heuristic.
+     * @param bounds The bounding box of every primitive.
+     * @param max_leaf_size Leaves are split until they hold at most this many primitives, unless
+     * the SAH considers the split more expensive than the leaf.
+     * @param leaf_width Number of primitives the caller intersects at once (e.g. a SIMD width).
+     * The SAH charges a leaf per group of leaf_width primitives, so leaves fill up to the width.
+     */
+    explicit BVHTree(const std::vector<AABB>& bounds, size_t max_leaf_size = 4,
+                     size_t leaf_width = 1);
+
+    /**
+     * @brief Builds the tree with the given method.
+     *
+     * The binned builder sorts primitives into options.bin_count bins per axis by centroid and
+     * only evaluates the SAH between bins. With a pool, large nodes are binned in parallel
+     * chunks and large subtrees are built as parallel tasks. The tree does not depend on the
+     * number of threads.
+     * @throws std::invalid_argument if a leaf size or width is out of range, or bin_count is not
+     * between 2 and 256.
+     */
+    BVHTree(const std::vector<AABB>& bounds, const BVHBuildOptions& options);
+
+    /**
+     * @brief Gets the flattened node array. The root, if any, is node 0.
+     */
+    const std::vector<BVHNode>& nodes() const {
+        return nodes_;
+    }
+
+    /**
+     * @brief Gets the primitive indices in leaf order. Leaf i covers entries
+     * [offset, offset + count) of this array.
+     */
+    const std::vector<uint32_t>& primitiveOrder() const {
+        return order_;
+    }
+
+    /**
+     * @brief Gets the bounds of the whole tree (empty if there are no primitives).
+     */
+    AABB bounds() const;
+
+    /**
+     * @brief Computes the SAH cost of the tree, normalized by the root surface area.
+     */
+    ld sahCost() const;
+
+    /**
+     * @brief Gets the wall-clock time the build took, in seconds.
+     */
+    double buildSeconds() const {
+        return build_seconds_;
+    }
+
+    /**
+     * @brief Visits every leaf whose bounds overlap the ray, front to back.
+     * @param ray The ray to trace.
+     * @param t_min The minimum distance for a valid hit.
+     * @param t_max The maximum distance for a valid hit; shrunk by the callback on every hit.
+     * @param intersect Called as intersect(leaf_slot, t_max) for every primitive slot of every
+     * visited leaf, where leaf_slot indexes primitiveOrder(). Must return true and lower t_max
+     * when the primitive is hit closer than t_max.
+     * @return True if the callback reported at least one hit.
+     */
+    template <typename Intersect>
+    bool traverse(const Ray& ray, ld t_min, ld& t_max, Intersect&& intersect) const;
+
+    /**
+     * @brief Like traverse, but hands whole leaves to the callback.
+     * @param intersect Called as intersect(leaf, t_max) for every visited leaf node; the leaf
+     * index in nodes() is &leaf - nodes().data(). Must return true and lower t_max when a
+     * primitive of the leaf is hit closer than t_max.
+     */
+    template <typename IntersectLeaf>
+    bool traverseLeaves(const Ray& ray, ld t_min, ld& t_max, IntersectLeaf&& intersect) const;
+
+    /**
+     * @brief Visits the leaves overlapping the ray until one reports a hit, for any-hit queries.
+     *
+     * The range never shrinks and the traversal stops as soon as the callback returns true, so
+     * which blocker ends it is unspecified. Node tests are counted as StatCounter::OcclusionNodes.
+     * @param intersect Called as intersect(leaf) for visited leaf nodes. Returns whether any
+     * primitive of the leaf is hit within [t_min, t_max].
+     * @return True if a leaf reported a hit.
+     */
+    template <typename IntersectLeaf>
+    bool traverseAny(const Ray& ray, ld t_min, ld t_max, IntersectLeaf&& intersect) const;
+
+    /**
+     * @brief Visits every leaf whose bounds overlap at least one ray of a packet.
+     *
+     * Each node box is tested once for the whole packet (see AABB::hitAny), starting with the
+     * lane that overlapped its parent, and children are ordered by the direction of the first
+     * active lane. This pays off for coherent rays such as the primary rays of a pixel tile.
+     * @param packet The rays to trace.
+     * @param t_min The minimum distance for a valid hit.
+     * @param t_max The maximum distance for a valid hit, per lane. The callback may lower it.
+     * @param intersect Called as intersect(leaf) for every visited leaf node, and expected to
+     * test every active lane against it.
+     */
+    template <typename IntersectLeaf>
+    void traversePacket(const RayPacket& packet, ld t_min, const ld* t_max,
+                        IntersectLeaf&& intersect) const;
+
+  private:
+    std::vector<BVHNode> nodes_;
+    std::vector<uint32_t> order_;
+    double build_seconds_ = 0;
+};
+
+/**
+ * @class BVH
+ * @brief Bounding volume hierarchy over scene objects.
+ *
+ * Objects without a bounding box (see Object::boundingBox) are kept aside and tested against
+ * every ray, so any Object can be placed in a BVH.
+ */
+class PRISM_EXPORT BVH : public Object {
+  public:
+    /**
+     * @brief Builds a hierarchy over the given objects. The objects are not owned.
+     * @param objects The objects to accelerate.
+     * @param max_leaf_size Maximum number of objects per leaf (see BVHTree).
+     */
+    explicit BVH(const std::vector<Object*>& objects, size_t max_leaf_size = 4);
+
+    /**
+     * @brief Builds a hierarchy over the given objects with the given build options.
+     */
+    BVH(const std::vector<Object*>& objects, const BVHBuildOptions& options);
+
+    bool hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const override;
+
+    void hitPacket(const RayPacket& packet, ld t_min, PacketHit& hits) const override;
+
+    bool occluded(const Ray& ray, ld t_min, ld t_max) const override;
+
+    bool boundingBox(AABB& box) const override;
+
+    /**
+     * @brief Gets the underlying tree.
+     */
+    const BVHTree& tree() const {
+        return tree_;
+    }
+
+  private:
+    std::vector<Object*> objects_;   ///< Bounded objects, permuted into leaf order.
+    std::vector<Object*> unbounded_; ///< Objects tested against every ray.
+    BVHTree tree_;
+};
+
+template <typename Intersect>
+bool BVHTree::traverse(const Ray& ray, ld t_min, ld& t_max, Intersect&& intersect) const {
+    return traverseLeaves(ray, t_min, t_max, [&](const BVHNode& leaf, ld& t_far) {
+        bool hit_leaf = false;
+        for (uint32_t i = 0; i < leaf.count; ++i) {
+            if (intersect(leaf.offset + i, t_far)) {
+                hit_leaf = true;
+            }
+        }
+        return hit_leaf;
+    });
+}
+
+template <typename IntersectLeaf>
+bool BVHTree::traverseLeaves(const Ray& ray, ld t_min, ld& t_max,
+                             IntersectLeaf&& intersect) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    const Vector3& inv_dir = ray.inv_direction;
+    const bool negative[3] = {inv_dir.x < 0, inv_dir.y < 0, inv_dir.z < 0};
+
+    bool hit_anything = false;
+    uint32_t stack[64];
+    int stack_size = 0;
+    uint32_t current = 0;
+    StatTally visited(StatCounter::BVHNodes);
+
+    while (true) {
+        const BVHNode& node = nodes_[current];
+        visited.add();
+        if (node.bounds.hit(ray.origin, inv_dir, t_min, t_max)) {
+            if (node.isLeaf()) {
+                if (intersect(node, t_max)) {
+                    hit_anything = true;
+                }
+                if (stack_size == 0) {
+                    break;
+                }
+                current = stack[--stack_size];
+            } else if (negative[node.axis]) {
+                // Visit the far-side (second) child first when the ray points down the axis.
+                stack[stack_size++] = current + 1;
+                current = node.offset;
+            } else {
+                stack[stack_size++] = node.offset;
+                current = current + 1;
+            }
+        } else {
+            if (stack_size == 0) {
+                break;
+            }
+            current = stack[--stack_size];
+        }
+    }
+
+    return hit_anything;
+}
+
+template <typename IntersectLeaf>
+bool BVHTree::traverseAny(const Ray& ray, ld t_min, ld t_max, IntersectLeaf&& intersect) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    const Vector3& inv_dir = ray.inv_direction;
+    const bool negative[3] = {inv_dir.x < 0, inv_dir.y < 0, inv_dir.z < 0};
+
+    uint32_t stack[64];
+    int stack_size = 0;
+    uint32_t current = 0;
+    StatTally visited(StatCounter::OcclusionNodes);
+
+    while (true) {
+        const BVHNode& node = nodes_[current];
+        visited.add();
+        if (node.bounds.hit(ray.origin, inv_dir, t_min, t_max)) {
+            if (!node.isLeaf()) {
+                // Near child first: blockers close to the origin are the likeliest to be found.
+                if (negative[node.axis]) {
+                    stack[stack_size++] = current + 1;
+                    current = node.offset;
+                } else {
+                    stack[stack_size++] = node.offset;
+                    current = current + 1;
+                }
+                continue;
+            }
+            if (intersect(node)) {
+                return true;
+            }
+        }
+        if (stack_size == 0) {
+            return false;
+        }
+        current = stack[--stack_size];
+    }
+}
+
+template <typename IntersectLeaf>
+void BVHTree::traversePacket(const RayPacket& packet, ld t_min, const ld* t_max,
+                             IntersectLeaf&& intersect) const {
+    const int first = packet.firstActive();
+    if (nodes_.empty() || first < 0) {
+        return;
+    }
+
+    const bool negative[3] = {packet.inv_direction[0][first] < 0,
+                              packet.inv_direction[1][first] < 0,
+                              packet.inv_direction[2][first] < 0};
+
+    uint32_t stack[64];
+    int stack_lanes[64];
+    int stack_size = 0;
+    uint32_t current = 0;
+    int lane = first;
+    StatTally visited(StatCounter::BVHNodes);
+
+    while (true) {
+        const BVHNode& node = nodes_[current];
+        visited.add();
+        lane = node.bounds.hitAny(packet, t_min, t_max, lane);
+        if (lane >= 0 && !node.isLeaf()) {
+            stack_lanes[stack_size] = lane;
+            if (negative[node.axis]) {
+                stack[stack_size++] = current + 1;
+                current = node.offset;
+            } else {
+                stack[stack_size++] = node.offset;
+                current = current + 1;
+            }
+            continue;
+        }
+        if (lane >= 0) {
+            intersect(node);
+        }
+        if (stack_size == 0) {
+            break;
+        }
+        --stack_size;
+        current = stack[stack_size];
+        lane = stack_lanes[stack_size];
+    }
+}
+
+} // namespace Prism
+
+#endif // PRISM_BVH_HPP_
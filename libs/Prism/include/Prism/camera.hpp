@@ -4,14 +4,242 @@
 #include "prism_export.h"
 #include "Prism/point.hpp"
 #include "Prism/ray.hpp"
+#include "Prism/ray_packet.hpp"
+#include "Prism/scalar.hpp"
 #include "Prism/vector.hpp"
+#include <cstddef>
 #include <initializer_list>
 #include <iterator>
+#include <utility>
 namespace Prism {
 
-using ld = long double;
-
 template <typename T> class Matrix;
+class Camera;
+class PixelIterator;
+class Sampler;
+
+/**
+ * @struct Pixel
+ * @brief Column and row of a pixel, from the top-left corner of the image.
+ */
+struct PRISM_EXPORT Pixel {
+    int x;
+    int y;
+};
+
+/**
+ * @class PixelRange
+ * @brief A rectangle of a Camera's pixels, as a random-access sequence of primary rays.
+ *
+ * Pixels are numbered row by row inside the rectangle, and the ray of any index is computed in
+ * O(1) from a copy of the camera geometry taken when the range is made, so the range stays
+ * valid, and unchanged, if the camera is moved or destroyed. Ranges are cheap to copy and can be
+ * split into tiles, rows or halves, so the work can be spread over a ThreadPool, or handed to a
+ * parallel standard algorithm through the random-access iterators.
+ */
+class PRISM_EXPORT PixelRange {
+  public:
+    /**
+     * @brief Random-access iterator over the rays of the range (see PixelIterator).
+     */
+    using Iterator = PixelIterator;
+
+    /**
+     * @brief Constructs an empty range.
+     */
+    PixelRange() = default;
+
+    /**
+     * @brief Gets every pixel of a camera's image.
+     */
+    explicit PixelRange(const Camera& camera);
+
+    /**
+     * @brief Gets the primary ray through the center of the pixel at an index, like
+     * Camera::getRay. Indices are not bounds-checked.
+     */
+    Ray operator[](size_t index) const;
+
+    /**
+     * @brief Gets the pixel at an index. Indices are not bounds-checked.
+     */
+    Pixel pixel(size_t index) const {
+        return Pixel{x0_ + static_cast<int>(index % static_cast<size_t>(width_)),
+                     y0_ + static_cast<int>(index / static_cast<size_t>(width_))};
+    }
+
+    size_t size() const {
+        return static_cast<size_t>(width_) * static_cast<size_t>(height_);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    int x0() const {
+        return x0_;
+    }
+
+    int y0() const {
+        return y0_;
+    }
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    /**
+     * @brief Gets a rectangle of this range, in image coordinates.
+     * @throws std::out_of_range if the rectangle is not inside this range or has a negative size.
+     */
+    PixelRange tile(int x0, int y0, int width, int height) const;
+
+    /**
+     * @brief Gets full-width rows of this range, in image coordinates.
+     * @throws std::out_of_range if the rows are not inside this range.
+     */
+    PixelRange rows(int first, int count) const {
+        return tile(x0_, first, width_, count);
+    }
+
+    /**
+     * @brief Cuts the range in two across its longer side; the first half gets the smaller part.
+     * Splitting a single pixel gives an empty first half.
+     */
+    std::pair<PixelRange, PixelRange> split() const;
+
+    Iterator begin() const;
+    Iterator end() const;
+
+  private:
+    Point3 origin_;
+    Point3 corner_; ///< Center of pixel (0, 0) of the image.
+    Vector3 du_;    ///< Step between neighbouring columns.
+    Vector3 dv_;    ///< Step between neighbouring rows, downwards.
+    int x0_ = 0;
+    int y0_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+};
+
+/**
+ * @class PixelIterator
+ * @brief Random-access iterator over a PixelRange, yielding rays by value like a proxy iterator.
+ *
+ * It holds its own copy of the range, so it stays valid after the range is gone.
+ */
+class PRISM_EXPORT PixelIterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Ray;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Ray;
+
+    PixelIterator() = default;
+
+    PixelIterator(const PixelRange& range, difference_type index) : range_(range), index_(index) {
+    }
+
+    Ray operator*() const {
+        return range_[static_cast<size_t>(index_)];
+    }
+
+    Ray operator[](difference_type n) const {
+        return range_[static_cast<size_t>(index_ + n)];
+    }
+
+    /**
+     * @brief Gets the pixel the iterator points at.
+     */
+    Pixel pixel() const {
+        return range_.pixel(static_cast<size_t>(index_));
+    }
+
+    PixelIterator& operator++() {
+        ++index_;
+        return *this;
+    }
+
+    PixelIterator operator++(int) {
+        PixelIterator old = *this;
+        ++index_;
+        return old;
+    }
+
+    PixelIterator& operator--() {
+        --index_;
+        return *this;
+    }
+
+    PixelIterator operator--(int) {
+        PixelIterator old = *this;
+        --index_;
+        return old;
+    }
+
+    PixelIterator& operator+=(difference_type n) {
+        index_ += n;
+        return *this;
+    }
+
+    PixelIterator& operator-=(difference_type n) {
+        index_ -= n;
+        return *this;
+    }
+
+    PixelIterator operator+(difference_type n) const {
+        return PixelIterator(range_, index_ + n);
+    }
+
+    friend PixelIterator operator+(difference_type n, const PixelIterator& it) {
+        return it + n;
+    }
+
+    PixelIterator operator-(difference_type n) const {
+        return PixelIterator(range_, index_ - n);
+    }
+
+    difference_type operator-(const PixelIterator& other) const {
+        return index_ - other.index_;
+    }
+
+    // Iterators are only compared within the same range.
+    bool operator==(const PixelIterator& other) const {
+        return index_ == other.index_;
+    }
+    bool operator!=(const PixelIterator& other) const {
+        return index_ != other.index_;
+    }
+    bool operator<(const PixelIterator& other) const {
+        return index_ < other.index_;
+    }
+    bool operator>(const PixelIterator& other) const {
+        return index_ > other.index_;
+    }
+    bool operator<=(const PixelIterator& other) const {
+        return index_ <= other.index_;
+    }
+    bool operator>=(const PixelIterator& other) const {
+        return index_ >= other.index_;
+    }
+
+  private:
+    PixelRange range_;
+    difference_type index_ = 0;
+};
+
+inline PixelIterator PixelRange::begin() const {
+    return PixelIterator(*this, 0);
+}
+
+inline PixelIterator PixelRange::end() const {
+    return PixelIterator(*this, static_cast<std::ptrdiff_t>(size()));
+}
 
 /**
  * @class Camera
@@ -34,54 +262,109 @@ class PRISM_EXPORT Camera {
      */
      Camera(const Point3& position, const Point3& target, const Vector3& upvec, const ld& distance,
            const ld& viewport_height, const ld& viewport_width, int image_height, int image_width);
-    
+
+    Camera(const Camera& other);
+    Camera& operator=(const Camera& other);
     ~Camera();
 
-    class CameraIterator {
-      public:
-        using iterator_category = std::forward_iterator_tag;
-        using value_type = Ray;
-        using difference_type = std::ptrdiff_t;
-        using pointer = Ray*;
-        using reference = Ray&;
+    /**
+     * @brief Iterates over the primary rays of every pixel, row by row. Random access.
+     */
+    using CameraIterator = PixelRange::Iterator;
+
+    /**
+     * @brief Generates the primary ray through the center of a pixel.
+     * @param x The pixel column, from left to right.
+     * @param y The pixel row, from top to bottom.
+     * @return The ray from the camera position through the pixel center.
+     */
+    Ray getRay(int x, int y) const;
 
-        CameraIterator(Camera* cam, int y, int x) : camera(cam), current_y(y), current_x(x) {
-        }
+    /**
+     * @brief Generates a primary ray through a point inside a pixel, e.g. for antialiasing.
+     * @param x The pixel column, from left to right.
+     * @param y The pixel row, from top to bottom.
+     * @param u Horizontal position inside the pixel, from 0 (left edge) to 1 (right edge).
+     * @param v Vertical position inside the pixel, from 0 (top edge) to 1 (bottom edge).
+     * @return The ray from the camera position through that point. getRay(x, y, 0.5, 0.5)
+     * matches getRay(x, y).
+     */
+    Ray getRay(int x, int y, ld u, ld v) const;
 
-        Ray operator*() const {
-            Point3 pixel_center = *camera->pixel_00_loc + (*camera->pixel_delta_u * current_x) -
-                          (*camera->pixel_delta_v * current_y);
+    /**
+     * @brief Generates a primary ray through a point of a pixel drawn from a sampler.
+     *
+     * The pixel jitter takes the next two dimensions of the sampler, which must already be
+     * positioned on a sample of this pixel with Sampler::startPixelSample().
+     * @param x The pixel column, from left to right.
+     * @param y The pixel row, from top to bottom.
+     * @param sampler The sampler providing the position inside the pixel.
+     */
+    Ray getRay(int x, int y, Sampler& sampler) const;
 
-            return Ray(*camera->pos, pixel_center);
-        }
+    /**
+     * @brief Generates the primary rays of a RayPacket::kWidth x RayPacket::kHeight pixel tile.
+     *
+     * Lane i holds the ray that getRay(x0 + i % kWidth, y0 + i / kWidth) would return. Lanes past
+     * the right or bottom edge of the image are left inactive.
+     * @param x0 The column of the top-left pixel of the tile.
+     * @param y0 The row of the top-left pixel of the tile.
+     * @param packet The packet to fill.
+     * @throws std::out_of_range if (x0, y0) is not a pixel of the image.
+     */
+    void getPacket(int x0, int y0, RayPacket& packet) const;
 
-        CameraIterator& operator++() {
-            current_x++;
-            if (current_x >= camera->pixel_width) {
-                current_x = 0;
-                current_y++;
-            }
-            return *this;
-        }
+    /**
+     * @brief Gets the pixels of the whole image as a random-access range of primary rays.
+     */
+    PixelRange pixels() const;
 
-        bool operator!=(const CameraIterator& other) const {
-            return current_y != other.current_y || current_x != other.current_x;
-        }
+    CameraIterator begin() const;
+    CameraIterator end() const;
 
-      private:
-        Camera* camera;
-        int current_y;
-        int current_x;
-        
-    };
+    /**
+     * @brief Moves the camera, keeping its target. Recomputes the basis and the screen.
+     */
+    void setPosition(const Point3& position);
 
-    CameraIterator begin() {
-        return CameraIterator(this, 0, 0);
-    }
-    CameraIterator end() {
-        return CameraIterator(this, pixel_height, 0);
-    }
+    /**
+     * @brief Aims the camera at another point. Recomputes the basis and the screen.
+     */
+    void setTarget(const Point3& target);
 
+    /**
+     * @brief Moves and aims the camera at once, recomputing the basis and the screen once.
+     */
+    void lookAt(const Point3& position, const Point3& target);
+
+    /**
+     * @brief Resizes the projection screen, keeping its distance. Only recomputes the screen.
+     * @throws std::invalid_argument if a size is not positive.
+     */
+    void setViewport(ld viewport_height, ld viewport_width);
+
+    /**
+     * @brief Gets the vertical field of view, in radians.
+     */
+    ld fieldOfView() const;
+
+    /**
+     * @brief Sets the vertical field of view, keeping the screen distance and aspect ratio.
+     * Only recomputes the screen.
+     * @param fov The vertical field of view in radians, in (0, pi).
+     * @throws std::invalid_argument if fov is outside (0, pi).
+     */
+    void setFieldOfView(ld fov);
+
+    /**
+     * @brief Changes the number of pixels, keeping the viewport. Only recomputes the pixel
+     * steps; callers that want square pixels resize the viewport too.
+     * @throws std::invalid_argument if a size is not positive.
+     */
+    void setResolution(int image_height, int image_width);
+
+    // The fields below are read-only views of the camera state: changing them does not update
+    // the precomputed screen, use the setters instead.
     Point3* pos;
     Point3* aim;
     Vector3* up;
@@ -96,6 +379,11 @@ class PRISM_EXPORT Camera {
     int pixel_width;
 
   private:
+    friend class PixelRange;
+
+    void updateBasis();
+    void updateScreen();
+
     Point3* pixel_00_loc;
     Vector3* pixel_delta_u;
     Vector3* pixel_delta_v;
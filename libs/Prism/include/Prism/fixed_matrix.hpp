@@ -0,0 +1,409 @@
+#ifndef PRISM_FIXED_MATRIX_HPP_
+#define PRISM_FIXED_MATRIX_HPP_
+
+#include "Prism/matrix.hpp"
+#include "Prism/point.hpp"
+#include "Prism/scalar.hpp"
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+
+/**
+ * @file fixed_matrix.hpp
+ * @brief Defines FixedMatrix, a matrix whose dimensions are known at compile time, and the 3x3 /
+ * 4x4 transform helpers built on it.
+ */
+
+namespace Prism {
+
+/**
+ * @class FixedMatrix
+ * @brief Matrix with compile-time dimensions stored contiguously (row-major) in place.
+ *
+ * Unlike Matrix, it never allocates and does not bounds-check element access, so it is meant for
+ * small transforms on hot paths. Loops run over constant bounds and are fully unrolled by the
+ * compiler.
+ *
+ * @tparam T The element type.
+ * @tparam R The number of rows.
+ * @tparam C The number of columns.
+ */
+template <typename T, size_t R, size_t C> class PRISM_EXPORT FixedMatrix {
+    static_assert(R > 0 && C > 0, "Matrix dimensions must be greater than zero.");
+
+  public:
+    /**
+     * @brief Constructs a matrix with all entries 0.
+     */
+    constexpr FixedMatrix() : data_{} {
+    }
+
+    /**
+     * @brief Constructs a FixedMatrix from an initializer list of rows.
+     * @param rows An initializer list containing the rows of the matrix.
+     * @throws std::invalid_argument if the list does not have exactly R rows of C elements.
+     */
+    constexpr FixedMatrix(std::initializer_list<std::initializer_list<T>> rows) : data_{} {
+        if (rows.size() != R) {
+            throw std::invalid_argument("Initializer list must contain exactly one entry per row.");
+        }
+        size_t i = 0;
+        for (const auto& row : rows) {
+            if (row.size() != C) {
+                throw std::invalid_argument(
+                    "All rows in the initializer list must have the same number of columns.");
+            }
+            size_t j = 0;
+            for (const auto& val : row) {
+                data_[i * C + j] = val;
+                ++j;
+            }
+            ++i;
+        }
+    }
+
+    /**
+     * @brief Constructs a FixedMatrix from a dynamic Matrix of the same dimensions.
+     * @param m The matrix to copy from.
+     * @throws std::invalid_argument if the dimensions of m are not R x C.
+     */
+    explicit FixedMatrix(const Matrix<T>& m) : data_{} {
+        if (m.getRows() != R || m.getCols() != C) {
+            throw std::invalid_argument("Matrix dimensions do not match.");
+        }
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                data_[i * C + j] = m[i][j];
+            }
+        }
+    }
+
+    /**
+     * @brief Constructs the identity matrix. Only available for square matrices.
+     */
+    static constexpr FixedMatrix identity() {
+        static_assert(R == C, "Only square matrices have an identity.");
+        FixedMatrix result;
+        for (size_t i = 0; i < R; ++i) {
+            result.data_[i * C + i] = 1;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Gets the number of rows in the matrix.
+     */
+    static constexpr size_t getRows() {
+        return R;
+    }
+
+    /**
+     * @brief Gets the number of columns in the matrix.
+     */
+    static constexpr size_t getCols() {
+        return C;
+    }
+
+    /**
+     * @brief Accesses an element. Indices are not bounds-checked.
+     * @param i The row index.
+     * @param j The column index.
+     */
+    constexpr T& operator()(size_t i, size_t j) {
+        return data_[i * C + j];
+    }
+
+    constexpr const T& operator()(size_t i, size_t j) const {
+        return data_[i * C + j];
+    }
+
+    /**
+     * @brief Accesses a row, so elements can be read as m[i][j] like with Matrix. Not
+     * bounds-checked.
+     * @param i The row index.
+     * @return A pointer to the first element of the row.
+     */
+    constexpr T* operator[](size_t i) {
+        return &data_[i * C];
+    }
+
+    constexpr const T* operator[](size_t i) const {
+        return &data_[i * C];
+    }
+
+    /**
+     * @brief Gets the contiguous row-major storage.
+     */
+    constexpr const T* data() const {
+        return data_.data();
+    }
+
+    /**
+     * @brief Checks if all elements of both matrices are equal.
+     */
+    constexpr bool operator==(const FixedMatrix& m) const {
+        for (size_t k = 0; k < R * C; ++k) {
+            if (data_[k] != m.data_[k]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks if any element differs between both matrices.
+     */
+    constexpr bool operator!=(const FixedMatrix& m) const {
+        return !(*this == m);
+    }
+
+    /**
+     * @brief Multiplies this matrix by another matrix. Dimensions are checked at compile time.
+     * @param m The K-column matrix to multiply with.
+     * @return The R x K product.
+     */
+    template <size_t K>
+    constexpr FixedMatrix<T, R, K> operator*(const FixedMatrix<T, C, K>& m) const {
+        FixedMatrix<T, R, K> result;
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < K; ++j) {
+                T sum = 0;
+                for (size_t k = 0; k < C; ++k) {
+                    sum += data_[i * C + k] * m(k, j);
+                }
+                result(i, j) = sum;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Multiplies this matrix by a scalar.
+     */
+    constexpr FixedMatrix operator*(const T& scalar) const {
+        FixedMatrix result(*this);
+        result *= scalar;
+        return result;
+    }
+
+    /**
+     * @brief Multiplies this matrix by a square matrix in place.
+     */
+    constexpr FixedMatrix& operator*=(const FixedMatrix<T, C, C>& m) {
+        return *this = *this * m;
+    }
+
+    /**
+     * @brief Multiplies this matrix by a scalar in place.
+     */
+    constexpr FixedMatrix& operator*=(const T& scalar) {
+        for (size_t k = 0; k < R * C; ++k) {
+            data_[k] *= scalar;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Computes the transpose of this matrix.
+     */
+    constexpr FixedMatrix<T, C, R> transpose() const {
+        FixedMatrix<T, C, R> result;
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                result(j, i) = data_[i * C + j];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the determinant by Gaussian elimination with partial pivoting.
+     */
+    T determinant() const {
+        static_assert(R == C, "Only square matrices have a determinant.");
+        FixedMatrix a(*this);
+        T det = 1;
+        for (size_t col = 0; col < R; ++col) {
+            const size_t pivot = a.pivotRow(col);
+            if (a(pivot, col) == 0) {
+                return 0;
+            }
+            if (pivot != col) {
+                a.swapRows(pivot, col);
+                det = -det;
+            }
+            det *= a(col, col);
+            for (size_t row = col + 1; row < R; ++row) {
+                const T factor = a(row, col) / a(col, col);
+                for (size_t j = col; j < C; ++j) {
+                    a(row, j) -= factor * a(col, j);
+                }
+            }
+        }
+        return det;
+    }
+
+    /**
+     * @brief Computes the inverse by Gauss-Jordan elimination with partial pivoting.
+     * @throws std::invalid_argument if the matrix is singular.
+     */
+    FixedMatrix inverse() const {
+        static_assert(R == C, "Only square matrices can be inverted.");
+        FixedMatrix a(*this);
+        FixedMatrix inv = identity();
+        for (size_t col = 0; col < R; ++col) {
+            const size_t pivot = a.pivotRow(col);
+            if (a(pivot, col) == 0) {
+                throw std::invalid_argument("Matrix is singular and cannot be inverted.");
+            }
+            a.swapRows(pivot, col);
+            inv.swapRows(pivot, col);
+
+            const T scale = 1 / a(col, col);
+            for (size_t j = 0; j < C; ++j) {
+                a(col, j) *= scale;
+                inv(col, j) *= scale;
+            }
+            for (size_t row = 0; row < R; ++row) {
+                if (row == col) {
+                    continue;
+                }
+                const T factor = a(row, col);
+                for (size_t j = 0; j < C; ++j) {
+                    a(row, j) -= factor * a(col, j);
+                    inv(row, j) -= factor * inv(col, j);
+                }
+            }
+        }
+        return inv;
+    }
+
+  private:
+    size_t pivotRow(size_t col) const {
+        size_t best = col;
+        for (size_t row = col + 1; row < R; ++row) {
+            if (std::abs(data_[row * C + col]) > std::abs(data_[best * C + col])) {
+                best = row;
+            }
+        }
+        return best;
+    }
+
+    void swapRows(size_t a, size_t b) {
+        if (a == b) {
+            return;
+        }
+        for (size_t j = 0; j < C; ++j) {
+            T tmp = data_[a * C + j];
+            data_[a * C + j] = data_[b * C + j];
+            data_[b * C + j] = tmp;
+        }
+    }
+
+    std::array<T, R * C> data_; ///< Matrix data, row-major
+};
+
+using Mat3 = FixedMatrix<ld, 3, 3>; ///< Linear transform of 3D vectors.
+using Mat4 = FixedMatrix<ld, 4, 4>; ///< Affine / projective transform in homogeneous coordinates.
+
+/**
+ * @brief Applies a linear transform to a vector.
+ */
+inline Vector3 transformVector(const Mat3& m, const Vector3& v) {
+    return Vector3(m(0, 0) * v.x + m(0, 1) * v.y + m(0, 2) * v.z,
+                   m(1, 0) * v.x + m(1, 1) * v.y + m(1, 2) * v.z,
+                   m(2, 0) * v.x + m(2, 1) * v.y + m(2, 2) * v.z);
+}
+
+/**
+ * @brief Applies a homogeneous transform to a point (w = 1), dividing by the resulting w when the
+ * transform is projective.
+ */
+inline Point3 transformPoint(const Mat4& m, const Point3& p) {
+    ld x = m(0, 0) * p.x + m(0, 1) * p.y + m(0, 2) * p.z + m(0, 3);
+    ld y = m(1, 0) * p.x + m(1, 1) * p.y + m(1, 2) * p.z + m(1, 3);
+    ld z = m(2, 0) * p.x + m(2, 1) * p.y + m(2, 2) * p.z + m(2, 3);
+    ld w = m(3, 0) * p.x + m(3, 1) * p.y + m(3, 2) * p.z + m(3, 3);
+    if (w != 1 && w != 0) {
+        return Point3(x / w, y / w, z / w);
+    }
+    return Point3(x, y, z);
+}
+
+/**
+ * @brief Applies a homogeneous transform to a direction (w = 0), ignoring the translation.
+ */
+inline Vector3 transformVector(const Mat4& m, const Vector3& v) {
+    return Vector3(m(0, 0) * v.x + m(0, 1) * v.y + m(0, 2) * v.z,
+                   m(1, 0) * v.x + m(1, 1) * v.y + m(1, 2) * v.z,
+                   m(2, 0) * v.x + m(2, 1) * v.y + m(2, 2) * v.z);
+}
+
+/**
+ * @brief Transforms a surface normal given the inverse of the object-to-world transform.
+ * @param inverse The inverse of the transform applied to the geometry.
+ * @param n The normal to transform.
+ * @return The transformed normal, not normalized.
+ */
+inline Vector3 transformNormal(const Mat4& inverse, const Vector3& n) {
+    // Normals transform by the inverse transpose.
+    return Vector3(inverse(0, 0) * n.x + inverse(1, 0) * n.y + inverse(2, 0) * n.z,
+                   inverse(0, 1) * n.x + inverse(1, 1) * n.y + inverse(2, 1) * n.z,
+                   inverse(0, 2) * n.x + inverse(1, 2) * n.y + inverse(2, 2) * n.z);
+}
+
+/**
+ * @brief Builds a translation transform.
+ */
+inline Mat4 translation(const Vector3& offset) {
+    Mat4 m = Mat4::identity();
+    m(0, 3) = offset.x;
+    m(1, 3) = offset.y;
+    m(2, 3) = offset.z;
+    return m;
+}
+
+/**
+ * @brief Builds a (possibly non-uniform) scaling transform.
+ */
+inline Mat4 scaling(const Vector3& factors) {
+    Mat4 m = Mat4::identity();
+    m(0, 0) = factors.x;
+    m(1, 1) = factors.y;
+    m(2, 2) = factors.z;
+    return m;
+}
+
+/**
+ * @brief Builds a rotation transform around an axis through the origin.
+ * @param axis The rotation axis; does not need to be normalized.
+ * @param angle The counter-clockwise rotation angle, in radians.
+ * @throws std::invalid_argument if the axis is the zero vector.
+ */
+inline Mat4 rotation(const Vector3& axis, ld angle) {
+    const Vector3 a = axis.normalize();
+    const ld c = std::cos(angle);
+    const ld s = std::sin(angle);
+    const ld t = 1 - c;
+
+    Mat4 m = Mat4::identity();
+    m(0, 0) = t * a.x * a.x + c;
+    m(0, 1) = t * a.x * a.y - s * a.z;
+    m(0, 2) = t * a.x * a.z + s * a.y;
+    m(1, 0) = t * a.x * a.y + s * a.z;
+    m(1, 1) = t * a.y * a.y + c;
+    m(1, 2) = t * a.y * a.z - s * a.x;
+    m(2, 0) = t * a.x * a.z - s * a.y;
+    m(2, 1) = t * a.y * a.z + s * a.x;
+    m(2, 2) = t * a.z * a.z + c;
+    return m;
+}
+
+} // namespace Prism
+
+#endif // PRISM_FIXED_MATRIX_HPP_
@@ -0,0 +1,72 @@
+#ifndef PRISM_IMAGE_HPP_
+#define PRISM_IMAGE_HPP_
+
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+#include <cstddef>
+#include <vector>
+
+namespace Prism {
+
+/**
+ * @struct Tile
+ * @brief Rectangular block of pixels covering columns [x0, x1) and rows [y0, y1).
+ */
+struct PRISM_EXPORT Tile {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+};
+
+/**
+ * @class Image
+ * @brief Row-major RGB framebuffer. Each pixel is a Vector3 holding (r, g, b).
+ */
+class PRISM_EXPORT Image {
+  public:
+    /**
+     * @brief Constructs a black image.
+     * @param width The width of the image in pixels.
+     * @param height The height of the image in pixels.
+     * @throws std::invalid_argument if either dimension is not positive.
+     */
+    Image(int width, int height);
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    /**
+     * @brief Accesses a pixel. Coordinates are not bounds-checked.
+     * @param x The column, from left to right.
+     * @param y The row, from top to bottom.
+     */
+    Vector3& pixel(int x, int y) {
+        return pixels_[static_cast<size_t>(y) * width_ + x];
+    }
+
+    const Vector3& pixel(int x, int y) const {
+        return pixels_[static_cast<size_t>(y) * width_ + x];
+    }
+
+    /**
+     * @brief Gets all pixels in row-major order.
+     */
+    const std::vector<Vector3>& pixels() const {
+        return pixels_;
+    }
+
+  private:
+    int width_;
+    int height_;
+    std::vector<Vector3> pixels_;
+};
+
+} // namespace Prism
+
+#endif // PRISM_IMAGE_HPP_
@@ -0,0 +1,127 @@
+#ifndef PRISM_IMAGE_WRITER_HPP_
+#define PRISM_IMAGE_WRITER_HPP_
+
+#include "Prism/image.hpp"
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Prism {
+
+/**
+ * @brief File formats supported by ImageWriter.
+ */
+enum class ImageFormat { PPM, PNG };
+
+/**
+ * @brief Picks the format matching the extension of a path (".ppm" or ".png", any case).
+ * @throws std::invalid_argument for any other extension.
+ */
+PRISM_EXPORT ImageFormat imageFormatFromPath(const std::string& path);
+
+/**
+ * @class ImageWriter
+ * @brief Writes an image to disk as its tiles are finished, without holding the whole frame.
+ *
+ * Tiles may arrive in any order and from several threads. Rows are converted to 8-bit RGB
+ * (channels clamped to [0, 1]) into a ring buffer of windowRows() rows, and written out as soon
+ * as every row above them is complete, so memory stays bounded by the window whatever the image
+ * size. PNG data is stored uncompressed (stored deflate blocks), split into IDAT chunks.
+ */
+class PRISM_EXPORT ImageWriter {
+  public:
+    /**
+     * @brief Creates the file and writes the header.
+     * @param path The output file; the format comes from its extension.
+     * @param width The width of the image in pixels.
+     * @param height The height of the image in pixels.
+     * @param window_rows Number of rows buffered ahead of the first incomplete row.
+     * @throws std::invalid_argument if a size is not positive or the extension is unknown.
+     * @throws std::runtime_error if the file cannot be created.
+     */
+    ImageWriter(const std::string& path, int width, int height, int window_rows = 64);
+
+    /**
+     * @brief Closes the file. An unfinished image is left truncated.
+     */
+    ~ImageWriter();
+
+    ImageWriter(const ImageWriter&) = delete;
+    ImageWriter& operator=(const ImageWriter&) = delete;
+
+    /**
+     * @brief Stores a finished tile and writes every row that became complete. Thread-safe.
+     * @param tile The pixels covered by the tile.
+     * @param pixels The tile pixels, row-major, (x1 - x0) * (y1 - y0) of them.
+     * @throws std::out_of_range if the tile leaves the image, covers rows already written, or
+     * reaches past the window.
+     * @throws std::logic_error if a row receives more pixels than its width.
+     * @throws std::runtime_error if writing fails.
+     */
+    void writeTile(const Tile& tile, const Vector3* pixels);
+
+    /**
+     * @brief Writes the trailer and closes the file.
+     * @throws std::logic_error if some rows were never completed.
+     * @throws std::runtime_error if writing fails.
+     */
+    void finish();
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    int windowRows() const {
+        return window_rows_;
+    }
+
+    ImageFormat format() const {
+        return format_;
+    }
+
+    /**
+     * @brief Gets the number of rows written to the file so far.
+     */
+    int rowsWritten() const;
+
+  private:
+    void flushRows();
+    void writeRow(const uint8_t* rgb);
+    void writeIdat();
+    void writeBytes(const void* data, size_t size);
+
+    std::string path_;
+    std::ofstream file_;
+    ImageFormat format_;
+    int width_;
+    int height_;
+    int window_rows_;
+    int next_row_ = 0;
+    bool finished_ = false;
+    std::vector<uint8_t> window_; ///< RGB rows, row y in slot y % window_rows_.
+    std::vector<int> filled_;     ///< Pixels received by each window slot.
+    std::vector<uint8_t> idat_;   ///< Pending zlib data of the next PNG IDAT chunk.
+    uint32_t adler_a_ = 1;        ///< Running Adler-32 of the PNG scanlines.
+    uint32_t adler_b_ = 0;
+    mutable std::mutex mutex_;
+};
+
+/**
+ * @brief Writes a whole framebuffer with ImageWriter.
+ * @param path The output file; the format comes from its extension.
+ * @param image The image to write.
+ */
+PRISM_EXPORT void writeImage(const std::string& path, const Image& image);
+
+} // namespace Prism
+
+#endif // PRISM_IMAGE_WRITER_HPP_
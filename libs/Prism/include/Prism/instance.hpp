@@ -0,0 +1,91 @@
+#ifndef PRISM_INSTANCE_HPP_
+#define PRISM_INSTANCE_HPP_
+
+#include "Prism/aabb.hpp"
+#include "Prism/fixed_matrix.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/ray_packet.hpp"
+#include "Prism/scalar.hpp"
+#include "prism_export.h"
+
+namespace Prism {
+
+/**
+ * @class Instance
+ * @brief A placement of shared geometry in the scene through an affine transform.
+ *
+ * The geometry, typically a TriangleMesh with its own BVH, is the bottom level: it is built once
+ * in its own object space and never copied. An instance only stores the transform, its inverse
+ * and its world bounds, so a mesh can be placed any number of times at constant memory per
+ * instance. Adding instances to a Scene gives the top level; after setTransform(), only the
+ * scene hierarchy has to be rebuilt.
+ *
+ * Rays are moved into object space, traced against the geometry and the hit is moved back, so
+ * distances, points and normals are reported in world space. The geometry is not owned and must
+ * outlive the instance.
+ */
+class PRISM_EXPORT Instance : public Object {
+  public:
+    /**
+     * @brief Places geometry in the scene.
+     * @param geometry The shared geometry, in its own object space.
+     * @param object_to_world The transform from object space to world space.
+     * @throws std::invalid_argument if the transform is singular or not affine.
+     */
+    explicit Instance(const Object& geometry, const Mat4& object_to_world = Mat4::identity());
+
+    bool hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const override;
+
+    /**
+     * @brief Moves the packet into object space and traces it against the geometry as a whole,
+     * so the geometry can still traverse its hierarchy once per packet. Transforms that do not
+     * preserve angles (non-uniform scaling, shearing) fall back to tracing lane by lane.
+     */
+    void hitPacket(const RayPacket& packet, ld t_min, PacketHit& hits) const override;
+
+    bool occluded(const Ray& ray, ld t_min, ld t_max) const override;
+
+    /**
+     * @brief Gets the box around the transformed bounds of the geometry. Unbounded geometry
+     * gives an unbounded instance.
+     */
+    bool boundingBox(AABB& box) const override;
+
+    /**
+     * @brief Moves the instance. The scene it belongs to must be built again.
+     * @throws std::invalid_argument if the transform is singular or not affine.
+     */
+    void setTransform(const Mat4& object_to_world);
+
+    const Object& geometry() const {
+        return *geometry_;
+    }
+
+    const Mat4& transform() const {
+        return object_to_world_;
+    }
+
+    const Mat4& inverseTransform() const {
+        return world_to_object_;
+    }
+
+  private:
+    // Moves a world ray into object space. Object-space distances are `scale` times the world
+    // distances, as the ray direction is normalized again.
+    Ray toObject(const Ray& ray, ld& scale) const;
+
+    // Moves an object-space hit back to world space.
+    void toWorld(HitRecord& rec, ld scale) const;
+
+    const Object* geometry_;
+    Mat4 object_to_world_;
+    Mat4 world_to_object_;
+    AABB bounds_;
+    bool bounded_ = false;
+    bool similarity_ = false; ///< Whether the transform scales every direction alike.
+};
+
+} // namespace Prism
+
+#endif // PRISM_INSTANCE_HPP_
@@ -0,0 +1,58 @@
+#ifndef PRISM_MAPPED_FILE_HPP_
+#define PRISM_MAPPED_FILE_HPP_
+
+#include "prism_export.h"
+#include <cstddef>
+#include <string>
+
+namespace Prism {
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The contents are paged in by the operating system on first access, so large assets can be
+ * parsed or used in place without being copied into the heap first.
+ */
+class PRISM_EXPORT MappedFile {
+  public:
+    /**
+     * @brief Maps a file into memory.
+     * @param path The path of the file.
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Gets the first byte of the file, or nullptr for an empty file.
+     */
+    const char* data() const {
+        return data_;
+    }
+
+    /**
+     * @brief Gets the size of the file in bytes.
+     */
+    size_t size() const {
+        return size_;
+    }
+
+  private:
+    void release();
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    void* mapping_ = nullptr; ///< Platform mapping handle, only used on Windows.
+};
+
+} // namespace Prism
+
+#endif // PRISM_MAPPED_FILE_HPP_
@@ -0,0 +1,81 @@
+#ifndef PRISM_MATERIAL_HPP_
+#define PRISM_MATERIAL_HPP_
+
+#include "Prism/obj_loader.hpp"
+#include "Prism/scalar.hpp"
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Prism {
+
+/**
+ * @class Material
+ * @brief Phong-style material coefficients, as read from an .mtl file. Colors are stored as
+ * Vector3 (r, g, b).
+ */
+class PRISM_EXPORT Material {
+  public:
+    Material() = default;
+
+    /**
+     * @brief Converts the plain coefficients of a loaded mesh.
+     */
+    explicit Material(const MeshMaterial& material);
+
+    Vector3 ka; ///< Ambient color.
+    Vector3 kd; ///< Diffuse color.
+    Vector3 ks; ///< Specular color.
+    Vector3 ke; ///< Emissive color.
+    ld ns = 0;  ///< Shininess.
+    ld ni = 1;  ///< Index of refraction.
+    ld d = 1;   ///< Opacity.
+};
+
+/**
+ * @class MaterialTable
+ * @brief Materials shared by several meshes, referenced by a 16-bit id.
+ *
+ * Triangles store only the id, so every triangle of a material shares one copy of its
+ * coefficients.
+ */
+class PRISM_EXPORT MaterialTable {
+  public:
+    static constexpr uint16_t kNoMaterial = 0xFFFF; ///< Id of triangles without a material.
+
+    /**
+     * @brief Adds a material.
+     * @return The id of the new material.
+     * @throws std::length_error if the table already holds kNoMaterial materials.
+     */
+    uint16_t add(const Material& material);
+
+    /**
+     * @brief Adds the materials of a mesh.
+     * @param materials The coefficients of every material, or nullptr to add default materials.
+     * @param count Number of materials to add.
+     * @return The id of the first added material; mesh material i gets that id plus i.
+     * @throws std::length_error if the materials do not fit in the table.
+     */
+    uint16_t add(const MeshMaterial* materials, size_t count);
+
+    /**
+     * @brief Accesses a material without bounds checking.
+     */
+    const Material& operator[](uint16_t id) const {
+        return materials_[id];
+    }
+
+    size_t size() const {
+        return materials_.size();
+    }
+
+  private:
+    std::vector<Material> materials_;
+};
+
+} // namespace Prism
+
+#endif // PRISM_MATERIAL_HPP_
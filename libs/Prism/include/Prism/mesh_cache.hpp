@@ -0,0 +1,176 @@
+#ifndef PRISM_MESH_CACHE_HPP_
+#define PRISM_MESH_CACHE_HPP_
+
+#include "Prism/array_view.hpp"
+#include "Prism/mapped_file.hpp"
+#include "Prism/obj_loader.hpp"
+#include "prism_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class objReader;
+
+namespace Prism {
+
+/**
+ * @struct SourceFingerprint
+ * @brief Size and last write time of the .obj and .mtl files a mesh cache was built from.
+ *
+ * A file that does not exist has a size and time of 0. Times are in the units of the file system
+ * clock, so fingerprints are only compared with others taken on the same platform.
+ */
+struct PRISM_EXPORT SourceFingerprint {
+    uint64_t obj_size = 0;
+    int64_t obj_time = 0;
+    uint64_t mtl_size = 0;
+    int64_t mtl_time = 0;
+
+    bool operator==(const SourceFingerprint& other) const {
+        return obj_size == other.obj_size && obj_time == other.obj_time &&
+               mtl_size == other.mtl_size && mtl_time == other.mtl_time;
+    }
+
+    bool operator!=(const SourceFingerprint& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Takes the fingerprint of a mesh's source files.
+ * @param obj_path The path of the .obj file.
+ * @param mtl_path The path of its .mtl file.
+ */
+PRISM_EXPORT SourceFingerprint fingerprintSources(const std::string& obj_path,
+                                                  const std::string& mtl_path);
+
+/**
+ * @brief Writes a mesh to a binary cache file.
+ *
+ * The file is a fixed header (magic "PRISMMSH", format version, byte order, source fingerprint,
+ * element counts and section offsets) followed by the positions, normals, indices, normal
+ * indices, material ids, material coefficients and a block of null-terminated strings (material
+ * library, then material names). Every section starts on a 16 byte boundary so it can be used in
+ * place once mapped. The file is written next to path and renamed over it, so readers never see
+ * a partial cache.
+ *
+ * @param path The path of the cache file.
+ * @param mesh The mesh to store.
+ * @param source The fingerprint of the files the mesh was read from, returned by
+ * MeshCache::source() so stale caches can be detected.
+ * @throws std::invalid_argument if the mesh arrays have inconsistent sizes.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+PRISM_EXPORT void writeMeshCache(const std::string& path, const MeshData& mesh,
+                                 const SourceFingerprint& source = SourceFingerprint());
+
+/**
+ * @brief Converts the mesh read by an objReader into flat arrays.
+ *
+ * Materials come from the dense table of the reader's colormap, through the id stored in each
+ * face, and keep their .mtl names. Faces without a known material get MeshData::kNoIndex.
+ *
+ * @throws std::runtime_error if a face refers to a vertex that does not exist.
+ */
+PRISM_EXPORT MeshData meshDataFromObjReader(const objReader& reader);
+
+/**
+ * @brief Same as meshDataFromObjReader(const objReader&), but takes the buffers out of the
+ * reader and frees each one once converted, so the reader's data is never held twice.
+ */
+PRISM_EXPORT MeshData meshDataFromObjReader(objReader&& reader);
+
+/**
+ * @class MeshCache
+ * @brief Memory-mapped mesh cache written by writeMeshCache.
+ *
+ * The arrays are views into the mapping, so opening a cache costs a header check and the pages
+ * are read from disk as they are first used. Only the structure of the file is validated: the
+ * index values themselves are trusted, and so is the cache being up to date: compare source()
+ * with the fingerprint of the source files before using it.
+ */
+class PRISM_EXPORT MeshCache {
+  public:
+    static constexpr uint32_t kVersion = 2; ///< Version written by writeMeshCache.
+
+    /**
+     * @brief Maps a cache file.
+     * @param path The path of the cache file.
+     * @throws std::runtime_error if the file cannot be mapped, was written by another version or
+     * is truncated or corrupt.
+     */
+    explicit MeshCache(const std::string& path);
+
+    /**
+     * @brief Gets the fingerprint of the files the mesh was read from, as given to writeMeshCache.
+     */
+    const SourceFingerprint& source() const {
+        return source_;
+    }
+
+    size_t vertexCount() const {
+        return positions_.size() / 3;
+    }
+
+    size_t normalCount() const {
+        return normals_.size() / 3;
+    }
+
+    size_t triangleCount() const {
+        return material_ids_.size();
+    }
+
+    ArrayView<float> positions() const {
+        return positions_;
+    }
+
+    ArrayView<float> normals() const {
+        return normals_;
+    }
+
+    ArrayView<uint32_t> indices() const {
+        return indices_;
+    }
+
+    ArrayView<uint32_t> normalIndices() const {
+        return normal_indices_;
+    }
+
+    ArrayView<uint32_t> materialIds() const {
+        return material_ids_;
+    }
+
+    ArrayView<MeshMaterial> materials() const {
+        return materials_;
+    }
+
+    const std::vector<std::string>& materialNames() const {
+        return material_names_;
+    }
+
+    const std::string& materialLibrary() const {
+        return material_library_;
+    }
+
+    /**
+     * @brief Copies the cached mesh into an owning MeshData.
+     */
+    MeshData toMeshData() const;
+
+  private:
+    MappedFile file_;
+    SourceFingerprint source_;
+    ArrayView<float> positions_;
+    ArrayView<float> normals_;
+    ArrayView<uint32_t> indices_;
+    ArrayView<uint32_t> normal_indices_;
+    ArrayView<uint32_t> material_ids_;
+    ArrayView<MeshMaterial> materials_;
+    std::vector<std::string> material_names_;
+    std::string material_library_;
+};
+
+} // namespace Prism
+
+#endif // PRISM_MESH_CACHE_HPP_
@@ -0,0 +1,85 @@
+#ifndef PRISM_OBJ_LOADER_HPP_
+#define PRISM_OBJ_LOADER_HPP_
+
+#include "prism_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Prism {
+
+class ThreadPool;
+
+/**
+ * @struct MeshMaterial
+ * @brief Material coefficients of a mesh as plain floats, so they can be stored in a file as is.
+ */
+struct MeshMaterial {
+    float ka[3]; ///< Ambient color.
+    float kd[3]; ///< Diffuse color.
+    float ks[3]; ///< Specular color.
+    float ke[3]; ///< Emissive color.
+    float ns;    ///< Shininess.
+    float ni;    ///< Index of refraction.
+    float d;     ///< Opacity.
+};
+
+/**
+ * @struct MeshData
+ * @brief Triangle mesh stored as flat arrays, ready to be copied to a cache or an acceleration
+ * structure without walking per-face objects.
+ */
+struct PRISM_EXPORT MeshData {
+    static constexpr uint32_t kNoIndex = 0xFFFFFFFFu; ///< Marks a missing normal or material.
+
+    std::vector<float> positions;            ///< x, y, z of every vertex.
+    std::vector<float> normals;              ///< x, y, z of every normal.
+    std::vector<uint32_t> indices;           ///< Three vertex indices per triangle.
+    std::vector<uint32_t> normal_indices;    ///< Three normal indices per triangle, or kNoIndex.
+    std::vector<uint32_t> material_ids;      ///< Material of every triangle, or kNoIndex.
+    std::vector<std::string> material_names; ///< Names given to usemtl, in order of first use.
+    std::vector<MeshMaterial> materials;     ///< Coefficients of every material, or empty.
+    std::string material_library;            ///< File named by the first mtllib statement.
+
+    size_t vertexCount() const {
+        return positions.size() / 3;
+    }
+
+    size_t normalCount() const {
+        return normals.size() / 3;
+    }
+
+    size_t triangleCount() const {
+        return indices.size() / 3;
+    }
+};
+
+/**
+ * @brief Parses OBJ text into a MeshData.
+ *
+ * Understands v, vn, f, usemtl and mtllib; every other statement is skipped. Faces may use the
+ * v, v/vt, v//vn and v/vt/vn forms and negative (relative) indices, and polygons are split into
+ * a triangle fan. The text is cut into chunks at line boundaries that are parsed in parallel
+ * when a pool is given, so the result does not depend on the pool or the chunk size.
+ *
+ * @param data The OBJ text. It does not need to be null terminated.
+ * @param size Number of bytes in data.
+ * @param pool Pool that parses the chunks, or nullptr to parse on the calling thread.
+ * @param chunk_bytes Approximate size of a chunk.
+ * @throws std::runtime_error if a statement is malformed or an index is out of range.
+ */
+PRISM_EXPORT MeshData parseObj(const char* data, size_t size, ThreadPool* pool = nullptr,
+                               size_t chunk_bytes = size_t(4) << 20);
+
+/**
+ * @brief Memory maps an OBJ file and parses it with parseObj.
+ * @param path The path of the .obj file.
+ * @param pool Pool that parses the chunks, or nullptr to parse on the calling thread.
+ * @throws std::runtime_error if the file cannot be read or is malformed.
+ */
+PRISM_EXPORT MeshData loadObj(const std::string& path, ThreadPool* pool = nullptr);
+
+} // namespace Prism
+
+#endif // PRISM_OBJ_LOADER_HPP_
@@ -1,15 +1,16 @@
 #ifndef PRISM_OBJECT_HPP_
 #define PRISM_OBJECT_HPP_
 
+#include "Prism/aabb.hpp"
 #include "Prism/point.hpp"
 #include "Prism/ray.hpp"
+#include "Prism/ray_packet.hpp"
+#include "Prism/scalar.hpp"
 #include "Prism/vector.hpp"
 #include "prism_export.h"
 
 namespace Prism {
 
-using ld = long double;
-
 class Ray;      // Forward declaration of Ray class
 class Material; // Forward declaration of Material class
 
@@ -17,15 +18,36 @@ struct PRISM_EXPORT HitRecord {
     Point3 p;
     Vector3 normal;
     ld t;
-    Material* material;
+    const Material* material;
     bool front_face;
 
     inline void set_face_normal(const Ray& ray, const Vector3& outward_normal) {
-        front_face = (ray.Direction())->dot(outward_normal) < 0;
+        front_face = ray.Direction().dot(outward_normal) < 0;
         normal = front_face ? outward_normal : outward_normal * -1;
     }
 };
 
+/**
+ * @struct PacketHit
+ * @brief Closest hits of every lane of a RayPacket.
+ */
+struct PRISM_EXPORT PacketHit {
+    HitRecord records[RayPacket::kSize]; ///< Closest hit of every lane, valid where hit is set.
+    ld t_max[RayPacket::kSize];          ///< Closest distance found so far, per lane.
+    bool hit[RayPacket::kSize];          ///< Whether the lane hit anything.
+
+    /**
+     * @brief Clears every lane before a query.
+     * @param t_max_value The maximum distance for a valid hit.
+     */
+    void reset(ld t_max_value) {
+        for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+            t_max[lane] = t_max_value;
+            hit[lane] = false;
+        }
+    }
+};
+
 class PRISM_EXPORT Object {
   public:
     virtual ~Object() = default;
@@ -39,6 +61,49 @@ class PRISM_EXPORT Object {
      * @return True if a valid hit was found, false otherwise.
      */
     virtual bool hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const = 0;
+
+    /**
+     * @brief Intersects every active lane of a packet, keeping the closer hits.
+     * @param packet The rays to test.
+     * @param t_min The minimum distance for a valid hit.
+     * @param hits Per-lane closest hits. A lane is only updated when the object is hit closer
+     * than hits.t_max of that lane. The default tests the lanes one by one with hit().
+     */
+    virtual void hitPacket(const RayPacket& packet, ld t_min, PacketHit& hits) const {
+        HitRecord rec;
+        for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+            if (packet.active[lane] && hit(packet.ray(lane), t_min, hits.t_max[lane], rec)) {
+                hits.records[lane] = rec;
+                hits.t_max[lane] = rec.t;
+                hits.hit[lane] = true;
+            }
+        }
+    }
+
+    /**
+     * @brief Checks whether anything of the object lies on a ray within a distance range, e.g.
+     * for shadow and ambient occlusion rays. Unlike hit(), any intersection will do, so
+     * implementations stop at the first one they find and fill no record. The default calls
+     * hit().
+     * @param ray The ray to test.
+     * @param t_min The minimum distance for a blocking hit.
+     * @param t_max The maximum distance for a blocking hit, e.g. the distance to the light.
+     * @return True if the ray is blocked.
+     */
+    virtual bool occluded(const Ray& ray, ld t_min, ld t_max) const {
+        HitRecord rec;
+        return hit(ray, t_min, t_max, rec);
+    }
+
+    /**
+     * @brief Computes a box enclosing the whole object, used by the acceleration structures.
+     * @param box The box to be filled with the object bounds.
+     * @return True if the object is bounded. The default returns false, in which case the
+     * object is tested against every ray instead of being placed in the hierarchy.
+     */
+    virtual bool boundingBox(AABB& /*box*/) const {
+        return false;
+    }
 };
 
 } // namespace Prism
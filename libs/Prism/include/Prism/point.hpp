@@ -2,11 +2,10 @@
 #define PRISM_POINT_HPP_
 
 #include "prism_export.h"
+#include "Prism/scalar.hpp"
 #include <initializer_list>
 namespace Prism {
 
-using ld = long double;
-
 class Vector3; // Forward declaration of Vector3 class
 
 /**
@@ -29,7 +28,7 @@ class PRISM_EXPORT Point3 {
      * @brief Copy constructor.
      * @param v The point to copy from.
      */
-    Point3(const Point3& p);
+    Point3(const Point3& p) = default;
 
     /**
      * @brief Constructs a Point from a Vector3.
@@ -48,7 +47,7 @@ class PRISM_EXPORT Point3 {
      * @param p The point to assign from.
      * @return Reference to this point.
      */
-    Point3 operator=(const Point3& p);
+    Point3& operator=(const Point3& p) = default;
 
     /**
      * @brief Checks if two points are equal.
@@ -2,24 +2,33 @@
 #define PRISM_RAY_HPP_
 
 #include "prism_export.h"
+#include "Prism/point.hpp"
+#include "Prism/scalar.hpp"
+#include "Prism/vector.hpp"
 #include <initializer_list>
+#include <type_traits>
 #include <vector>
 namespace Prism {
 
-using ld = long double;
-
-class Vector3;                      // Forward declaration of Vector3 class
-class Point3;                       // Forward declaration of Point3 class
 template <typename T> class Matrix; // Forward declaration of Matrix class
 class Object;                       // Forward declaration of Object class
 struct HitRecord;                   // Forward declaration of HitRecord struct
+class Scene;                        // Forward declaration of Scene class
 
 /**
  * @class Ray
  * @brief Represents a Ray with a direction originated from a point
+ *
+ * Rays are plain values: origin, direction and inverse direction are stored inline, so
+ * constructing or copying a ray never touches the heap.
  */
 class PRISM_EXPORT Ray {
   public:
+    /**
+     * @brief Constructs a degenerate ray at the origin with a zero direction. Only meant as a
+     * placeholder to be assigned over.
+     */
+    Ray() = default;
     /**
      * @brief Constructs a Ray given its origin and the direction at which it points
      * @param origin Point in 3d space that originates the ray.
@@ -39,14 +48,26 @@ class PRISM_EXPORT Ray {
      */
     HitRecord Gethit(const std ::vector<Object*>& objects, const ld& t_min, const ld& t_max);
     /**
-     * @brief gets the direction of ray. if not instantiated, returns null
+     * @brief Casts the ray through the scene acceleration structure and returns the first hit
+     * @param scene built scene to be traced
+     * @param t_min minimum distance at which intersections are verified
+     * @param t_max maximum distance at which intersections are verified
      */
-    Vector3* Direction() const;
+    HitRecord Gethit(const Scene& scene, const ld& t_min, const ld& t_max);
+    /**
+     * @brief gets the direction of ray
+     */
+    const Vector3& Direction() const {
+        return direction;
+    }
 
-    Point3* origin;
-    Vector3* direction;
+    Point3 origin;         ///< Point in 3d space that originates the ray.
+    Vector3 direction;     ///< Normalized direction of the ray.
+    Vector3 inv_direction; ///< Component-wise inverse of direction, used by the slab tests.
 };
 
+static_assert(std::is_trivially_copyable<Ray>::value, "Ray must stay a plain value type");
+
 } // namespace Prism
 
 #endif // PRISM_RAY_HPP_
\ No newline at end of file
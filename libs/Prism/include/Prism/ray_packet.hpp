@@ -0,0 +1,71 @@
+#ifndef PRISM_RAY_PACKET_HPP_
+#define PRISM_RAY_PACKET_HPP_
+
+#include "Prism/ray.hpp"
+#include "Prism/scalar.hpp"
+#include "prism_export.h"
+
+namespace Prism {
+
+/**
+ * @struct RayPacket
+ * @brief A tile of coherent rays stored coordinate by coordinate (structure of arrays).
+ *
+ * Lane i holds the ray of pixel (x0 + i % kWidth, y0 + i / kWidth). Lanes that fall outside the
+ * image are inactive and must be ignored by every consumer.
+ */
+struct PRISM_EXPORT RayPacket {
+    static constexpr int kWidth = 4;               ///< Pixels per packet row.
+    static constexpr int kHeight = 4;              ///< Pixel rows per packet.
+    static constexpr int kSize = kWidth * kHeight; ///< Number of lanes.
+
+    ld origin[3][kSize];        ///< Ray origins, x, y and z.
+    ld direction[3][kSize];     ///< Normalized ray directions, x, y and z.
+    ld inv_direction[3][kSize]; ///< Component-wise inverse of the directions.
+    bool active[kSize];         ///< Whether the lane holds a ray.
+    int x0 = 0;                 ///< Pixel column of lane 0.
+    int y0 = 0;                 ///< Pixel row of lane 0.
+
+    /**
+     * @brief Stores a ray in a lane and activates it.
+     */
+    void set(int lane, const Ray& ray) {
+        const ld o[3] = {ray.origin.x, ray.origin.y, ray.origin.z};
+        const ld d[3] = {ray.direction.x, ray.direction.y, ray.direction.z};
+        const ld inv[3] = {ray.inv_direction.x, ray.inv_direction.y, ray.inv_direction.z};
+        for (int k = 0; k < 3; ++k) {
+            origin[k][lane] = o[k];
+            direction[k][lane] = d[k];
+            inv_direction[k][lane] = inv[k];
+        }
+        active[lane] = true;
+    }
+
+    /**
+     * @brief Rebuilds the ray of a lane. No normalization is done, so this is cheap.
+     */
+    Ray ray(int lane) const {
+        Ray ray;
+        ray.origin = Point3(origin[0][lane], origin[1][lane], origin[2][lane]);
+        ray.direction = Vector3(direction[0][lane], direction[1][lane], direction[2][lane]);
+        ray.inv_direction =
+            Vector3(inv_direction[0][lane], inv_direction[1][lane], inv_direction[2][lane]);
+        return ray;
+    }
+
+    /**
+     * @brief Gets the first active lane, or -1 if the packet is empty.
+     */
+    int firstActive() const {
+        for (int lane = 0; lane < kSize; ++lane) {
+            if (active[lane]) {
+                return lane;
+            }
+        }
+        return -1;
+    }
+};
+
+} // namespace Prism
+
+#endif // PRISM_RAY_PACKET_HPP_
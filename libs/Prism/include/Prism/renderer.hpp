@@ -0,0 +1,229 @@
+#ifndef PRISM_RENDERER_HPP_
+#define PRISM_RENDERER_HPP_
+
+#include "Prism/camera.hpp"
+#include "Prism/image.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/sampler.hpp"
+#include "Prism/thread_pool.hpp"
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Prism {
+
+class Accumulator;
+class CameraPath;
+class ImageWriter;
+class Scene;
+class ShadowQueue;
+
+/**
+ * @struct AdaptiveSettings
+ * @brief Controls when Renderer::renderAdaptive stops sampling a pixel.
+ *
+ * A pixel is converged once it holds at least min_samples samples and the standard error of its
+ * mean luminance is at most max_error, or once it reaches max_samples.
+ */
+struct PRISM_EXPORT AdaptiveSettings {
+    uint32_t min_samples = 16;   ///< Samples every pixel takes before its variance is trusted.
+    uint32_t max_samples = 1024; ///< Samples after which a pixel stops whatever its variance.
+    ld max_error = ld(0.002);    ///< Largest standard error of the mean luminance, in [0, 1] units.
+};
+
+/**
+ * @class Renderer
+ * @brief Renders a Camera's image tile by tile on a work-stealing thread pool.
+ *
+ * Every pixel is shaded independently from its primary ray and written to its own slot of the
+ * image, so the output is identical whatever the number of threads or the order tiles finish in.
+ */
+class PRISM_EXPORT Renderer {
+  public:
+    /**
+     * @brief Computes the color carried back along a primary ray. Called concurrently.
+     */
+    using Shader = std::function<Vector3(const Ray&)>;
+
+    /**
+     * @brief Shader that also draws random numbers, e.g. to sample lights. The sampler is
+     * positioned on the current sample of the pixel, past the dimensions used by the camera.
+     * Called concurrently, each thread with its own sampler.
+     */
+    using SampledShader = std::function<Vector3(const Ray&, Sampler&)>;
+
+    /**
+     * @brief Constructs a renderer with its own thread pool.
+     * @param thread_count Number of worker threads. 0 uses the number of hardware threads.
+     * @param tile_size Width and height of the square tiles, in pixels.
+     * @throws std::invalid_argument if tile_size is not positive.
+     */
+    explicit Renderer(size_t thread_count = 0, int tile_size = 32);
+
+    /**
+     * @brief Renders a full frame.
+     * @param camera The camera generating the primary rays.
+     * @param shade The shader evaluated for each primary ray.
+     * @return The rendered image, pixel_width x pixel_height.
+     */
+    Image render(const Camera& camera, const Shader& shade);
+
+    /**
+     * @brief Shader that defers its shadow rays: it returns the light that needs no shadow
+     * test and pushes one ray per light into the queue, which is set on the current pixel.
+     * Called concurrently, each thread with its own queue.
+     */
+    using DeferredShader = std::function<Vector3(const Ray&, ShadowQueue&)>;
+
+    /**
+     * @brief Receives the frames of an animation, in order, on the thread that renders them.
+     */
+    using FrameCallback = std::function<void(int frame, const Image& image)>;
+
+    /**
+     * @brief Renders an animation back to back, moving one camera along a path between frames.
+     *
+     * Frame i is rendered at CameraPath::frameTime(i, frame_count): frames are spread evenly from
+     * the first key of the path to the last, both included, except on a closed path, which stops
+     * one step before returning to the first key so the frames loop. The camera is updated
+     * through its setters rather than rebuilt, and is left on the last frame.
+     * @param camera The camera moved along the path and generating the primary rays.
+     * @param path The camera animation.
+     * @param frame_count The number of frames.
+     * @param shade The shader evaluated for each primary ray.
+     * @param on_frame Called with each frame as soon as it is rendered.
+     * @throws std::invalid_argument if frame_count is not positive.
+     * @throws std::logic_error if the path has no key.
+     */
+    void renderFrames(Camera& camera, const CameraPath& path, int frame_count, const Shader& shade,
+                      const FrameCallback& on_frame);
+
+    /**
+     * @brief Renders a full frame straight into a streaming writer, without a framebuffer.
+     *
+     * Tiles are rendered in horizontal bands as tall as the writer window allows, so only the
+     * writer window and the tiles in flight are held in memory. The writer is finished at the end.
+     * @param camera The camera generating the primary rays.
+     * @param shade The shader evaluated for each primary ray.
+     * @param out The writer, with the same size as the camera image.
+     * @throws std::invalid_argument if the writer size differs from the camera image, or its
+     * window is shorter than a tile.
+     */
+    void render(const Camera& camera, const Shader& shade, ImageWriter& out);
+
+    /**
+     * @brief Renders a full frame, tracing shadow rays in sorted batches instead of one by one.
+     *
+     * Each thread shades the primary rays of a tile into its own ShadowQueue, then traces the
+     * queued rays sorted by direction and origin (see ShadowQueue::sort) and adds the light of
+     * the unblocked ones to their pixels. The image matches shading with immediate
+     * Scene::occluded tests up to rounding, and does not depend on the number of threads.
+     * @param camera The camera generating the primary rays.
+     * @param shade The shader evaluated for each primary ray.
+     * @param scene The built scene the shadow rays are traced through.
+     * @return The rendered image, pixel_width x pixel_height.
+     * @throws std::logic_error if the scene has not been built.
+     */
+    Image renderDeferred(const Camera& camera, const DeferredShader& shade, const Scene& scene);
+
+    /**
+     * @brief Adds one jittered sample to every pixel of an accumulation buffer.
+     *
+     * Sample n of a pixel is drawn from sampler() positioned on that pixel and sample index n,
+     * where n is the number of samples the pixel already holds. Successive passes thus give the
+     * same buffer whatever the number of threads, and a buffer saved after a pass and loaded
+     * later resumes exactly where it stopped.
+     * @param camera The camera generating the primary rays.
+     * @param shade The shader evaluated for each primary ray.
+     * @param accumulator The buffer receiving the samples, with the same size as the camera image.
+     * @param stop Polled before each tile; once it is set, the remaining tiles are skipped and the
+     * buffer stays valid, with fewer samples in the skipped pixels.
+     * @return Whether every pixel received its sample.
+     * @throws std::invalid_argument if the buffer size differs from the camera image.
+     */
+    bool renderPass(const Camera& camera, const Shader& shade, Accumulator& accumulator,
+                    const std::atomic<bool>* stop = nullptr);
+
+    /**
+     * @brief Same as renderPass(), with a shader that draws from the sampler.
+     */
+    bool renderPass(const Camera& camera, const SampledShader& shade, Accumulator& accumulator,
+                    const std::atomic<bool>* stop = nullptr);
+
+    /**
+     * @brief Samples every pixel until it converges, as defined by the settings.
+     *
+     * Works in rounds of one sample per unconverged pixel, skipping tiles whose pixels have all
+     * converged, so flat regions stop at min_samples while edges and noisy areas keep sampling.
+     * Samples are jittered like renderPass(), and whether a pixel is converged only depends on
+     * the buffer, so the result does not depend on the number of threads and a saved buffer can
+     * be resumed.
+     * @param camera The camera generating the primary rays.
+     * @param shade The shader evaluated for each primary ray.
+     * @param accumulator The buffer receiving the samples, with the same size as the camera image.
+     * @param settings The convergence criterion.
+     * @param stop Polled before each tile; once it is set, the remaining tiles are skipped, no
+     * further round starts and the buffer stays valid, with fewer samples in the skipped pixels.
+     * @return The number of samples added.
+     * @throws std::invalid_argument if the buffer size differs from the camera image, or
+     * min_samples is below 2, max_samples below min_samples, or max_error negative.
+     */
+    uint64_t renderAdaptive(const Camera& camera, const Shader& shade, Accumulator& accumulator,
+                            const AdaptiveSettings& settings = AdaptiveSettings(),
+                            const std::atomic<bool>* stop = nullptr);
+
+    /**
+     * @brief Same as renderAdaptive(), with a shader that draws from the sampler.
+     */
+    uint64_t renderAdaptive(const Camera& camera, const SampledShader& shade,
+                            Accumulator& accumulator,
+                            const AdaptiveSettings& settings = AdaptiveSettings(),
+                            const std::atomic<bool>* stop = nullptr);
+
+    /**
+     * @brief Splits an image into row-major tiles; tiles on the right and bottom edges may be
+     * smaller.
+     * @param width The width of the image in pixels.
+     * @param height The height of the image in pixels.
+     * @param tile_size Width and height of the tiles in pixels.
+     */
+    static std::vector<Tile> makeTiles(int width, int height, int tile_size);
+
+    size_t threadCount() const {
+        return pool_.size();
+    }
+
+    int tileSize() const {
+        return tile_size_;
+    }
+
+    /**
+     * @brief Gets the sampler used by the progressive and adaptive modes. Defaults to a
+     * SobolSampler.
+     */
+    const Sampler& sampler() const {
+        return *sampler_;
+    }
+
+    /**
+     * @brief Replaces the sampler used by the progressive and adaptive modes with a copy of
+     * the given one.
+     */
+    void setSampler(const Sampler& sampler) {
+        sampler_ = sampler.clone();
+    }
+
+  private:
+    ThreadPool pool_;
+    int tile_size_;
+    std::unique_ptr<Sampler> sampler_;
+};
+
+} // namespace Prism
+
+#endif // PRISM_RENDERER_HPP_
@@ -0,0 +1,132 @@
+#ifndef PRISM_SAMPLER_HPP_
+#define PRISM_SAMPLER_HPP_
+
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+#include <cstdint>
+#include <memory>
+
+namespace Prism {
+
+/**
+ * @struct Sample2D
+ * @brief A point of the unit square [0, 1)^2.
+ */
+struct Sample2D {
+    ld u;
+    ld v;
+};
+
+/**
+ * @class Sampler
+ * @brief Generates the sample values of a pixel, dimension by dimension.
+ *
+ * A sampler is positioned on one sample of one pixel with startPixelSample() and then hands out
+ * the dimensions of that sample in order: the Camera draws the pixel jitter first, shading draws
+ * whatever comes after (light samples, ...). The values only depend on the pixel, the sample
+ * index and the dimension, so renders are reproducible and independent of the number of threads.
+ * A sampler keeps a cursor and must not be shared between threads; use clone().
+ */
+class PRISM_EXPORT Sampler {
+  public:
+    virtual ~Sampler() = default;
+
+    /**
+     * @brief Moves to sample `index` of pixel (x, y), starting again at the first dimension.
+     */
+    virtual void startPixelSample(int x, int y, uint32_t index) = 0;
+
+    /**
+     * @brief Gets the next dimension of the current sample, in [0, 1).
+     */
+    virtual ld get1D() = 0;
+
+    /**
+     * @brief Gets the next two dimensions of the current sample, in [0, 1)^2.
+     */
+    virtual Sample2D get2D() = 0;
+
+    /**
+     * @brief Copies the sampler, e.g. to give each thread its own.
+     */
+    virtual std::unique_ptr<Sampler> clone() const = 0;
+};
+
+/**
+ * @class SobolSampler
+ * @brief Owen-scrambled Sobol' points, shuffled per pixel.
+ *
+ * Generator matrices of the first kSobolDimensions dimensions are tabulated at compile time.
+ * Each pixel scrambles the sample index and every dimension with its own hash-based nested
+ * uniform (Owen) scramble, so the samples of a pixel stay well stratified for any sample count
+ * while neighbouring pixels are decorrelated. Dimensions past the table reuse it with a different
+ * scramble.
+ */
+class PRISM_EXPORT SobolSampler : public Sampler {
+  public:
+    static constexpr int kSobolDimensions = 16; ///< Number of tabulated dimensions.
+
+    /**
+     * @param seed Selects another, equally good, set of scrambles.
+     */
+    explicit SobolSampler(uint32_t seed = 0) : seed_(seed) {
+    }
+
+    void startPixelSample(int x, int y, uint32_t index) override;
+    ld get1D() override;
+    Sample2D get2D() override;
+    std::unique_ptr<Sampler> clone() const override;
+
+    /**
+     * @brief Gets the unscrambled Sobol' point `index` in a tabulated dimension, as a 32-bit
+     * fixed-point fraction.
+     */
+    static uint32_t sobol(uint32_t index, int dimension);
+
+  private:
+    uint32_t sample(int dimension);
+
+    uint32_t seed_;
+    uint32_t pixel_seed_ = 0;
+    uint32_t index_ = 0;
+    int dimension_ = 0;
+    int block_ = 0;               ///< Block of dimensions shuffled_index_ belongs to.
+    uint32_t shuffled_index_ = 0; ///< Index of the current sample, shuffled for block_.
+};
+
+/**
+ * @class BlueNoiseSampler
+ * @brief Sobol' points rotated per pixel by a blue-noise texture.
+ *
+ * Every pixel offsets the Sobol' points (Cranley-Patterson rotation) by the value of a
+ * kBlueNoiseSize x kBlueNoiseSize blue-noise tile, shifted per dimension. Each pixel is as well
+ * stratified as with plain Sobol' points, and at low sample counts the error left between
+ * neighbouring pixels is high-frequency noise, which looks much smoother than white noise.
+ */
+class PRISM_EXPORT BlueNoiseSampler : public Sampler {
+  public:
+    static constexpr int kBlueNoiseSize = 64; ///< Width and height of the blue-noise tile.
+
+    void startPixelSample(int x, int y, uint32_t index) override;
+    ld get1D() override;
+    Sample2D get2D() override;
+    std::unique_ptr<Sampler> clone() const override;
+
+    /**
+     * @brief Gets the value of the blue-noise tile at (x, y), wrapping around; the tile holds
+     * each of the kBlueNoiseSize^2 values (rank + 0.5) / kBlueNoiseSize^2 once.
+     */
+    static float blueNoise(int x, int y);
+
+  private:
+    uint32_t sample(int dimension) const;
+
+    int x_ = 0;
+    int y_ = 0;
+    uint32_t index_ = 0;
+    int dimension_ = 0;
+};
+
+} // namespace Prism
+
+#endif // PRISM_SAMPLER_HPP_
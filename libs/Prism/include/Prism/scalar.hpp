@@ -0,0 +1,26 @@
+#ifndef PRISM_SCALAR_HPP_
+#define PRISM_SCALAR_HPP_
+
+#include "prism_config.h"
+
+/**
+ * @file scalar.hpp
+ * @brief Defines the floating point type used by the whole Prism math core.
+ *
+ * The type is chosen when the library is configured, with the PRISM_PRECISION CMake option
+ * (FLOAT, DOUBLE or LONG_DOUBLE). Code linking against Prism must use the same configuration.
+ */
+
+namespace Prism {
+
+#if defined(PRISM_PRECISION_FLOAT)
+using ld = float;
+#elif defined(PRISM_PRECISION_DOUBLE)
+using ld = double;
+#else
+using ld = long double;
+#endif
+
+} // namespace Prism
+
+#endif // PRISM_SCALAR_HPP_
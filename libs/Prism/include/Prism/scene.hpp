@@ -0,0 +1,102 @@
+#ifndef PRISM_SCENE_HPP_
+#define PRISM_SCENE_HPP_
+
+#include "Prism/bvh.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/ray_packet.hpp"
+#include "Prism/scalar.hpp"
+#include "prism_export.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Prism {
+
+/**
+ * @class Scene
+ * @brief Collection of objects traced through a bounding volume hierarchy.
+ *
+ * Objects are not owned by the scene. After adding or moving objects, build() must be called
+ * again before tracing. With Instance objects the scene is the top level of a two-level
+ * structure: build() only rebuilds the hierarchy over the instances, never the geometry below.
+ */
+class PRISM_EXPORT Scene {
+  public:
+    /**
+     * @brief Constructs an empty scene.
+     */
+    Scene() = default;
+
+    /**
+     * @brief Constructs a scene from a list of objects and builds its hierarchy.
+     * @param objects The objects within the scene.
+     */
+    explicit Scene(const std::vector<Object*>& objects);
+
+    /**
+     * @brief Adds an object to the scene. Takes effect on the next call to build().
+     * @param object The object to add.
+     */
+    void add(Object* object);
+
+    /**
+     * @brief Builds the acceleration structure over the current objects.
+     */
+    void build();
+
+    /**
+     * @brief Checks whether the scene was built after the last change.
+     */
+    bool isBuilt() const {
+        return bvh_ != nullptr;
+    }
+
+    /**
+     * @brief Finds the closest intersection of a ray with the scene.
+     * @param ray The ray to trace.
+     * @param t_min The minimum distance for a valid hit.
+     * @param t_max The maximum distance for a valid hit.
+     * @param rec The hit record to be filled with the closest hit.
+     * @return True if a valid hit was found, false otherwise.
+     * @throws std::logic_error if the scene has not been built.
+     */
+    bool hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const;
+
+    /**
+     * @brief Finds the closest intersection of every ray of a packet with the scene.
+     * @param packet The rays to trace, e.g. from Camera::getPacket.
+     * @param t_min The minimum distance for a valid hit.
+     * @param t_max The maximum distance for a valid hit.
+     * @param hits Filled with the closest hit of every active lane.
+     * @throws std::logic_error if the scene has not been built.
+     */
+    void hit(const RayPacket& packet, ld t_min, ld t_max, PacketHit& hits) const;
+
+    /**
+     * @brief Checks whether anything in the scene blocks a ray, e.g. a shadow ray towards a
+     * light. Stops at the first blocker found instead of looking for the closest hit, and is
+     * counted and timed apart from hit() (see StatStage::Occlusion).
+     * @param ray The ray to trace.
+     * @param t_min The minimum distance for a blocking hit.
+     * @param t_max The maximum distance for a blocking hit, e.g. the distance to the light.
+     * @return True if the ray is blocked.
+     * @throws std::logic_error if the scene has not been built.
+     */
+    bool occluded(const Ray& ray, ld t_min, ld t_max) const;
+
+    /**
+     * @brief Gets the objects within the scene.
+     */
+    const std::vector<Object*>& objects() const {
+        return objects_;
+    }
+
+  private:
+    std::vector<Object*> objects_;
+    std::unique_ptr<BVH> bvh_;
+};
+
+} // namespace Prism
+
+#endif // PRISM_SCENE_HPP_
@@ -0,0 +1,133 @@
+#ifndef PRISM_SHADOW_QUEUE_HPP_
+#define PRISM_SHADOW_QUEUE_HPP_
+
+#include "Prism/aabb.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/scalar.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Prism {
+
+/**
+ * @struct ShadowRay
+ * @brief A deferred occlusion query and what it brings to its pixel if nothing blocks it.
+ */
+struct PRISM_EXPORT ShadowRay {
+    Ray ray;
+    ld t_min;             ///< The minimum distance for a blocking hit.
+    ld t_max;             ///< The maximum distance for a blocking hit, e.g. the light distance.
+    Vector3 contribution; ///< Light reaching the pixel when the ray is not blocked.
+    uint32_t pixel;       ///< The receiving pixel, as set by ShadowQueue::setPixel().
+};
+
+/**
+ * @class ShadowQueue
+ * @brief Stream of shadow rays traced in sorted batches instead of one at a time.
+ *
+ * Shaders push the shadow rays of a hit instead of tracing them, and the queue traces the
+ * whole batch later, sorted by direction octant and then by the Morton code of the origin.
+ * Rays that go the same way from nearby points then follow each other through the same BVH
+ * nodes, which stay in cache, as in a wavefront renderer. Queues are meant to be owned by one
+ * thread; keeping one per thread lets the buffers be reused from batch to batch.
+ */
+class PRISM_EXPORT ShadowQueue {
+  public:
+    /**
+     * @brief Number of bits of each origin coordinate in the sort key.
+     */
+    static constexpr int kMortonBits = 20;
+
+    /**
+     * @brief Sets the pixel tagged on the rays pushed from now on.
+     */
+    void setPixel(uint32_t pixel) {
+        pixel_ = pixel;
+    }
+
+    uint32_t pixel() const {
+        return pixel_;
+    }
+
+    /**
+     * @brief Queues a shadow ray for the current pixel.
+     * @param ray The ray, from the shaded point towards the light.
+     * @param t_min The minimum distance for a blocking hit.
+     * @param t_max The maximum distance for a blocking hit, e.g. the distance to the light.
+     * @param contribution Light the pixel receives if nothing blocks the ray.
+     */
+    void push(const Ray& ray, ld t_min, ld t_max, const Vector3& contribution) {
+        rays_.push_back(ShadowRay{ray, t_min, t_max, contribution, pixel_});
+    }
+
+    const std::vector<ShadowRay>& rays() const {
+        return rays_;
+    }
+
+    size_t size() const {
+        return rays_.size();
+    }
+
+    bool empty() const {
+        return rays_.empty();
+    }
+
+    /**
+     * @brief Drops the queued rays, keeping the buffers.
+     */
+    void clear() {
+        rays_.clear();
+    }
+
+    /**
+     * @brief Computes the sort key of a ray: the octant of its direction in the top 3 bits,
+     * then the Morton code of its origin quantized on a 2^kMortonBits grid over the box.
+     */
+    static uint64_t sortKey(const Ray& ray, const AABB& origins);
+
+    /**
+     * @brief Sorts the queued rays by sortKey(), over the box of the queued origins. Rays
+     * with equal keys keep the order they were pushed in, so the result is deterministic.
+     */
+    void sort();
+
+    /**
+     * @brief Sorts and traces every queued ray, then empties the queue.
+     * @param scene The built scene the rays are traced through (see Scene::occluded).
+     * @param on_visible Called as on_visible(shadow_ray) for every ray that nothing blocks,
+     * in sorted order.
+     * @return The number of blocked rays.
+     * @throws std::logic_error if the scene has not been built.
+     */
+    template <typename OnVisible> size_t trace(const Scene& scene, OnVisible&& on_visible);
+
+  private:
+    std::vector<ShadowRay> rays_;
+    std::vector<ShadowRay> sorted_;                   ///< Scratch buffer of sort().
+    std::vector<std::pair<uint64_t, uint32_t>> keys_; ///< Scratch buffer of sort().
+    uint32_t pixel_ = 0;
+};
+
+template <typename OnVisible>
+size_t ShadowQueue::trace(const Scene& scene, OnVisible&& on_visible) {
+    sort();
+    size_t blocked = 0;
+    for (const ShadowRay& shadow : rays_) {
+        if (scene.occluded(shadow.ray, shadow.t_min, shadow.t_max)) {
+            ++blocked;
+        } else {
+            on_visible(shadow);
+        }
+    }
+    clear();
+    return blocked;
+}
+
+} // namespace Prism
+
+#endif // PRISM_SHADOW_QUEUE_HPP_
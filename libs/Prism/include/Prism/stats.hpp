@@ -0,0 +1,197 @@
+#ifndef PRISM_STATS_HPP_
+#define PRISM_STATS_HPP_
+
+#include "prism_config.h"
+#include "prism_export.h"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace Prism {
+
+/**
+ * @brief Events counted by the render statistics.
+ */
+enum class StatCounter {
+    CameraRays,     ///< Primary rays generated by Camera.
+    ObjectTests,    ///< Calls to Object::hit or Object::hitPacket made by the acceleration
+                    ///< structures.
+    BVHNodes,       ///< BVH nodes tested by closest-hit queries, in scenes and meshes alike.
+    SceneHits,      ///< Scene closest-hit queries that found a hit, per ray.
+    SceneMisses,    ///< Scene closest-hit queries that found nothing, per ray.
+    OcclusionTests, ///< Calls to Object::occluded made by the acceleration structures.
+    OcclusionNodes, ///< BVH nodes tested by occlusion queries, in scenes and meshes alike.
+    OccludedRays,   ///< Scene occlusion queries that found a blocker.
+    UnoccludedRays, ///< Scene occlusion queries that found nothing.
+};
+constexpr int kStatCounterCount = 9;
+
+/**
+ * @brief Stages whose time is measured by the render statistics.
+ */
+enum class StatStage {
+    Load,      ///< Parsing OBJ data and opening mesh caches.
+    Build,     ///< Building scene and mesh hierarchies.
+    Trace,     ///< Scene closest-hit queries.
+    Occlusion, ///< Scene occlusion queries.
+    Shade,     ///< Renderer shader calls, including the rays they trace.
+    Write,     ///< Writing mesh caches and images.
+};
+constexpr int kStatStageCount = 6;
+
+/**
+ * @brief Whether Prism was configured with PRISM_ENABLE_STATS. When it was not, the library
+ * records nothing and all the hooks below compile to nothing.
+ */
+#ifdef PRISM_ENABLE_STATS
+constexpr bool kStatsEnabled = true;
+#else
+constexpr bool kStatsEnabled = false;
+#endif
+
+/**
+ * @struct StatsSnapshot
+ * @brief Totals of every counter and stage time over all threads.
+ *
+ * Stage times are summed over the threads that ran them, and a stage nested in another (Trace
+ * or Occlusion inside Shade) is also included in the outer one.
+ */
+struct PRISM_EXPORT StatsSnapshot {
+    uint64_t counters[kStatCounterCount] = {};        ///< Indexed by StatCounter.
+    uint64_t stage_nanoseconds[kStatStageCount] = {}; ///< Indexed by StatStage.
+
+    uint64_t counter(StatCounter counter) const {
+        return counters[static_cast<int>(counter)];
+    }
+
+    double seconds(StatStage stage) const {
+        return static_cast<double>(stage_nanoseconds[static_cast<int>(stage)]) * 1e-9;
+    }
+};
+
+/**
+ * @brief Adds to a counter of the calling thread. Cheap and lock-free after the first call on a
+ * thread.
+ */
+PRISM_EXPORT void addStat(StatCounter counter, uint64_t amount = 1);
+
+/**
+ * @brief Adds time to a stage of the calling thread.
+ */
+PRISM_EXPORT void addStageTime(StatStage stage, uint64_t nanoseconds);
+
+/**
+ * @brief Sums the statistics of every thread, including threads that already exited.
+ */
+PRISM_EXPORT StatsSnapshot statsSnapshot();
+
+/**
+ * @brief Clears the statistics of every thread. Meant to be called between runs; increments made
+ * concurrently may survive the reset.
+ */
+PRISM_EXPORT void resetStats();
+
+/**
+ * @brief Gets the name of a counter as used in the JSON summary, e.g. "camera_rays".
+ */
+PRISM_EXPORT const char* statCounterName(StatCounter counter);
+
+/**
+ * @brief Gets the name of a stage as used in the JSON summary, e.g. "trace".
+ */
+PRISM_EXPORT const char* statStageName(StatStage stage);
+
+/**
+ * @brief Writes a snapshot as a JSON object with "enabled", "counters" and "stage_seconds".
+ */
+PRISM_EXPORT void writeStatsJson(std::ostream& out, const StatsSnapshot& stats);
+
+#ifdef PRISM_ENABLE_STATS
+
+/**
+ * @class StatTally
+ * @brief Local counter for hot loops, added to the thread statistics once when destroyed.
+ */
+class StatTally {
+  public:
+    explicit StatTally(StatCounter counter) : counter_(counter) {
+    }
+
+    ~StatTally() {
+        if (count_ != 0) {
+            addStat(counter_, count_);
+        }
+    }
+
+    StatTally(const StatTally&) = delete;
+    StatTally& operator=(const StatTally&) = delete;
+
+    void add(uint64_t amount = 1) {
+        count_ += amount;
+    }
+
+  private:
+    StatCounter counter_;
+    uint64_t count_ = 0;
+};
+
+/**
+ * @class StageTimer
+ * @brief Adds the lifetime of the timer to a stage of the calling thread.
+ */
+class StageTimer {
+  public:
+    explicit StageTimer(StatStage stage)
+        : stage_(stage), start_(std::chrono::steady_clock::now()) {
+    }
+
+    ~StageTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        addStageTime(stage_, static_cast<uint64_t>(
+                                 std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                                     .count()));
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+  private:
+    StatStage stage_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#else
+
+// Without PRISM_ENABLE_STATS the hooks are empty and vanish from the optimized code.
+class StatTally {
+  public:
+    explicit StatTally(StatCounter) {
+    }
+
+    void add(uint64_t = 1) {
+    }
+};
+
+class StageTimer {
+  public:
+    explicit StageTimer(StatStage) {
+    }
+};
+
+#endif
+
+/**
+ * @brief Counts a single event, or does nothing without PRISM_ENABLE_STATS.
+ */
+inline void countStat(StatCounter counter, uint64_t amount = 1) {
+#ifdef PRISM_ENABLE_STATS
+    addStat(counter, amount);
+#else
+    (void)counter;
+    (void)amount;
+#endif
+}
+
+} // namespace Prism
+
+#endif // PRISM_STATS_HPP_
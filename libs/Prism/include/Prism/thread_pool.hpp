@@ -0,0 +1,81 @@
+#ifndef PRISM_THREAD_POOL_HPP_
+#define PRISM_THREAD_POOL_HPP_
+
+#include "prism_export.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Prism {
+
+/**
+ * @class ThreadPool
+ * @brief Fixed-size pool of worker threads with per-worker work-stealing queues.
+ *
+ * Every worker owns a queue: it pops its own work from the back and, when empty, steals from the
+ * front of the other queues. A thread waiting in parallelFor keeps executing queued tasks, so
+ * parallelFor may be called again from inside a task without deadlocking.
+ */
+class PRISM_EXPORT ThreadPool {
+  public:
+    /**
+     * @brief Starts the worker threads.
+     * @param thread_count Number of workers. 0 uses the number of hardware threads.
+     */
+    explicit ThreadPool(size_t thread_count = 0);
+
+    /**
+     * @brief Finishes the queued work and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Gets the number of worker threads.
+     */
+    size_t size() const {
+        return workers_.size();
+    }
+
+    /**
+     * @brief Runs body(i) for every i in [0, count) on the pool and waits for all of them.
+     * @param count Number of iterations.
+     * @param body The work for a single iteration. Iterations may run in any order.
+     * @throws Rethrows the first exception thrown by body, after every iteration has finished.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+  private:
+    struct Batch;
+    struct Task {
+        Batch* batch;
+        size_t index;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t queue_index);
+    bool tryPop(size_t queue_index, Task& task);
+    void run(const Task& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_; ///< One per worker, plus one for outside threads.
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> queued_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+};
+
+} // namespace Prism
+
+#endif // PRISM_THREAD_POOL_HPP_
@@ -0,0 +1,94 @@
+#ifndef PRISM_TRIANGLE_KERNEL_HPP_
+#define PRISM_TRIANGLE_KERNEL_HPP_
+
+#include "prism_export.h"
+#include <cstddef>
+
+namespace Prism {
+
+constexpr int kTriangleBlockWidth = 8; ///< Number of triangles in a TriangleBlock.
+
+/**
+ * @struct TriangleBlock
+ * @brief Eight triangles packed lane by lane for the vectorized intersection kernel.
+ *
+ * Every triangle is stored as its first vertex and two edge vectors, each coordinate in its own
+ * array. Unused lanes must hold zero edges: such degenerate triangles are never hit.
+ */
+struct alignas(32) TriangleBlock {
+    float v0[3][kTriangleBlockWidth]; ///< First vertex, x, y and z.
+    float e1[3][kTriangleBlockWidth]; ///< Second vertex minus the first.
+    float e2[3][kTriangleBlockWidth]; ///< Third vertex minus the first.
+
+    /**
+     * @brief Stores a triangle in a lane.
+     */
+    void set(int lane, const float* p0, const float* p1, const float* p2) {
+        for (int k = 0; k < 3; ++k) {
+            v0[k][lane] = p0[k];
+            e1[k][lane] = p1[k] - p0[k];
+            e2[k][lane] = p2[k] - p0[k];
+        }
+    }
+};
+
+/**
+ * @struct BlockRay
+ * @brief Single-precision copy of a ray, as consumed by the kernel.
+ */
+struct BlockRay {
+    float origin[3];
+    float direction[3];
+};
+
+/**
+ * @struct BlockHit
+ * @brief Closest hit found in a TriangleBlock.
+ */
+struct BlockHit {
+    float t; ///< Distance along the ray.
+    float u; ///< Barycentric coordinate of the second vertex.
+    float v; ///< Barycentric coordinate of the third vertex.
+};
+
+/**
+ * @brief Instruction sets the kernel can run on.
+ */
+enum class SimdLevel { Scalar, SSE4, AVX2 };
+
+/**
+ * @brief Gets the widest instruction set supported by this processor.
+ */
+PRISM_EXPORT SimdLevel detectSimdLevel();
+
+/**
+ * @brief Gets the instruction set used by intersectTriangleBlock. Defaults to detectSimdLevel().
+ */
+PRISM_EXPORT SimdLevel simdLevel();
+
+/**
+ * @brief Selects the instruction set used by intersectTriangleBlock, e.g. to compare kernels.
+ * @throws std::invalid_argument if the processor does not support it.
+ */
+PRISM_EXPORT void setSimdLevel(SimdLevel level);
+
+/**
+ * @brief Gets a printable name of an instruction set.
+ */
+PRISM_EXPORT const char* simdLevelName(SimdLevel level);
+
+/**
+ * @brief Tests a ray against the eight triangles of a block with Möller–Trumbore.
+ * @param block The triangles.
+ * @param ray The ray.
+ * @param t_min The minimum distance for a valid hit.
+ * @param t_max The maximum distance for a valid hit.
+ * @param hit Filled with the closest hit, if any.
+ * @return The lane of the closest triangle hit inside (t_min, t_max), or -1.
+ */
+PRISM_EXPORT int intersectTriangleBlock(const TriangleBlock& block, const BlockRay& ray,
+                                        float t_min, float t_max, BlockHit& hit);
+
+} // namespace Prism
+
+#endif // PRISM_TRIANGLE_KERNEL_HPP_
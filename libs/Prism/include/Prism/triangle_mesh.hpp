@@ -0,0 +1,131 @@
+#ifndef PRISM_TRIANGLE_MESH_HPP_
+#define PRISM_TRIANGLE_MESH_HPP_
+
+#include "Prism/aabb.hpp"
+#include "Prism/array_view.hpp"
+#include "Prism/bvh.hpp"
+#include "Prism/material.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/scalar.hpp"
+#include "Prism/triangle_kernel.hpp"
+#include "prism_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Prism {
+
+class MeshCache;
+
+/**
+ * @class TriangleMesh
+ * @brief Indexed triangle mesh with its own BVH, usable as a single scene object.
+ *
+ * Positions and normals are kept as separate x, y and z float arrays, triangles as three 32-bit
+ * vertex indices and materials as a 16-bit id into a shared MaterialTable. Triangles are stored
+ * in the leaf order of the BVH, so triangle i is not necessarily face i of the source mesh.
+ *
+ * The BVH is built so that leaves hold up to kTriangleBlockWidth triangles. A visited leaf is
+ * gathered from the shared vertices into a TriangleBlock on the stack and tested with the
+ * vectorized kernel of intersectTriangleBlock, so the packed copies are never stored.
+ */
+class PRISM_EXPORT TriangleMesh : public Object {
+  public:
+    /**
+     * @brief Copies a loaded mesh and builds its BVH.
+     * @param mesh The mesh to copy.
+     * @param materials Table that receives the mesh materials, or nullptr to ignore materials.
+     * The table is not owned and must outlive the mesh.
+     * @param bvh How to build the BVH. The leaf size and width are always kTriangleBlockWidth.
+     * @throws std::invalid_argument if an index refers to a missing vertex or normal.
+     */
+    explicit TriangleMesh(const MeshData& mesh, MaterialTable* materials = nullptr,
+                          const BVHBuildOptions& bvh = BVHBuildOptions());
+
+    /**
+     * @brief Copies a cached mesh and builds its BVH.
+     * @see TriangleMesh(const MeshData&, MaterialTable*, const BVHBuildOptions&)
+     */
+    explicit TriangleMesh(const MeshCache& mesh, MaterialTable* materials = nullptr,
+                          const BVHBuildOptions& bvh = BVHBuildOptions());
+
+    bool hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const override;
+
+    /**
+     * @brief Traverses the BVH once for the whole packet (see BVHTree::traversePacket) and
+     * tests the active lanes against the blocks of every visited leaf.
+     */
+    void hitPacket(const RayPacket& packet, ld t_min, PacketHit& hits) const override;
+
+    /**
+     * @brief Stops at the first block of triangles that blocks the ray, without building a
+     * hit record.
+     */
+    bool occluded(const Ray& ray, ld t_min, ld t_max) const override;
+
+    bool boundingBox(AABB& box) const override;
+
+    size_t vertexCount() const {
+        return x_.size();
+    }
+
+    size_t triangleCount() const {
+        return material_ids_.size();
+    }
+
+    /**
+     * @brief Gets the material id of a triangle, or MaterialTable::kNoMaterial.
+     */
+    uint16_t materialId(size_t triangle) const {
+        return material_ids_[triangle];
+    }
+
+    /**
+     * @brief Gets the number of bytes used by the vertex, index and material arrays. The BVH is
+     * not included (see tree()).
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * @brief Gets the BVH over the triangles.
+     */
+    const BVHTree& tree() const {
+        return tree_;
+    }
+
+  private:
+    struct Source {
+        ArrayView<float> positions;
+        ArrayView<float> normals;
+        ArrayView<uint32_t> indices;
+        ArrayView<uint32_t> normal_indices;
+        ArrayView<uint32_t> material_ids;
+        size_t material_count;
+        const MeshMaterial* materials;
+    };
+
+    void build(const Source& source, MaterialTable* materials, BVHBuildOptions bvh);
+
+    /**
+     * @brief Packs up to kTriangleBlockWidth consecutive triangles into a block. The remaining
+     * lanes get zero edges, so they are never hit.
+     */
+    void loadBlock(uint32_t first, uint32_t count, TriangleBlock& block) const;
+
+    void fillRecord(const Ray& ray, uint32_t triangle, const BlockHit& block_hit,
+                    HitRecord& rec) const;
+
+    std::vector<float> x_, y_, z_;         ///< Vertex positions.
+    std::vector<float> nx_, ny_, nz_;      ///< Vertex normals.
+    std::vector<uint32_t> indices_;        ///< Three vertex indices per triangle.
+    std::vector<uint32_t> normal_indices_; ///< Three normal indices per triangle, or empty.
+    std::vector<uint16_t> material_ids_;   ///< Material of every triangle.
+    const MaterialTable* materials_ = nullptr;
+    BVHTree tree_;
+};
+
+} // namespace Prism
+
+#endif // PRISM_TRIANGLE_MESH_HPP_
@@ -2,6 +2,7 @@
 #define PRISM_VECTOR_HPP_
 
 #include "prism_export.h"
+#include "Prism/scalar.hpp"
 #include <initializer_list>
 
 /**
@@ -11,8 +12,6 @@
 
 namespace Prism {
 
-using ld = long double;
-
 class Point3; // Forward declaration of Point3 class
 
 /**
@@ -36,7 +35,7 @@ class PRISM_EXPORT Vector3 {
      * @brief Copy constructor.
      * @param v The vector to copy from.
      */
-    Vector3(const Vector3& v);
+    Vector3(const Vector3& v) = default;
 
     /**
      * @brief Constructs a Vector from a Point3.
@@ -71,7 +70,7 @@ class PRISM_EXPORT Vector3 {
      * @param v The vector to assign from.
      * @return Reference to this vector.
      */
-    Vector3& operator=(const Vector3& v);
+    Vector3& operator=(const Vector3& v) = default;
 
     /**
      * @brief Adds two vectors.
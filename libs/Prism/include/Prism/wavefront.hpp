@@ -0,0 +1,220 @@
+#ifndef PRISM_WAVEFRONT_HPP_
+#define PRISM_WAVEFRONT_HPP_
+
+#include "Prism/material.hpp"
+#include "Prism/point.hpp"
+#include "Prism/sampler.hpp"
+#include "Prism/scalar.hpp"
+#include "Prism/thread_pool.hpp"
+#include "Prism/vector.hpp"
+#include "prism_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Prism {
+
+class Accumulator;
+class Camera;
+class Scene;
+
+/**
+ * @struct PointLight
+ * @brief Light emitted equally in every direction from a point, falling off with the square
+ * of the distance.
+ */
+struct PRISM_EXPORT PointLight {
+    Point3 position;
+    Vector3 intensity;
+};
+
+/**
+ * @struct WavefrontSettings
+ * @brief Controls the paths traced by WavefrontIntegrator.
+ */
+struct PRISM_EXPORT WavefrontSettings {
+    int max_depth = 4;         ///< Bounces after the primary hit; 0 only lights the primary hits.
+    int roulette_depth = 3;    ///< Depth from which paths are ended at random (Russian roulette).
+    ld ray_epsilon = ld(1e-3); ///< Offset keeping bounce and shadow rays off their surface.
+    Vector3 background;        ///< Radiance of rays leaving the scene.
+    Material default_material; ///< Used where a hit has no material. Only kd and ke are used.
+    size_t chunk_size = 4096;  ///< Paths handed to a worker at once.
+
+    WavefrontSettings() {
+        default_material.kd = Vector3(0.5, 0.5, 0.5);
+    }
+};
+
+/**
+ * @brief Stages of a WavefrontIntegrator pass, in the order they run.
+ */
+enum class WavefrontStage {
+    Generate,   ///< Primary rays of every pixel from the Camera.
+    Extend,     ///< Closest hit of every live path.
+    Shade,      ///< Emission, shadow rays and the next bounce of every hit.
+    Connect,    ///< Occlusion test of every shadow ray.
+    Accumulate, ///< Unblocked light into the pixels, and dead paths out of the buffers.
+};
+constexpr int kWavefrontStageCount = 5;
+
+/**
+ * @brief Gets the name of a stage, e.g. "extend".
+ */
+PRISM_EXPORT const char* wavefrontStageName(WavefrontStage stage);
+
+/**
+ * @struct WavefrontStats
+ * @brief Wall-clock time spent in each stage and rays traced, summed over passes.
+ *
+ * Unlike the library statistics (see stats.hpp) these are always recorded: each stage runs
+ * once per bounce over the whole frame, so timing it costs nothing measurable.
+ */
+struct PRISM_EXPORT WavefrontStats {
+    double stage_seconds[kWavefrontStageCount] = {}; ///< Indexed by WavefrontStage.
+    uint64_t extension_rays = 0;                     ///< Closest-hit queries.
+    uint64_t shadow_rays = 0;                        ///< Occlusion queries.
+
+    double seconds(WavefrontStage stage) const {
+        return stage_seconds[static_cast<int>(stage)];
+    }
+};
+
+/**
+ * @class WavefrontIntegrator
+ * @brief Path tracer that advances every path of the frame one stage at a time.
+ *
+ * Instead of following each path to its end before starting the next, a pass generates one path
+ * per pixel and then, for every bounce, runs each stage over all the live paths of the frame.
+ * The stages read and write structure-of-arrays buffers (one array per coordinate), so their
+ * loops are simple to vectorize, and each can be timed on its own (see stats()). Surfaces are
+ * Lambertian with the kd and ke of their material: paths gather emission where they hit, light
+ * from the point lights through shadow rays, and bounce in cosine-distributed directions.
+ *
+ * Like Renderer::renderPass, sample n of a pixel is drawn from the sampler positioned on that
+ * pixel and sample index n: the camera takes the first two dimensions, then each bounce takes
+ * three (direction and roulette). Passes thus give the same buffer whatever the number of
+ * threads.
+ */
+class PRISM_EXPORT WavefrontIntegrator {
+  public:
+    /**
+     * @brief Constructs an integrator with its own thread pool.
+     * @param thread_count Number of worker threads. 0 uses the number of hardware threads.
+     * @param settings The path settings.
+     * @throws std::invalid_argument if the settings are invalid (see setSettings()).
+     */
+    explicit WavefrontIntegrator(size_t thread_count = 0,
+                                 const WavefrontSettings& settings = WavefrontSettings());
+
+    /**
+     * @brief Adds one path sample to every pixel of an accumulation buffer.
+     * @param camera The camera generating the primary rays.
+     * @param scene The built scene the paths are traced through.
+     * @param accumulator The buffer receiving the samples, with the same size as the camera image.
+     * @throws std::invalid_argument if the buffer size differs from the camera image.
+     * @throws std::logic_error if the scene has not been built.
+     */
+    void renderPass(const Camera& camera, const Scene& scene, Accumulator& accumulator);
+
+    const WavefrontSettings& settings() const {
+        return settings_;
+    }
+
+    /**
+     * @brief Replaces the path settings.
+     * @throws std::invalid_argument if a depth or the epsilon is negative, or chunk_size is 0.
+     */
+    void setSettings(const WavefrontSettings& settings);
+
+    const std::vector<PointLight>& lights() const {
+        return lights_;
+    }
+
+    void setLights(const std::vector<PointLight>& lights) {
+        lights_ = lights;
+    }
+
+    /**
+     * @brief Gets the sampler the paths draw from. Defaults to a SobolSampler.
+     */
+    const Sampler& sampler() const {
+        return *sampler_;
+    }
+
+    /**
+     * @brief Replaces the sampler with a copy of the given one.
+     */
+    void setSampler(const Sampler& sampler) {
+        sampler_ = sampler.clone();
+    }
+
+    const WavefrontStats& stats() const {
+        return stats_;
+    }
+
+    void resetStats() {
+        stats_ = WavefrontStats();
+    }
+
+    size_t threadCount() const {
+        return pool_.size();
+    }
+
+  private:
+    // The state of the live paths, compacted after every bounce.
+    struct PathBuffer {
+        std::vector<ld> origin[3];
+        std::vector<ld> direction[3];
+        std::vector<ld> throughput[3];
+        std::vector<uint32_t> pixel;  ///< Pixel index, y * width + x.
+        std::vector<uint32_t> sample; ///< Sample index of the pixel.
+        size_t size = 0;
+
+        void resize(size_t n);
+    };
+
+    // The closest hit of every live path.
+    struct HitBuffer {
+        std::vector<uint8_t> hit;
+        std::vector<ld> point[3];
+        std::vector<ld> normal[3];
+        std::vector<const Material*> material;
+
+        void resize(size_t n);
+    };
+
+    // Shadow ray k of path i in slot i * lights + k.
+    struct ShadowBuffer {
+        std::vector<ld> direction[3];
+        std::vector<ld> distance;
+        std::vector<ld> contribution[3];
+        std::vector<uint8_t> state; ///< One of the kShadow* values of wavefront.cpp.
+
+        void resize(size_t n);
+    };
+
+    template <typename Body> void forChunks(size_t count, Body&& body);
+
+    void generate(const Camera& camera, const Accumulator& accumulator);
+    void extend(const Scene& scene);
+    void shade(int depth, int width);
+    void connect(const Scene& scene);
+    void accumulate(int depth);
+
+    ThreadPool pool_;
+    WavefrontSettings settings_;
+    std::vector<PointLight> lights_;
+    std::unique_ptr<Sampler> sampler_;
+    WavefrontStats stats_;
+
+    PathBuffer paths_;
+    HitBuffer hits_;
+    ShadowBuffer shadows_;
+    std::vector<uint8_t> alive_;
+    std::vector<ld> radiance_[3]; ///< Per pixel, for the current pass.
+};
+
+} // namespace Prism
+
+#endif // PRISM_WAVEFRONT_HPP_
@@ -0,0 +1,82 @@
+#include "Prism/aabb.hpp"
+#include "Prism/ray_packet.hpp"
+#include <limits>
+
+namespace Prism {
+
+AABB::AABB()
+    : min(std::numeric_limits<ld>::infinity(), std::numeric_limits<ld>::infinity(),
+          std::numeric_limits<ld>::infinity()),
+      max(-std::numeric_limits<ld>::infinity(), -std::numeric_limits<ld>::infinity(),
+          -std::numeric_limits<ld>::infinity()) {
+}
+
+AABB::AABB(const Point3& min, const Point3& max) : min(min), max(max) {
+}
+
+bool AABB::empty() const {
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+Point3 AABB::centroid() const {
+    return Point3((min.x + max.x) / 2, (min.y + max.y) / 2, (min.z + max.z) / 2);
+}
+
+ld AABB::surfaceArea() const {
+    if (empty()) {
+        return 0;
+    }
+    ld dx = max.x - min.x;
+    ld dy = max.y - min.y;
+    ld dz = max.z - min.z;
+    return 2 * (dx * dy + dy * dz + dz * dx);
+}
+
+int AABB::longestAxis() const {
+    ld dx = max.x - min.x;
+    ld dy = max.y - min.y;
+    ld dz = max.z - min.z;
+    if (dx >= dy && dx >= dz) {
+        return 0;
+    }
+    return dy >= dz ? 1 : 2;
+}
+
+int AABB::hitAny(const RayPacket& packet, ld t_min, const ld* t_max, int first) const {
+    // Coherent packets mostly agree, so the lane that overlapped the parent usually decides.
+    if (packet.active[first]) {
+        const Point3 origin(packet.origin[0][first], packet.origin[1][first],
+                            packet.origin[2][first]);
+        const Vector3 inv_dir(packet.inv_direction[0][first], packet.inv_direction[1][first],
+                              packet.inv_direction[2][first]);
+        if (hit(origin, inv_dir, t_min, t_max[first])) {
+            return first;
+        }
+    }
+
+    // Otherwise test every lane without branches, so the loop can be vectorized.
+    const ld lo[3] = {min.x, min.y, min.z};
+    const ld hi[3] = {max.x, max.y, max.z};
+    bool overlap[RayPacket::kSize];
+    for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+        ld t_near = t_min;
+        ld t_far = t_max[lane];
+        for (int k = 0; k < 3; ++k) {
+            const ld t0 = (lo[k] - packet.origin[k][lane]) * packet.inv_direction[k][lane];
+            const ld t1 = (hi[k] - packet.origin[k][lane]) * packet.inv_direction[k][lane];
+            const ld entry = t0 < t1 ? t0 : t1;
+            const ld exit = t0 < t1 ? t1 : t0;
+            t_near = entry > t_near ? entry : t_near;
+            t_far = exit < t_far ? exit : t_far;
+        }
+        overlap[lane] = packet.active[lane] && t_near <= t_far;
+    }
+    for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+        if (overlap[lane]) {
+            return lane;
+        }
+    }
+    return -1;
+}
+
+} // namespace Prism
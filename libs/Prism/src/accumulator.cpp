@@ -0,0 +1,157 @@
+#include "Prism/accumulator.hpp"
+#include "Prism/stats.hpp"
+#include "replace_file.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Prism {
+
+namespace {
+
+constexpr char kMagic[8] = {'P', 'R', 'I', 'S', 'M', 'A', 'C', 'C'};
+constexpr uint32_t kByteOrder = 0x01020304;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t width;
+    uint32_t height;
+};
+
+static_assert(std::is_trivially_copyable<Header>::value, "The header is written as is");
+
+[[noreturn]] void corrupt(const std::string& path, const char* what) {
+    throw std::runtime_error("Invalid accumulation buffer " + path + ": " + what);
+}
+
+} // namespace
+
+Accumulator::Accumulator(int width, int height) : width_(width), height_(height) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Image dimensions must be greater than zero.");
+    }
+    sums_.assign(static_cast<size_t>(width) * height * 3, 0.0f);
+    squares_.assign(static_cast<size_t>(width) * height, 0.0f);
+    counts_.assign(static_cast<size_t>(width) * height, 0);
+}
+
+Vector3 Accumulator::mean(int x, int y) const {
+    const size_t i = index(x, y);
+    if (counts_[i] == 0) {
+        return Vector3(0, 0, 0);
+    }
+    const ld inv = ld(1) / counts_[i];
+    return Vector3(sums_[3 * i] * inv, sums_[3 * i + 1] * inv, sums_[3 * i + 2] * inv);
+}
+
+ld Accumulator::variance(int x, int y) const {
+    const size_t i = index(x, y);
+    const uint32_t n = counts_[i];
+    if (n < 2) {
+        return 0;
+    }
+    const ld inv = ld(1) / n;
+    const ld mean = luminance(Vector3(sums_[3 * i] * inv, sums_[3 * i + 1] * inv,
+                                      sums_[3 * i + 2] * inv));
+    // Single-precision sums can leave a slightly negative difference for constant pixels.
+    return std::max(ld(0), (squares_[i] - n * mean * mean) / (n - 1));
+}
+
+ld Accumulator::standardError(int x, int y) const {
+    const uint32_t n = samples(x, y);
+    return n == 0 ? 0 : std::sqrt(variance(x, y) / n);
+}
+
+uint64_t Accumulator::totalSamples() const {
+    return std::accumulate(counts_.begin(), counts_.end(), uint64_t(0));
+}
+
+Image Accumulator::resolve() const {
+    Image image(width_, height_);
+    for (int y = 0; y < height_; ++y) {
+        for (int x = 0; x < width_; ++x) {
+            image.pixel(x, y) = mean(x, y);
+        }
+    }
+    return image;
+}
+
+void Accumulator::save(const std::string& path) const {
+    StageTimer timer(StatStage::Write);
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byte_order = kByteOrder;
+    header.width = static_cast<uint32_t>(width_);
+    header.height = static_cast<uint32_t>(height_);
+
+    // Write next to the target and rename, so an interrupted save keeps the previous buffer.
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Could not write accumulation buffer: " + path);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(sums_.data()), sums_.size() * sizeof(float));
+        out.write(reinterpret_cast<const char*>(squares_.data()),
+                  squares_.size() * sizeof(float));
+        out.write(reinterpret_cast<const char*>(counts_.data()),
+                  counts_.size() * sizeof(uint32_t));
+        if (!out.flush()) {
+            out.close();
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Could not write accumulation buffer: " + path);
+        }
+    }
+    if (!replaceFile(temporary, path)) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Could not write accumulation buffer: " + path);
+    }
+}
+
+Accumulator Accumulator::load(const std::string& path) {
+    StageTimer timer(StatStage::Load);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Could not read accumulation buffer: " + path);
+    }
+
+    Header header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        corrupt(path, "file is too small");
+    }
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        corrupt(path, "bad magic");
+    }
+    if (header.version != kVersion) {
+        corrupt(path, "unsupported version");
+    }
+    if (header.byte_order != kByteOrder) {
+        corrupt(path, "written with another byte order");
+    }
+    if (header.width == 0 || header.height == 0 || header.width > 1u << 20 ||
+        header.height > 1u << 20) {
+        corrupt(path, "bad dimensions");
+    }
+
+    Accumulator buffer(static_cast<int>(header.width), static_cast<int>(header.height));
+    in.read(reinterpret_cast<char*>(buffer.sums_.data()), buffer.sums_.size() * sizeof(float));
+    in.read(reinterpret_cast<char*>(buffer.squares_.data()),
+            buffer.squares_.size() * sizeof(float));
+    in.read(reinterpret_cast<char*>(buffer.counts_.data()),
+            buffer.counts_.size() * sizeof(uint32_t));
+    if (!in || in.peek() != std::char_traits<char>::eof()) {
+        corrupt(path, "size does not match the dimensions");
+    }
+    return buffer;
+}
+
+} // namespace Prism
@@ -0,0 +1,269 @@
+#ifndef PRISM_BLUE_NOISE_HPP_
+#define PRISM_BLUE_NOISE_HPP_
+
+#include <cstdint>
+
+namespace Prism {
+
+constexpr int kBlueNoiseTileSize = 64;
+
+/**
+ * @brief Ranks of the pixels of a 64x64 toroidal blue-noise tile, row by row.
+ *
+ * Computed offline by void-and-cluster (Ulichney 1993) with a Gaussian filter of sigma 1.5;
+ * tests/sampler.cpp holds the generator and checks it still gives this table.
+ */
+constexpr uint16_t kBlueNoiseRanks[kBlueNoiseTileSize * kBlueNoiseTileSize] = {
+    2324, 887, 3569, 2812, 162, 3022, 696, 1891, 4056, 508, 3506, 2440, 129, 3669, 2200, 3378, 1054,
+    2777, 1865, 851, 53, 2646, 723, 2339, 203, 3157, 1860, 120, 4095, 997, 3409, 305, 902, 3561,
+    2562, 655, 1526, 2315, 1227, 554, 1991, 2798, 831, 468, 1357, 2964, 2454, 1123, 3176, 2119,
+    3892, 1053, 1718, 105, 1419, 2596, 3341, 2846, 1574, 3891, 2614, 879, 2742, 275, 3924, 1452,
+    2449, 1143, 2042, 1487, 3633, 280, 3195, 1713, 837, 1950, 2855, 1297, 384, 2496, 617, 1433,
+    3131, 2265, 3741, 1911, 1321, 3850, 1078, 2544, 664, 1356, 2653, 499, 1897, 3124, 1617, 2892,
+    410, 2162, 3070, 3828, 1740, 932, 3397, 135, 2249, 3204, 3767, 1723, 700, 4039, 383, 2745, 233,
+    2410, 3210, 4087, 2228, 1832, 631, 980, 2100, 449, 3212, 1305, 3494, 1688, 2821, 36, 3392, 577,
+    3958, 877, 2387, 2764, 1165, 2283, 3065, 3938, 682, 1792, 3853, 2956, 1683, 3944, 274, 1178,
+    2885, 3460, 394, 3305, 2808, 2009, 3795, 3233, 2234, 3651, 1220, 2443, 54, 4011, 1422, 3487,
+    816, 250, 2713, 3625, 2451, 1292, 3943, 1049, 2514, 71, 3358, 2302, 1576, 3075, 1311, 1907, 555,
+    935, 2891, 264, 3858, 2423, 3448, 1120, 1841, 179, 2120, 732, 1244, 2184, 2966, 1749, 2587,
+    3255, 446, 1603, 3779, 66, 1402, 427, 2695, 3353, 972, 27, 2091, 3568, 2598, 580, 1620, 957,
+    2193, 1719, 847, 418, 1583, 961, 260, 2998, 734, 3772, 2087, 1024, 2627, 1915, 1173, 3240, 2031,
+    434, 1612, 2927, 1867, 602, 2823, 1261, 1949, 979, 3541, 738, 3769, 2551, 3429, 1577, 3601,
+    1219, 3161, 1672, 3, 2803, 4046, 2466, 3104, 3599, 1868, 3852, 984, 315, 3549, 1251, 1901, 3012,
+    942, 3380, 2561, 3590, 2163, 1520, 2407, 3168, 1262, 810, 1834, 3279, 4065, 2455, 125, 3072,
+    3905, 2304, 2880, 3527, 2056, 1694, 2680, 1385, 3387, 600, 3087, 148, 3936, 2435, 1409, 3879,
+    706, 3330, 282, 3566, 2132, 3903, 3015, 254, 2631, 2081, 9, 1111, 3010, 361, 2349, 1940, 546,
+    2639, 1347, 3545, 568, 1523, 1004, 426, 2717, 669, 3198, 1440, 2155, 97, 4023, 2257, 591, 2041,
+    1721, 796, 1130, 252, 3665, 558, 2760, 3431, 2322, 319, 1241, 2773, 3672, 621, 1362, 3444, 16,
+    1287, 3968, 505, 3226, 208, 1794, 2372, 3609, 1671, 2845, 332, 920, 2977, 2321, 1127, 2649,
+    1467, 849, 416, 1653, 3700, 1416, 3258, 1802, 3959, 2164, 836, 2750, 4006, 955, 3733, 2230, 828,
+    2019, 2865, 3790, 2299, 115, 1605, 2375, 3705, 2882, 764, 3158, 1112, 2707, 3877, 340, 3219,
+    4031, 3006, 1998, 1658, 3962, 153, 1437, 3099, 2077, 799, 1541, 2004, 2643, 1064, 1904, 2560,
+    775, 2272, 1113, 3880, 2980, 906, 1300, 534, 2198, 3740, 1820, 3402, 44, 2062, 4089, 3207, 2421,
+    3464, 2755, 636, 2344, 897, 2787, 540, 1319, 3516, 99, 1489, 2903, 230, 3315, 1726, 3150, 210,
+    1328, 3411, 3042, 4069, 1155, 431, 1795, 2532, 1553, 3415, 207, 1432, 2849, 2336, 1330, 2603,
+    740, 1091, 2178, 2567, 970, 3867, 488, 3564, 3020, 214, 3997, 3186, 353, 3389, 2843, 3614, 1509,
+    2504, 390, 1978, 4062, 3127, 1506, 684, 2739, 1317, 3677, 1707, 746, 217, 1825, 1034, 2057,
+    1283, 3883, 289, 3555, 1626, 3084, 2501, 1758, 3256, 2114, 1233, 2509, 411, 3975, 2616, 864,
+    1799, 2181, 741, 2793, 3484, 1021, 3866, 479, 2378, 1857, 3548, 1022, 567, 1764, 94, 3802, 3329,
+    445, 3554, 1564, 2791, 1779, 2427, 988, 2218, 1692, 863, 2388, 1342, 1745, 132, 2076, 704, 3574,
+    2690, 10, 2429, 1087, 3254, 2292, 436, 964, 2502, 2862, 1371, 3023, 3950, 124, 3354, 2922, 1885,
+    1132, 2274, 265, 3678, 1003, 497, 3836, 697, 3572, 1558, 1100, 2093, 3716, 486, 3303, 1309,
+    1977, 285, 3214, 2086, 1322, 3731, 688, 3086, 2171, 3711, 3293, 2080, 2780, 1250, 3036, 1941,
+    610, 3274, 76, 1278, 3382, 3789, 574, 2928, 3688, 447, 4022, 989, 3333, 2915, 1634, 1012, 3421,
+    1807, 3820, 232, 3576, 1908, 3148, 3849, 375, 3542, 2244, 548, 2624, 1572, 592, 2470, 3218,
+    4058, 756, 1955, 2933, 2291, 1439, 2688, 2008, 3026, 648, 3466, 1447, 2539, 181, 3794, 2411,
+    1524, 2609, 139, 2924, 971, 2566, 47, 1593, 2662, 333, 933, 1499, 2367, 209, 4050, 922, 2253,
+    3747, 2668, 430, 1474, 2588, 1122, 1873, 2208, 3056, 2607, 502, 3864, 1304, 2224, 474, 2837,
+    790, 1610, 2580, 588, 1480, 2085, 1116, 1684, 795, 3660, 1238, 2149, 3804, 967, 67, 1512, 2765,
+    1266, 3910, 327, 3469, 927, 248, 3873, 2390, 57, 2850, 1040, 1676, 2940, 538, 3647, 905, 3945,
+    1704, 3351, 2002, 4070, 785, 1282, 3827, 2917, 3520, 686, 1769, 2499, 2946, 1398, 1968, 848,
+    3050, 2079, 3265, 284, 3407, 717, 1573, 1188, 1920, 2391, 158, 3264, 3978, 1360, 2128, 3059,
+    1160, 4030, 2824, 147, 3364, 2706, 3189, 1914, 2871, 312, 3292, 1760, 2985, 2175, 3462, 573,
+    2448, 1625, 3068, 1870, 2827, 1243, 1748, 3187, 1951, 3986, 750, 3445, 1222, 1829, 3167, 629,
+    2337, 407, 1171, 2961, 3405, 1797, 2245, 489, 1933, 3882, 3155, 1079, 293, 3631, 544, 3915,
+    1623, 157, 4071, 1325, 2360, 3845, 46, 3592, 3227, 850, 2776, 1869, 687, 2538, 3597, 79, 3337,
+    2269, 832, 3691, 2355, 481, 1453, 4, 4017, 1068, 2553, 709, 3746, 1121, 242, 1844, 3287, 1081,
+    1, 3760, 2215, 535, 3412, 958, 465, 2325, 2633, 2067, 308, 2741, 2172, 1405, 2835, 3570, 1554,
+    561, 2379, 211, 3133, 1142, 2611, 106, 1420, 3474, 1712, 2595, 3184, 1182, 2817, 2416, 676,
+    1801, 2802, 910, 2958, 2495, 307, 1677, 3735, 1232, 3033, 294, 1689, 1005, 1939, 405, 1435,
+    1836, 1071, 3887, 2542, 913, 2267, 3496, 1445, 2023, 462, 2305, 3939, 2703, 762, 3637, 2591,
+    1413, 822, 4072, 1546, 2684, 3671, 1382, 3765, 1061, 3248, 4051, 15, 1001, 3800, 194, 2134,
+    2702, 3701, 861, 3980, 1616, 3373, 884, 2307, 2789, 727, 2151, 26, 1838, 3495, 981, 3147, 3656,
+    355, 1656, 2063, 1341, 3956, 2268, 514, 3473, 939, 2331, 3920, 2705, 3761, 2979, 2519, 3260,
+    660, 2011, 3452, 3013, 1805, 380, 3126, 2746, 3535, 1566, 3151, 1333, 2094, 1685, 469, 3259,
+    2936, 2431, 401, 2050, 3109, 199, 2902, 545, 1513, 2351, 1724, 3345, 2546, 1821, 3222, 1050,
+    1415, 1945, 2543, 623, 2930, 2054, 3757, 453, 3954, 1048, 3588, 2297, 450, 1472, 2021, 2524,
+    1172, 3521, 3182, 620, 1026, 2910, 1438, 2590, 1947, 3232, 472, 1484, 698, 1202, 3577, 91, 2881,
+    1263, 240, 1531, 694, 3768, 1256, 138, 974, 2497, 658, 104, 2912, 3992, 2295, 1163, 1905, 154,
+    3600, 1201, 791, 1706, 1963, 2487, 3607, 798, 2978, 441, 1268, 773, 4015, 303, 3058, 3437, 8,
+    1302, 3578, 337, 1747, 1277, 3120, 1592, 2934, 771, 3830, 2699, 98, 3937, 585, 2203, 215, 3684,
+    1921, 3326, 357, 4078, 145, 1264, 2139, 3454, 2414, 302, 2065, 1540, 3729, 2237, 3999, 2687,
+    3352, 2340, 1981, 4073, 2970, 1917, 3811, 3310, 1043, 321, 3510, 662, 3841, 1631, 2767, 3360,
+    2381, 3966, 947, 3146, 266, 1179, 3819, 1961, 3526, 2255, 1510, 2801, 656, 2186, 3815, 1813,
+    2405, 1092, 3283, 2630, 2036, 220, 2531, 1303, 3173, 1730, 938, 3314, 1410, 2993, 2481, 1542,
+    2711, 776, 2213, 1657, 3587, 2753, 812, 3002, 1703, 4032, 3156, 941, 2581, 475, 844, 1895, 1129,
+    524, 2644, 780, 1469, 360, 1200, 2209, 2679, 1948, 1425, 2460, 3118, 903, 2183, 611, 1461, 77,
+    3433, 1351, 1822, 2277, 2678, 681, 2860, 170, 3657, 2424, 1668, 994, 2968, 435, 2770, 4014, 166,
+    854, 3619, 632, 4057, 2117, 270, 3642, 2369, 2826, 1854, 801, 4027, 1157, 37, 3838, 3101, 1041,
+    605, 1817, 3854, 58, 1027, 2718, 562, 1777, 3385, 1316, 2831, 3221, 63, 3539, 1698, 3114, 3446,
+    2428, 3652, 1575, 817, 3417, 2953, 72, 1124, 3692, 423, 3064, 3648, 2730, 373, 2568, 4003, 3276,
+    93, 1429, 3163, 1783, 1126, 460, 3909, 3229, 1470, 772, 2084, 1586, 3055, 2365, 1353, 3334,
+    1708, 1075, 2925, 690, 1257, 297, 3540, 439, 1994, 3384, 2361, 1800, 1318, 2848, 2486, 3339,
+    1335, 2358, 3661, 1389, 2248, 3894, 163, 2018, 3686, 1500, 2417, 3847, 1312, 195, 2070, 675,
+    2886, 178, 3907, 549, 1716, 4044, 2115, 1519, 2556, 1859, 1108, 2135, 3699, 871, 552, 1633,
+    1035, 3886, 2442, 840, 3309, 2692, 1953, 204, 2540, 3776, 3367, 1042, 541, 3863, 1894, 2779,
+    377, 2489, 3436, 1913, 3990, 2195, 1494, 3095, 995, 2898, 670, 3644, 412, 3511, 213, 2090, 494,
+    3138, 1925, 359, 2879, 856, 3071, 2463, 346, 728, 2951, 2147, 888, 2816, 3949, 1128, 1790, 3244,
+    2310, 1229, 2589, 369, 2828, 3281, 175, 3976, 672, 1550, 3037, 1882, 2820, 2225, 3479, 2010,
+    406, 3712, 2109, 1394, 735, 3534, 1208, 1880, 69, 2864, 2227, 1146, 122, 3179, 917, 3806, 1367,
+    34, 2784, 876, 2572, 3658, 2236, 268, 1511, 2655, 2053, 874, 1545, 4000, 963, 2661, 724, 3416,
+    1568, 3585, 1205, 1690, 3823, 1090, 1819, 386, 3346, 1733, 484, 3560, 2545, 929, 1987, 3130,
+    3622, 1006, 1804, 774, 1349, 2876, 3404, 2433, 7, 3817, 1189, 276, 2992, 711, 1601, 2844, 45,
+    3988, 2918, 2262, 3079, 583, 2461, 3629, 1725, 3456, 2534, 1460, 2146, 537, 2345, 3290, 1636,
+    3763, 168, 1212, 1772, 3793, 3291, 1084, 3921, 2954, 2287, 3230, 1759, 3725, 1216, 2527, 84,
+    2033, 518, 2708, 3377, 2279, 3145, 4037, 1237, 2682, 2238, 1430, 350, 3835, 112, 1448, 622,
+    2418, 3457, 3860, 2308, 1976, 335, 1073, 2108, 1476, 3376, 2364, 4079, 1320, 2517, 3501, 1167,
+    1796, 448, 1016, 1632, 4080, 1345, 896, 314, 2939, 729, 3987, 3523, 1812, 3053, 1085, 647, 2047,
+    3152, 519, 2822, 733, 2377, 123, 1728, 607, 1186, 6, 2800, 329, 2188, 4081, 2994, 2406, 3900,
+    901, 136, 1392, 641, 2488, 0, 3491, 657, 2983, 3327, 1696, 2670, 3739, 2976, 2051, 49, 1214,
+    517, 3589, 1619, 3199, 693, 2550, 443, 956, 1757, 149, 3228, 904, 2239, 2636, 3280, 3732, 262,
+    2758, 3263, 2110, 3818, 1543, 2012, 251, 1191, 2810, 356, 3960, 2654, 3504, 1446, 2511, 4063,
+    1340, 1972, 3088, 2617, 3443, 3758, 2444, 1424, 3558, 1648, 918, 597, 1329, 1789, 3241, 2107,
+    3626, 2792, 1621, 1969, 950, 3902, 2061, 1176, 788, 2256, 414, 1094, 1614, 2731, 3140, 2467,
+    928, 2669, 3994, 2943, 3583, 1982, 3113, 2606, 3697, 2034, 347, 3807, 677, 1365, 2040, 2415,
+    760, 1762, 457, 2683, 1059, 3090, 2326, 3349, 827, 1598, 2220, 221, 1843, 789, 2131, 3249, 334,
+    3537, 835, 1291, 378, 1944, 825, 3039, 532, 3342, 1943, 3183, 3710, 341, 2851, 1521, 1039, 306,
+    3798, 3253, 2426, 1539, 161, 2748, 4060, 3175, 1890, 3434, 3947, 805, 1407, 3718, 1840, 424,
+    1288, 177, 1660, 781, 3927, 1141, 586, 1418, 2809, 1665, 3005, 169, 3580, 3164, 1204, 3925,
+    2341, 3440, 2, 3756, 635, 1752, 2571, 3559, 1350, 3813, 1162, 3408, 78, 1051, 2766, 1591, 3940,
+    2197, 3284, 1609, 4016, 2113, 1118, 2625, 140, 2259, 1093, 2513, 695, 3963, 2334, 3024, 793,
+    1308, 440, 2937, 3618, 1787, 295, 1390, 601, 2356, 258, 3252, 2170, 201, 2842, 3451, 2298, 3875,
+    1209, 2781, 283, 2192, 2967, 3593, 2380, 1104, 3935, 1883, 937, 1594, 113, 2945, 680, 1253,
+    1889, 2621, 1323, 4066, 137, 3132, 584, 2697, 2975, 2329, 3721, 1809, 2386, 530, 2908, 152,
+    2564, 594, 2788, 189, 3638, 1374, 3953, 2916, 1565, 3480, 1990, 198, 3311, 1664, 2141, 2740,
+    3734, 1102, 2199, 819, 2537, 3582, 2923, 953, 2626, 1814, 630, 4090, 1505, 842, 1966, 3243,
+    2430, 3498, 1451, 3273, 1731, 25, 804, 3338, 391, 2258, 2875, 2510, 3745, 2001, 1516, 3224,
+    3636, 466, 2965, 2104, 1082, 2395, 1946, 925, 381, 1544, 702, 3108, 1195, 3777, 908, 1766, 3662,
+    1055, 1490, 3188, 2330, 570, 1753, 815, 299, 3051, 916, 2672, 1223, 578, 4049, 127, 1899, 571,
+    3458, 3080, 1137, 2095, 1578, 3872, 1270, 3643, 3048, 1106, 2362, 3091, 531, 993, 73, 2044, 699,
+    2536, 1015, 4043, 2005, 2652, 1274, 3503, 719, 338, 3331, 1009, 2783, 231, 2233, 915, 1555,
+    3497, 365, 3832, 1650, 3598, 3270, 2013, 4005, 287, 2635, 1964, 3251, 1307, 3043, 2030, 3893,
+    860, 1916, 3398, 2685, 3762, 2212, 3608, 1444, 3822, 1928, 3509, 2464, 1421, 3297, 2582, 1630,
+    35, 3985, 487, 3294, 173, 2246, 395, 1675, 2724, 143, 3595, 1729, 2981, 3681, 1637, 3846, 452,
+    3418, 2878, 1478, 619, 3185, 1705, 3981, 1454, 2201, 539, 4034, 2471, 1736, 3856, 2552, 710,
+    3217, 1226, 2830, 31, 2450, 1023, 2772, 1431, 3573, 88, 2306, 503, 2447, 224, 2645, 413, 2949,
+    1218, 87, 1028, 1864, 566, 2437, 30, 2997, 1046, 367, 2884, 890, 3901, 1269, 2402, 1826, 2714,
+    878, 1912, 2836, 3492, 743, 2038, 3895, 1334, 2605, 653, 1174, 2353, 2807, 1299, 1810, 336,
+    2312, 3770, 109, 2069, 2744, 1114, 3035, 1858, 3459, 770, 1192, 3046, 90, 1845, 2721, 2173, 521,
+    3946, 1361, 598, 3441, 2221, 857, 1635, 4082, 3427, 800, 3759, 1710, 3468, 1477, 4035, 2472,
+    3266, 2877, 1259, 3343, 1686, 712, 2313, 3220, 1755, 2205, 267, 2973, 777, 3639, 1379, 3100,
+    3748, 1062, 2477, 1459, 3312, 943, 371, 2189, 4047, 3180, 257, 900, 3141, 2154, 3571, 1096,
+    3060, 2541, 894, 286, 3602, 2404, 41, 1376, 2747, 437, 2072, 3673, 1352, 3471, 866, 1608, 3105,
+    2124, 2926, 1771, 364, 3178, 2554, 1076, 1871, 1426, 3134, 1038, 2301, 587, 2029, 362, 1535,
+    3871, 256, 2725, 4010, 2045, 3623, 1161, 3797, 596, 3512, 1967, 3363, 322, 2211, 603, 1600, 75,
+    3982, 504, 2284, 2899, 3482, 1855, 438, 1441, 3500, 1722, 3922, 156, 2715, 752, 1877, 1434,
+    3878, 3162, 1645, 818, 3743, 3122, 1699, 3914, 3271, 986, 2348, 223, 3780, 2599, 1089, 3543,
+    191, 3919, 1164, 3722, 614, 2938, 296, 2623, 2101, 14, 2863, 3615, 893, 3030, 2161, 722, 2350,
+    999, 1468, 464, 2641, 142, 1514, 2738, 1008, 1580, 2474, 1206, 3957, 2612, 1958, 3388, 1236,
+    3044, 1793, 114, 1552, 2691, 2376, 2895, 2000, 721, 2584, 1207, 1599, 4007, 382, 3403, 1140,
+    2177, 477, 2660, 1098, 2137, 238, 2508, 1471, 528, 2948, 1786, 3193, 372, 1956, 742, 1538, 2385,
+    2712, 1974, 1355, 2240, 3826, 3239, 634, 3973, 1338, 2503, 1659, 3365, 1183, 3508, 1846, 3707,
+    3106, 852, 3453, 1887, 3076, 2309, 4074, 74, 2856, 713, 3202, 246, 2960, 2185, 718, 2573, 3687,
+    991, 3816, 747, 1217, 3898, 64, 2270, 3667, 525, 3299, 2829, 2400, 2014, 609, 2904, 3530, 1848,
+    3961, 612, 3419, 898, 1992, 2673, 4048, 1280, 679, 2439, 3965, 2769, 3286, 954, 507, 3139, 61,
+    3467, 868, 1655, 1215, 3413, 1875, 388, 3766, 131, 2640, 509, 2839, 70, 2118, 2459, 1363, 3926,
+    415, 766, 1301, 3300, 2073, 3715, 1767, 1396, 968, 3546, 1492, 345, 3234, 1332, 2130, 3307,
+    1781, 987, 3375, 1378, 3063, 1853, 2179, 966, 24, 3696, 1557, 2457, 368, 1411, 2847, 2408, 1286,
+    3001, 3727, 62, 826, 2260, 3502, 1662, 1133, 111, 2112, 3803, 1791, 3586, 1551, 2763, 2035, 205,
+    2368, 2734, 811, 3081, 1103, 2243, 1738, 4088, 1239, 1579, 3396, 318, 2858, 1056, 2159, 3679,
+    2535, 1669, 492, 1057, 2338, 3861, 529, 2754, 4052, 1861, 2371, 576, 2756, 259, 3034, 2529, 498,
+    2778, 858, 247, 3791, 1284, 3003, 757, 3197, 4093, 1017, 3316, 89, 1727, 3550, 451, 1549, 3261,
+    1856, 3077, 236, 2887, 3682, 1462, 2990, 320, 1235, 2266, 589, 1072, 4041, 3062, 3698, 485,
+    2148, 3897, 1515, 2955, 883, 3213, 2445, 744, 3750, 1750, 638, 3335, 1495, 2972, 313, 3567,
+    3128, 2693, 144, 3017, 1900, 2436, 40, 1105, 3007, 3911, 1570, 3640, 649, 2006, 3594, 1674,
+    4054, 2438, 1508, 3395, 2547, 1780, 1193, 235, 1954, 2320, 3833, 845, 2016, 2586, 1045, 2343,
+    3851, 1359, 948, 2167, 606, 2525, 891, 3350, 2667, 3918, 3031, 2507, 385, 1808, 1456, 1032,
+    3372, 160, 2619, 613, 3646, 197, 1902, 3021, 1125, 2700, 3840, 2392, 184, 1922, 1175, 830, 1970,
+    1442, 3655, 882, 3318, 1602, 787, 3381, 2071, 196, 934, 2290, 3972, 1457, 310, 2229, 1149, 3144,
+    615, 1973, 298, 3888, 2217, 2733, 3110, 651, 1254, 2963, 309, 4021, 2873, 640, 291, 2757, 3596,
+    1756, 3267, 4094, 1975, 1613, 736, 119, 1903, 1346, 3450, 765, 2883, 2530, 1866, 1210, 3192,
+    1985, 2352, 1373, 3913, 459, 2281, 101, 1983, 870, 3136, 4025, 2762, 2354, 3874, 579, 2207,
+    1252, 409, 2900, 3778, 1383, 2663, 1739, 3461, 1258, 29, 3278, 2920, 753, 2694, 108, 3620, 2838,
+    892, 3499, 569, 1455, 3720, 1701, 2628, 3616, 2166, 1369, 1785, 3374, 2103, 1597, 506, 2469, 13,
+    1295, 455, 3514, 2190, 3650, 936, 3215, 2127, 3862, 39, 3603, 563, 4029, 1627, 348, 3391, 1036,
+    2634, 3483, 1559, 3209, 1279, 3563, 1649, 572, 1388, 23, 3223, 1693, 3428, 2579, 3942, 1988,
+    2316, 604, 3632, 398, 3116, 2727, 2389, 1019, 3834, 1833, 3430, 2078, 1587, 1246, 2370, 1641,
+    2947, 1010, 167, 3390, 467, 949, 3235, 43, 808, 3713, 1156, 3111, 3916, 1083, 2999, 2293, 2737,
+    3094, 1181, 2557, 1652, 292, 2419, 1177, 1618, 2074, 3040, 2383, 843, 3753, 2909, 1735, 668,
+    2027, 944, 3996, 2907, 349, 2615, 2191, 3764, 2919, 458, 1074, 2814, 219, 1548, 1044, 155, 3208,
+    1150, 2204, 755, 1924, 542, 1647, 2492, 1344, 444, 3752, 692, 3995, 3275, 82, 2523, 3843, 2068,
+    2398, 1395, 1892, 2505, 3865, 2988, 2432, 174, 2638, 784, 1874, 3693, 1590, 960, 164, 3993, 520,
+    2913, 3719, 661, 2774, 3313, 909, 1401, 225, 2729, 1294, 2226, 28, 3812, 2771, 278, 2456, 707,
+    1893, 1115, 3423, 923, 1850, 2473, 4013, 2046, 814, 3488, 2520, 3714, 1824, 2602, 4075, 1501,
+    3703, 3422, 3025, 171, 3247, 982, 2285, 2656, 351, 2129, 1134, 3455, 1816, 379, 3169, 3952,
+    2889, 618, 1606, 1052, 1993, 1464, 3355, 2231, 228, 3285, 575, 3799, 1831, 1354, 2049, 3369,
+    1097, 1923, 3989, 271, 2632, 3486, 3842, 2032, 501, 3322, 998, 3061, 1473, 3410, 2098, 1414,
+    3685, 3054, 212, 1582, 3645, 716, 1290, 3194, 1654, 2952, 666, 1368, 3029, 829, 103, 2897, 1185,
+    2235, 853, 3951, 2003, 2853, 1678, 3172, 865, 1761, 3011, 737, 1324, 2799, 786, 1147, 227, 3493,
+    2282, 421, 3635, 637, 3991, 1194, 2857, 1380, 2601, 2182, 3463, 2811, 824, 2317, 80, 3074, 1423,
+    2251, 599, 1770, 1025, 3196, 1691, 3630, 2515, 1881, 547, 1107, 3837, 60, 2797, 2242, 646, 3165,
+    2689, 2176, 107, 3755, 442, 2202, 3970, 326, 2346, 1642, 3525, 2066, 352, 1734, 2593, 1255, 557,
+    3477, 51, 1400, 3788, 2726, 3612, 491, 4036, 2276, 1567, 3702, 1806, 2716, 1267, 3242, 2594,
+    3047, 1742, 389, 3584, 1989, 899, 374, 3083, 226, 1569, 3929, 2666, 1741, 873, 3610, 3117, 2479,
+    117, 2825, 701, 1381, 183, 4033, 2319, 3129, 2583, 875, 1640, 4076, 1197, 2015, 402, 3442, 1449,
+    2441, 2785, 1190, 1937, 3336, 1013, 3166, 595, 2735, 3749, 2987, 288, 3659, 1529, 2420, 4091,
+    1086, 2311, 229, 1502, 2465, 1906, 3201, 22, 2984, 2138, 859, 4083, 1717, 83, 969, 2142, 2484,
+    739, 3159, 4012, 1687, 1166, 2483, 3544, 513, 1196, 3782, 396, 2055, 1249, 4061, 1547, 2275,
+    3876, 2096, 3000, 846, 1571, 358, 1827, 3611, 496, 2512, 3357, 1504, 3857, 1069, 3009, 1782,
+    911, 3552, 19, 1563, 2578, 3785, 1918, 924, 1384, 667, 3317, 2052, 2790, 754, 1835, 3236, 616,
+    1996, 3347, 1184, 328, 3536, 1060, 2490, 564, 3102, 323, 2092, 3754, 1428, 2813, 3829, 1560, 96,
+    2728, 2314, 3726, 685, 1878, 3142, 2123, 3348, 2522, 2944, 281, 782, 3366, 1066, 420, 3522,
+    1180, 2720, 3724, 3250, 1211, 2906, 2145, 992, 118, 2782, 797, 2303, 202, 4028, 560, 3137, 2288,
+    3908, 516, 1289, 159, 2409, 4026, 1153, 2328, 128, 1065, 3052, 316, 2622, 3709, 2935, 838, 3801,
+    2664, 705, 1768, 3904, 1417, 3613, 1152, 2521, 674, 3323, 279, 1148, 3424, 1919, 1047, 493,
+    3277, 1326, 2832, 975, 245, 1518, 691, 1700, 3519, 1979, 2425, 3045, 1773, 2555, 244, 1942, 673,
+    2206, 146, 3481, 1463, 3889, 3125, 1837, 3664, 1624, 3211, 2565, 2075, 1427, 2870, 783, 2059,
+    2704, 3485, 3078, 1646, 2867, 3695, 1811, 3848, 3426, 2165, 1450, 1136, 150, 1629, 2105, 3085,
+    1327, 2250, 3344, 185, 1971, 2841, 3465, 1663, 2280, 3069, 582, 2394, 2888, 3814, 1496, 2083,
+    18, 4067, 2263, 2723, 3704, 1135, 3906, 2676, 1393, 56, 3781, 608, 1475, 3386, 3073, 1372, 3977,
+    2620, 725, 1935, 304, 2332, 633, 2651, 417, 1248, 759, 3708, 237, 1080, 3282, 3676, 1517, 393,
+    2025, 480, 821, 2569, 1370, 543, 1666, 862, 3928, 2342, 3579, 2592, 495, 4008, 121, 2819, 930,
+    2575, 1537, 779, 387, 3868, 959, 1957, 4045, 1310, 200, 807, 3014, 2500, 3400, 1661, 761, 3191,
+    1851, 141, 2194, 526, 3231, 886, 2806, 2121, 4019, 940, 2286, 429, 1702, 1002, 3288, 2815, 3606,
+    1063, 1403, 3401, 2125, 3870, 1879, 3362, 1638, 2475, 1839, 130, 2971, 962, 3930, 3379, 2089,
+    344, 3245, 2273, 2931, 21, 2768, 654, 1898, 3325, 907, 1530, 1986, 3653, 515, 3181, 4018, 2323,
+    2942, 1386, 12, 2751, 1589, 3517, 2140, 3237, 1788, 324, 1139, 3670, 471, 1337, 2403, 3425,
+    2894, 1058, 1926, 3654, 1644, 1199, 2677, 186, 3556, 2893, 3694, 2393, 1331, 500, 1643, 3038,
+    4042, 50, 2861, 977, 3028, 366, 2749, 683, 4092, 1242, 2264, 2604, 1751, 1314, 3775, 2775, 985,
+    3998, 1234, 3529, 1803, 3190, 261, 1213, 2905, 2399, 3393, 1095, 1679, 2150, 243, 1031, 1784,
+    3406, 2453, 3641, 768, 363, 2658, 1007, 3983, 639, 2637, 1938, 2868, 3941, 946, 376, 1584, 4038,
+    2374, 255, 3447, 483, 3170, 1842, 1245, 659, 1999, 11, 3931, 2102, 2577, 767, 1952, 2458, 1680,
+    551, 2335, 1298, 3575, 2111, 3143, 425, 3524, 626, 3092, 55, 3298, 1522, 1886, 241, 2548, 2088,
+    951, 1486, 3967, 2152, 3738, 325, 665, 2701, 3831, 1281, 2613, 3744, 3097, 628, 2136, 1099,
+    3016, 1746, 3361, 1458, 2216, 3513, 3112, 1493, 126, 2122, 3528, 2642, 3154, 726, 1358, 3027,
+    2506, 778, 2223, 3899, 2533, 1581, 3414, 2709, 869, 3171, 218, 3737, 1260, 399, 3809, 3304,
+    1528, 3933, 102, 983, 2549, 1503, 1962, 3869, 1077, 2318, 792, 476, 3507, 3057, 714, 3771, 456,
+    2974, 2476, 758, 1732, 1366, 3115, 1909, 100, 3340, 730, 1995, 408, 1296, 3979, 180, 2022, 3839,
+    510, 2493, 65, 1265, 872, 2359, 3269, 794, 1709, 1168, 2026, 33, 3742, 1763, 1033, 3689, 1465,
+    92, 895, 3049, 311, 1187, 1847, 3551, 1491, 2219, 3359, 2962, 1131, 2681, 751, 2028, 3004, 1765,
+    3432, 745, 2859, 277, 1682, 2665, 4053, 2043, 2413, 1306, 1720, 3320, 2278, 1144, 3435, 59,
+    3547, 2570, 4068, 912, 2333, 2872, 1507, 3531, 2759, 1711, 2518, 3289, 2833, 1272, 834, 3683,
+    2941, 2060, 3932, 343, 3634, 2698, 533, 3808, 2516, 3399, 2214, 433, 2914, 1965, 3262, 2736,
+    3478, 2064, 4077, 2300, 2874, 482, 996, 2671, 663, 1776, 2153, 190, 3515, 2452, 1169, 397, 3984,
+    1271, 3301, 2168, 3605, 1336, 151, 2996, 839, 3881, 86, 2786, 1562, 403, 1927, 2743, 1014, 2106,
+    272, 1622, 3649, 473, 1101, 2222, 68, 3784, 720, 1485, 331, 2366, 1862, 3200, 1595, 565, 2610,
+    1391, 1000, 1910, 2989, 300, 1497, 965, 2761, 1275, 3884, 263, 671, 1138, 1673, 461, 1404, 748,
+    3787, 1697, 3107, 3912, 85, 3663, 945, 3160, 1639, 511, 3730, 2686, 2099, 32, 2494, 973, 536,
+    2840, 1628, 3557, 1145, 2608, 2017, 652, 4040, 3018, 3674, 1313, 3225, 593, 2991, 1224, 3216,
+    1931, 3974, 2995, 919, 3119, 1930, 3518, 1018, 4084, 2657, 273, 1067, 3792, 1823, 3089, 2187,
+    4064, 1293, 3308, 1863, 3964, 590, 3203, 1607, 2585, 2196, 3955, 2422, 3628, 2794, 3206, 116,
+    2485, 1276, 1960, 2327, 1397, 2528, 4085, 1247, 3032, 1884, 841, 3174, 1604, 3680, 1849, 3205,
+    2289, 643, 1934, 400, 3121, 3470, 1375, 2434, 867, 176, 1651, 2252, 3773, 1818, 2675, 715, 2491,
+    253, 1615, 2396, 1228, 478, 2180, 2911, 1561, 627, 3624, 2254, 2854, 165, 3490, 650, 234, 2412,
+    806, 2834, 172, 2446, 1980, 881, 3581, 1412, 3103, 188, 823, 1872, 1117, 2174, 3439, 354, 880,
+    3476, 2852, 301, 678, 2247, 3553, 222, 1406, 3825, 645, 2818, 239, 3934, 1221, 3332, 3844, 2373,
+    1532, 206, 1029, 3562, 2048, 2647, 3948, 422, 921, 3475, 5, 3859, 1408, 3394, 642, 3717, 3272,
+    2618, 3890, 216, 3319, 2116, 1399, 3371, 749, 1230, 1585, 2722, 3177, 1715, 3627, 2158, 3449,
+    1154, 3796, 110, 2869, 490, 1037, 2024, 3370, 2629, 432, 3751, 1498, 2710, 4001, 550, 1596,
+    3324, 1997, 2805, 990, 2574, 2156, 2932, 1151, 2382, 1481, 803, 2648, 52, 2866, 931, 3723, 2241,
+    2890, 1774, 556, 3328, 1203, 2468, 2896, 1482, 2357, 2007, 914, 2804, 2126, 1775, 133, 1443,
+    769, 1815, 952, 2752, 20, 1896, 2563, 3917, 2296, 926, 3786, 1110, 392, 1436, 689, 1670, 2659,
+    3356, 2169, 1714, 3824, 2901, 1488, 4009, 1743, 708, 3019, 2058, 1240, 3093, 1876, 855, 3855,
+    134, 1483, 3969, 523, 3505, 342, 2020, 3096, 3617, 1737, 2143, 1364, 527, 1830, 3296, 419, 3923,
+    1525, 3067, 763, 1798, 3368, 404, 1158, 3591, 3153, 339, 4055, 1011, 2929, 3604, 2462, 3149,
+    3706, 1273, 3971, 3041, 370, 1744, 3538, 81, 1984, 2597, 2921, 4020, 2384, 3123, 463, 1348, 802,
+    3489, 2294, 644, 48, 1225, 2347, 3306, 193, 978, 2576, 38, 3728, 2498, 1170, 2986, 1778, 3238,
+    889, 1695, 2674, 4024, 1030, 454, 2482, 1088, 4086, 3098, 2526, 809, 1285, 2696, 42, 2210, 3736,
+    249, 2097, 4004, 2650, 512, 1611, 2558, 1315, 2363, 553, 2037, 1109, 317, 2160, 559, 2401, 833,
+    1159, 3257, 581, 2982, 1343, 624, 3295, 182, 1959, 976, 3896, 1852, 2480, 269, 1119, 2600, 3135,
+    3532, 885, 2732, 1929, 3821, 3383, 2271, 1387, 470, 2082, 3438, 428, 2039, 2397, 3066, 1339, 95,
+    3321, 1533, 2969, 3268, 1932, 330, 1588, 3810, 2157, 3420, 1070, 2559, 1377, 2950, 1020, 1556,
+    3082, 820, 1936, 3783, 192, 3533, 3246, 1536, 4002, 3008, 1681, 3472, 1479, 3668, 2795, 2133,
+    1534, 2478, 3885, 2232, 1754, 1198, 3675, 2796, 17, 3302, 2957, 4059, 1527, 3690, 1828, 2144,
+    290, 3666, 1466, 522, 1667, 731, 2959, 3565, 2719, 813, 3805, 1231, 187, 3621, 703, 2261, 1888,
+    3774, 625};
+
+} // namespace Prism
+
+#endif // PRISM_BLUE_NOISE_HPP_
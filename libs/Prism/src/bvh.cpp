@@ -0,0 +1,620 @@
+#include "Prism/bvh.hpp"
+#include "Prism/stats.hpp"
+#include "Prism/thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+namespace Prism {
+
+namespace {
+
+constexpr ld kTraversalCost = 1;
+constexpr ld kIntersectionCost = 1;
+
+// Past this depth the builder stops evaluating the SAH and splits at the median, which bounds
+// the total depth well below the traversal stack size.
+constexpr int kMaxSahDepth = 32;
+
+// Binned builds on a pool: nodes with at least this many primitives are binned in chunks of
+// kBinningChunk in parallel, and their two subtrees are built as separate tasks.
+constexpr size_t kParallelBinning = size_t(1) << 14;
+constexpr size_t kBinningChunk = size_t(1) << 13;
+constexpr size_t kParallelSubtree = size_t(1) << 12;
+constexpr size_t kMaxBinCount = 256;
+
+// Cost of intersecting count primitives that are tested width at a time.
+ld groupCost(size_t count, size_t width) {
+    return static_cast<ld>((count + width - 1) / width);
+}
+
+ld component(const Point3& p, int axis) {
+    return axis == 0 ? p.x : (axis == 1 ? p.y : p.z);
+}
+
+// Orders primitive indices by centroid along one axis, breaking ties by index so the build is
+// deterministic.
+struct CentroidLess {
+    const std::vector<Point3>& centroids;
+    int axis;
+
+    bool operator()(uint32_t a, uint32_t b) const {
+        const ld ca = component(centroids[a], axis);
+        const ld cb = component(centroids[b], axis);
+        return ca < cb || (ca == cb && a < b);
+    }
+};
+
+class SweepBuilder {
+  public:
+    SweepBuilder(const std::vector<AABB>& bounds, size_t max_leaf_size, size_t leaf_width,
+                 std::vector<BVHNode>& nodes, std::vector<uint32_t>& order)
+        : bounds_(bounds), max_leaf_size_(max_leaf_size), leaf_width_(leaf_width), nodes_(nodes),
+          order_(order), right_area_(bounds.size()) {
+        centroids_.reserve(bounds.size());
+        for (const auto& box : bounds) {
+            centroids_.push_back(box.centroid());
+        }
+    }
+
+    void build(size_t begin, size_t end, int depth) {
+        const size_t node_index = nodes_.size();
+        nodes_.emplace_back();
+
+        AABB node_bounds;
+        AABB centroid_bounds;
+        for (size_t i = begin; i < end; ++i) {
+            node_bounds.expand(bounds_[order_[i]]);
+            centroid_bounds.expand(centroids_[order_[i]]);
+        }
+        nodes_[node_index].bounds = node_bounds;
+
+        const size_t count = end - begin;
+        if (count == 1) {
+            makeLeaf(node_index, begin, count);
+            return;
+        }
+
+        int best_axis = -1;
+        size_t best_split = 0;
+        ld best_cost = std::numeric_limits<ld>::infinity();
+        int sorted_axis = -1;
+
+        if (depth < kMaxSahDepth) {
+            for (int axis = 0; axis < 3; ++axis) {
+                if (component(centroid_bounds.min, axis) == component(centroid_bounds.max, axis)) {
+                    continue;
+                }
+                sortByAxis(begin, end, axis);
+                sorted_axis = axis;
+
+                AABB right;
+                for (size_t i = end - 1; i > begin; --i) {
+                    right.expand(bounds_[order_[i]]);
+                    right_area_[i - begin] = right.surfaceArea();
+                }
+
+                AABB left;
+                for (size_t i = begin; i + 1 < end; ++i) {
+                    left.expand(bounds_[order_[i]]);
+                    const size_t left_count = i - begin + 1;
+                    const ld cost =
+                        left.surfaceArea() * groupCost(left_count, leaf_width_) +
+                        right_area_[i + 1 - begin] * groupCost(count - left_count, leaf_width_);
+                    if (cost < best_cost) {
+                        best_cost = cost;
+                        best_axis = axis;
+                        best_split = i + 1;
+                    }
+                }
+            }
+        }
+
+        if (best_axis >= 0) {
+            const ld parent_area = node_bounds.surfaceArea();
+            const ld leaf_cost = kIntersectionCost * groupCost(count, leaf_width_);
+            const ld split_cost =
+                parent_area > 0 ? kTraversalCost + kIntersectionCost * best_cost / parent_area
+                                : kTraversalCost + leaf_cost;
+            if (count <= max_leaf_size_ && leaf_cost <= split_cost) {
+                makeLeaf(node_index, begin, count);
+                return;
+            }
+            if (best_axis != sorted_axis) {
+                sortByAxis(begin, end, best_axis);
+            }
+        } else {
+            if (count <= max_leaf_size_) {
+                makeLeaf(node_index, begin, count);
+                return;
+            }
+            best_axis = centroid_bounds.longestAxis();
+            best_split = begin + count / 2;
+            std::nth_element(order_.begin() + begin, order_.begin() + best_split,
+                             order_.begin() + end, CentroidLess{centroids_, best_axis});
+        }
+
+        build(begin, best_split, depth + 1);
+        nodes_[node_index].offset = static_cast<uint32_t>(nodes_.size());
+        nodes_[node_index].axis = static_cast<uint16_t>(best_axis);
+        build(best_split, end, depth + 1);
+    }
+
+  private:
+    void sortByAxis(size_t begin, size_t end, int axis) {
+        std::sort(order_.begin() + begin, order_.begin() + end, CentroidLess{centroids_, axis});
+    }
+
+    void makeLeaf(size_t node_index, size_t begin, size_t count) {
+        nodes_[node_index].offset = static_cast<uint32_t>(begin);
+        nodes_[node_index].count = static_cast<uint16_t>(count);
+        nodes_[node_index].axis = 0;
+    }
+
+    const std::vector<AABB>& bounds_;
+    size_t max_leaf_size_;
+    size_t leaf_width_;
+    std::vector<BVHNode>& nodes_;
+    std::vector<uint32_t>& order_;
+    std::vector<Point3> centroids_;
+    std::vector<ld> right_area_;
+};
+
+class BinnedBuilder {
+  public:
+    BinnedBuilder(const std::vector<AABB>& bounds, const BVHBuildOptions& options,
+                  std::vector<BVHNode>& nodes, std::vector<uint32_t>& order)
+        : options_(options), nodes_(nodes), order_(order), refs_(bounds.size()) {
+        forChunks(0, bounds.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) {
+                refs_[i] = {bounds[i], bounds[i].centroid(), static_cast<uint32_t>(i)};
+            }
+        });
+    }
+
+    void build() {
+        // A subtree over n primitives takes at most 2n - 1 nodes. Giving every subtree exactly
+        // that many slots places the first child right after its parent and the second child
+        // after the slots of the first, so both subtrees can be built concurrently; the unused
+        // slots are squeezed out afterwards, which keeps the depth-first layout.
+        const size_t count = refs_.size();
+        nodes_.assign(2 * count - 1, BVHNode());
+        used_.assign(2 * count - 1, 0);
+
+        AABB node_bounds;
+        AABB centroid_bounds;
+        measure(0, count, node_bounds, centroid_bounds);
+        build(0, 0, count, node_bounds, centroid_bounds, 0);
+        compact();
+        for (size_t i = 0; i < count; ++i) {
+            order_[i] = refs_[i].index;
+        }
+    }
+
+  private:
+    // The builder partitions copies of the primitive bounds rather than indices, so that every
+    // pass over a node reads memory in order.
+    struct Reference {
+        AABB bounds;
+        Point3 centroid;
+        uint32_t index;
+    };
+
+    struct Bin {
+        AABB bounds;
+        AABB centroids;
+        size_t count = 0;
+
+        void add(const Bin& other) {
+            bounds.expand(other.bounds);
+            centroids.expand(other.centroids);
+            count += other.count;
+        }
+    };
+
+    // Maps centroids to bins along one axis; partitioning uses the same mapping so that the
+    // primitives end up on the side the cost was computed for.
+    struct Binning {
+        ld min;
+        ld scale;
+        size_t last;
+
+        size_t operator()(const Point3& centroid, int axis) const {
+            const ld x = (component(centroid, axis) - min) * scale;
+            return x <= 0 ? 0 : std::min(static_cast<size_t>(x), last);
+        }
+    };
+
+    // Runs body(chunk_begin, chunk_end, chunk) over fixed-size chunks of [begin, end), in
+    // parallel for large ranges. The chunks only depend on the range, not on the pool.
+    template <typename Body>
+    size_t forChunks(size_t begin, size_t end, Body&& body) const {
+        const size_t count = end - begin;
+        if (options_.pool == nullptr || count < kParallelBinning) {
+            body(begin, end, 0);
+            return 1;
+        }
+        const size_t chunks = (count + kBinningChunk - 1) / kBinningChunk;
+        options_.pool->parallelFor(chunks, [&](size_t chunk) {
+            const size_t chunk_begin = begin + chunk * kBinningChunk;
+            body(chunk_begin, std::min(chunk_begin + kBinningChunk, end), chunk);
+        });
+        return chunks;
+    }
+
+    void measure(size_t begin, size_t end, AABB& node_bounds, AABB& centroid_bounds) const {
+        std::vector<Bin> parts((end - begin + kBinningChunk - 1) / kBinningChunk);
+        const size_t chunks = forChunks(begin, end, [&](size_t from, size_t to, size_t chunk) {
+            Bin& part = parts[chunk];
+            for (size_t i = from; i < to; ++i) {
+                part.bounds.expand(refs_[i].bounds);
+                part.centroids.expand(refs_[i].centroid);
+            }
+        });
+        Bin total;
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            total.add(parts[chunk]);
+        }
+        node_bounds = total.bounds;
+        centroid_bounds = total.centroids;
+    }
+
+    void build(size_t slot, size_t begin, size_t end, const AABB& node_bounds,
+               const AABB& centroid_bounds, int depth) {
+        used_[slot] = 1;
+        nodes_[slot].bounds = node_bounds;
+        const size_t count = end - begin;
+        if (count == 1) {
+            makeLeaf(slot, begin, count);
+            return;
+        }
+
+        // Small nodes get a bin per primitive at most, which is as precise and much cheaper.
+        const size_t bin_count = std::min(options_.bin_count, count);
+        int best_axis = -1;
+        size_t best_bin = 0;
+        ld best_cost = std::numeric_limits<ld>::infinity();
+        Binning binning[3];
+        std::vector<Bin> bins;
+
+        if (depth < kMaxSahDepth) {
+            bool any_axis = false;
+            for (int axis = 0; axis < 3; ++axis) {
+                const ld min = component(centroid_bounds.min, axis);
+                const ld extent = component(centroid_bounds.max, axis) - min;
+                ld scale = extent > 0 ? bin_count / extent : 0;
+                if (!(scale < std::numeric_limits<ld>::infinity())) {
+                    scale = 0;
+                }
+                binning[axis] = {min, scale, bin_count - 1};
+                any_axis = any_axis || scale > 0;
+            }
+            if (any_axis) {
+                bins = binPrimitives(begin, end, binning, bin_count);
+                findSplit(bins, bin_count, count, best_axis, best_bin, best_cost);
+            }
+        }
+
+        size_t split = 0;
+        AABB left_bounds, left_centroids, right_bounds, right_centroids;
+        if (best_axis >= 0) {
+            const ld parent_area = node_bounds.surfaceArea();
+            const ld leaf_cost = kIntersectionCost * groupCost(count, options_.leaf_width);
+            const ld split_cost =
+                parent_area > 0 ? kTraversalCost + kIntersectionCost * best_cost / parent_area
+                                : kTraversalCost + leaf_cost;
+            if (count <= options_.max_leaf_size && leaf_cost <= split_cost) {
+                makeLeaf(slot, begin, count);
+                return;
+            }
+
+            Bin left, right;
+            const Bin* axis_bins = &bins[best_axis * bin_count];
+            for (size_t b = 0; b < bin_count; ++b) {
+                (b <= best_bin ? left : right).add(axis_bins[b]);
+            }
+            const Binning& by = binning[best_axis];
+            const int axis = best_axis;
+            const size_t last_left = best_bin;
+            const auto middle = std::partition(
+                refs_.begin() + begin, refs_.begin() + end,
+                [&](const Reference& ref) { return by(ref.centroid, axis) <= last_left; });
+            split = static_cast<size_t>(middle - refs_.begin());
+            left_bounds = left.bounds;
+            left_centroids = left.centroids;
+            right_bounds = right.bounds;
+            right_centroids = right.centroids;
+        } else {
+            if (count <= options_.max_leaf_size) {
+                makeLeaf(slot, begin, count);
+                return;
+            }
+            best_axis = centroid_bounds.longestAxis();
+            split = begin + count / 2;
+            const int axis = best_axis;
+            std::nth_element(refs_.begin() + begin, refs_.begin() + split, refs_.begin() + end,
+                             [axis](const Reference& a, const Reference& b) {
+                                 const ld ca = component(a.centroid, axis);
+                                 const ld cb = component(b.centroid, axis);
+                                 return ca < cb || (ca == cb && a.index < b.index);
+                             });
+            measure(begin, split, left_bounds, left_centroids);
+            measure(split, end, right_bounds, right_centroids);
+        }
+
+        const size_t left_slot = slot + 1;
+        const size_t right_slot = slot + 2 * (split - begin);
+        nodes_[slot].offset = static_cast<uint32_t>(right_slot);
+        nodes_[slot].axis = static_cast<uint16_t>(best_axis);
+        if (options_.pool != nullptr && count >= kParallelSubtree) {
+            options_.pool->parallelFor(2, [&](size_t child) {
+                if (child == 0) {
+                    build(left_slot, begin, split, left_bounds, left_centroids, depth + 1);
+                } else {
+                    build(right_slot, split, end, right_bounds, right_centroids, depth + 1);
+                }
+            });
+        } else {
+            build(left_slot, begin, split, left_bounds, left_centroids, depth + 1);
+            build(right_slot, split, end, right_bounds, right_centroids, depth + 1);
+        }
+    }
+
+    // Returns bin_count bins per axis, axis after axis. Chunks are binned separately and merged
+    // in order, which gives the same bins as a serial pass.
+    std::vector<Bin> binPrimitives(size_t begin, size_t end, const Binning* binning,
+                                   size_t bin_count) const {
+        const size_t size = 3 * bin_count;
+        std::vector<Bin> parts(size * ((end - begin + kBinningChunk - 1) / kBinningChunk));
+        const size_t chunks = forChunks(begin, end, [&](size_t from, size_t to, size_t chunk) {
+            Bin* part = &parts[chunk * size];
+            for (size_t i = from; i < to; ++i) {
+                // A copy, so that updating the bins does not force the reference to be reloaded.
+                const Reference ref = refs_[i];
+                const size_t x = binning[0](ref.centroid, 0);
+                const size_t y = binning[1](ref.centroid, 1);
+                const size_t z = binning[2](ref.centroid, 2);
+                for (Bin* bin : {part + x, part + bin_count + y, part + 2 * bin_count + z}) {
+                    bin->bounds.expand(ref.bounds);
+                    bin->centroids.expand(ref.centroid);
+                    ++bin->count;
+                }
+            }
+        });
+        for (size_t chunk = 1; chunk < chunks; ++chunk) {
+            for (size_t b = 0; b < size; ++b) {
+                parts[b].add(parts[chunk * size + b]);
+            }
+        }
+        parts.resize(size);
+        return parts;
+    }
+
+    // Evaluates the SAH between every pair of neighbouring bins that leaves both sides non-empty.
+    void findSplit(const std::vector<Bin>& bins, size_t bin_count, size_t count, int& best_axis,
+                   size_t& best_bin, ld& best_cost) const {
+        std::array<ld, kMaxBinCount> right_area;
+        std::array<size_t, kMaxBinCount> right_counts;
+        for (int axis = 0; axis < 3; ++axis) {
+            const Bin* axis_bins = &bins[axis * bin_count];
+            AABB right;
+            size_t right_count = 0;
+            for (size_t b = bin_count - 1; b > 0; --b) {
+                right.expand(axis_bins[b].bounds);
+                right_count += axis_bins[b].count;
+                right_area[b] = right.surfaceArea();
+                right_counts[b] = right_count;
+            }
+
+            AABB left;
+            size_t left_count = 0;
+            for (size_t b = 0; b + 1 < bin_count; ++b) {
+                left.expand(axis_bins[b].bounds);
+                left_count += axis_bins[b].count;
+                if (left_count == 0 || left_count == count) {
+                    continue;
+                }
+                const ld cost = left.surfaceArea() * groupCost(left_count, options_.leaf_width) +
+                                right_area[b + 1] *
+                                    groupCost(right_counts[b + 1], options_.leaf_width);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_axis = axis;
+                    best_bin = b;
+                }
+            }
+        }
+    }
+
+    void makeLeaf(size_t slot, size_t begin, size_t count) {
+        nodes_[slot].offset = static_cast<uint32_t>(begin);
+        nodes_[slot].count = static_cast<uint16_t>(count);
+        nodes_[slot].axis = 0;
+    }
+
+    void compact() {
+        std::vector<uint32_t> index(nodes_.size());
+        size_t next = 0;
+        for (size_t slot = 0; slot < nodes_.size(); ++slot) {
+            index[slot] = static_cast<uint32_t>(next);
+            if (used_[slot]) {
+                nodes_[next++] = nodes_[slot];
+            }
+        }
+        nodes_.resize(next);
+        nodes_.shrink_to_fit();
+        for (BVHNode& node : nodes_) {
+            if (!node.isLeaf()) {
+                node.offset = index[node.offset];
+            }
+        }
+    }
+
+    const BVHBuildOptions& options_;
+    std::vector<BVHNode>& nodes_;
+    std::vector<uint32_t>& order_;
+    std::vector<Reference> refs_;
+    std::vector<uint8_t> used_;
+};
+
+} // namespace
+
+BVHTree::BVHTree(const std::vector<AABB>& bounds, size_t max_leaf_size, size_t leaf_width)
+    : BVHTree(bounds, BVHBuildOptions{BVHBuildMethod::Sweep, max_leaf_size, leaf_width}) {
+}
+
+BVHTree::BVHTree(const std::vector<AABB>& bounds, const BVHBuildOptions& options) {
+    if (options.max_leaf_size == 0 ||
+        options.max_leaf_size > std::numeric_limits<uint16_t>::max()) {
+        throw std::invalid_argument("BVH leaf size must be between 1 and 65535.");
+    }
+    if (options.leaf_width == 0) {
+        throw std::invalid_argument("BVH leaf width must be positive.");
+    }
+    if (options.bin_count < 2 || options.bin_count > kMaxBinCount) {
+        throw std::invalid_argument("BVH bin count must be between 2 and 256.");
+    }
+    if (bounds.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("BVH cannot index more than 2^32 - 1 primitives.");
+    }
+    if (bounds.empty()) {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    order_.resize(bounds.size());
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        order_[i] = static_cast<uint32_t>(i);
+    }
+
+    if (options.method == BVHBuildMethod::Binned) {
+        BinnedBuilder builder(bounds, options, nodes_, order_);
+        builder.build();
+    } else {
+        nodes_.reserve(2 * bounds.size() - 1);
+        SweepBuilder builder(bounds, options.max_leaf_size, options.leaf_width, nodes_, order_);
+        builder.build(0, bounds.size(), 0);
+    }
+    build_seconds_ =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+AABB BVHTree::bounds() const {
+    return nodes_.empty() ? AABB() : nodes_[0].bounds;
+}
+
+ld BVHTree::sahCost() const {
+    if (nodes_.empty()) {
+        return 0;
+    }
+    const ld root_area = nodes_[0].bounds.surfaceArea();
+    if (root_area <= 0) {
+        return kIntersectionCost * nodes_[0].count;
+    }
+
+    ld cost = 0;
+    for (const auto& node : nodes_) {
+        const ld area = node.bounds.surfaceArea();
+        cost += node.isLeaf() ? kIntersectionCost * node.count * area : kTraversalCost * area;
+    }
+    return cost / root_area;
+}
+
+BVH::BVH(const std::vector<Object*>& objects, size_t max_leaf_size)
+    : BVH(objects, BVHBuildOptions{BVHBuildMethod::Sweep, max_leaf_size}) {
+}
+
+BVH::BVH(const std::vector<Object*>& objects, const BVHBuildOptions& options) {
+    StageTimer timer(StatStage::Build);
+    std::vector<Object*> bounded;
+    std::vector<AABB> bounds;
+    for (Object* object : objects) {
+        AABB box;
+        if (object->boundingBox(box)) {
+            bounded.push_back(object);
+            bounds.push_back(box);
+        } else {
+            unbounded_.push_back(object);
+        }
+    }
+
+    tree_ = BVHTree(bounds, options);
+
+    objects_.reserve(bounded.size());
+    for (uint32_t index : tree_.primitiveOrder()) {
+        objects_.push_back(bounded[index]);
+    }
+}
+
+bool BVH::hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const {
+    bool hit_anything = false;
+    ld closest = t_max;
+    HitRecord temp;
+    StatTally tests(StatCounter::ObjectTests);
+
+    for (const Object* object : unbounded_) {
+        tests.add();
+        if (object->hit(ray, t_min, closest, temp)) {
+            hit_anything = true;
+            closest = temp.t;
+            rec = temp;
+        }
+    }
+
+    const bool hit_tree = tree_.traverse(ray, t_min, closest, [&](uint32_t slot, ld& t) {
+        tests.add();
+        if (objects_[slot]->hit(ray, t_min, t, temp)) {
+            t = temp.t;
+            rec = temp;
+            return true;
+        }
+        return false;
+    });
+
+    return hit_anything || hit_tree;
+}
+
+bool BVH::occluded(const Ray& ray, ld t_min, ld t_max) const {
+    StatTally tests(StatCounter::OcclusionTests);
+    for (const Object* object : unbounded_) {
+        tests.add();
+        if (object->occluded(ray, t_min, t_max)) {
+            return true;
+        }
+    }
+    return tree_.traverseAny(ray, t_min, t_max, [&](const BVHNode& leaf) {
+        for (uint32_t i = 0; i < leaf.count; ++i) {
+            tests.add();
+            if (objects_[leaf.offset + i]->occluded(ray, t_min, t_max)) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+void BVH::hitPacket(const RayPacket& packet, ld t_min, PacketHit& hits) const {
+    StatTally tests(StatCounter::ObjectTests);
+    for (const Object* object : unbounded_) {
+        tests.add();
+        object->hitPacket(packet, t_min, hits);
+    }
+    tree_.traversePacket(packet, t_min, hits.t_max, [&](const BVHNode& leaf) {
+        tests.add(leaf.count);
+        for (uint32_t i = 0; i < leaf.count; ++i) {
+            objects_[leaf.offset + i]->hitPacket(packet, t_min, hits);
+        }
+    });
+}
+
+bool BVH::boundingBox(AABB& box) const {
+    if (!unbounded_.empty() || objects_.empty()) {
+        return false;
+    }
+    box = tree_.bounds();
+    return true;
+}
+
+} // namespace Prism
@@ -2,15 +2,22 @@
 #include "Prism/matrix.hpp"
 #include "Prism/point.hpp"
 #include "Prism/ray.hpp"
+#include "Prism/sampler.hpp"
+#include "Prism/stats.hpp"
 #include "Prism/utils.hpp"
 #include "Prism/vector.hpp"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
-using ld = long double;
-
 namespace Prism {
 
+namespace {
+
+const ld kPi = std::acos(ld(-1));
+
+} // namespace
+
 Camera::Camera(const Point3& position, const Point3& target, const Vector3& upvec,
                const ld& distance, const ld& viewport_height, const ld& viewport_width,
                int image_height, int image_width)
@@ -20,9 +27,92 @@ Camera::Camera(const Point3& position, const Point3& target, const Vector3& upve
     aim = new Point3(target);
     up = new Vector3(upvec);
     coordinate_basis = new Matrix<ld>;
+    pixel_delta_u = new Vector3;
+    pixel_delta_v = new Vector3;
+    pixel_00_loc = new Point3;
+    updateBasis();
+}
+
+Camera::Camera(const Camera& other)
+    : pos(new Point3(*other.pos)), aim(new Point3(*other.aim)), up(new Vector3(*other.up)),
+      coordinate_basis(new Matrix<ld>(*other.coordinate_basis)),
+      screen_distance(other.screen_distance), screen_height(other.screen_height),
+      screen_width(other.screen_width), pixel_height(other.pixel_height),
+      pixel_width(other.pixel_width), pixel_00_loc(new Point3(*other.pixel_00_loc)),
+      pixel_delta_u(new Vector3(*other.pixel_delta_u)),
+      pixel_delta_v(new Vector3(*other.pixel_delta_v)) {
+}
+
+Camera& Camera::operator=(const Camera& other) {
+    *pos = *other.pos;
+    *aim = *other.aim;
+    *up = *other.up;
+    *coordinate_basis = *other.coordinate_basis;
+    screen_distance = other.screen_distance;
+    screen_height = other.screen_height;
+    screen_width = other.screen_width;
+    pixel_height = other.pixel_height;
+    pixel_width = other.pixel_width;
+    *pixel_00_loc = *other.pixel_00_loc;
+    *pixel_delta_u = *other.pixel_delta_u;
+    *pixel_delta_v = *other.pixel_delta_v;
+    return *this;
+}
+
+void Camera::setPosition(const Point3& position) {
+    *pos = position;
+    updateBasis();
+}
+
+void Camera::setTarget(const Point3& target) {
+    *aim = target;
+    updateBasis();
+}
+
+void Camera::lookAt(const Point3& position, const Point3& target) {
+    *pos = position;
+    *aim = target;
+    updateBasis();
+}
+
+void Camera::setViewport(ld viewport_height, ld viewport_width) {
+    if (!(viewport_height > 0) || !(viewport_width > 0)) {
+        throw std::invalid_argument("Viewport sizes must be positive");
+    }
+    screen_height = viewport_height;
+    screen_width = viewport_width;
+    updateScreen();
+}
+
+ld Camera::fieldOfView() const {
+    return 2 * std::atan(screen_height / (2 * screen_distance));
+}
+
+void Camera::setFieldOfView(ld fov) {
+    if (!(fov > 0) || !(fov < kPi)) {
+        throw std::invalid_argument("Field of view must be in (0, pi)");
+    }
+    const ld aspect = screen_width / screen_height;
+    screen_height = 2 * screen_distance * std::tan(fov / 2);
+    screen_width = screen_height * aspect;
+    updateScreen();
+}
+
+void Camera::setResolution(int image_height, int image_width) {
+    if (image_height <= 0 || image_width <= 0) {
+        throw std::invalid_argument("Image sizes must be positive");
+    }
+    pixel_height = image_height;
+    pixel_width = image_width;
+    updateScreen();
+}
+
+void Camera::updateBasis() {
     *coordinate_basis = orthonormalBasisContaining(*pos - *aim);
+    updateScreen();
+}
 
-    // Precalc pixel locations and deltas
+void Camera::updateScreen() {
     const auto& basis = *coordinate_basis;
     Vector3 w = Vector3{basis[0][0], basis[1][0], basis[2][0]};
     Vector3 u = Vector3{basis[0][1], basis[1][1], basis[2][1]};
@@ -32,11 +122,106 @@ Camera::Camera(const Point3& position, const Point3& target, const Vector3& upve
     Point3 top_left_corner =
         screen_center - (u * (screen_width / 2.0)) + (v * (screen_height / 2.0));
 
-    // O cálculo agora mistura 'ld' e 'int' corretamente
-    pixel_delta_u = new Vector3(u * (screen_width / pixel_width));
-    pixel_delta_v = new Vector3(v * (screen_height / pixel_height));
+    *pixel_delta_u = u * (screen_width / pixel_width);
+    *pixel_delta_v = v * (screen_height / pixel_height);
+    *pixel_00_loc = top_left_corner + (*pixel_delta_u * 0.5) - (*pixel_delta_v * 0.5);
+}
+
+Ray Camera::getRay(int x, int y) const {
+    countStat(StatCounter::CameraRays);
+    Point3 pixel_center = *pixel_00_loc + (*pixel_delta_u * x) - (*pixel_delta_v * y);
+    return Ray(*pos, pixel_center);
+}
+
+Ray Camera::getRay(int x, int y, ld u, ld v) const {
+    countStat(StatCounter::CameraRays);
+    Point3 sample = *pixel_00_loc + (*pixel_delta_u * (x + u - ld(0.5))) -
+                    (*pixel_delta_v * (y + v - ld(0.5)));
+    return Ray(*pos, sample);
+}
+
+Ray Camera::getRay(int x, int y, Sampler& sampler) const {
+    const Sample2D jitter = sampler.get2D();
+    return getRay(x, y, jitter.u, jitter.v);
+}
+
+void Camera::getPacket(int x0, int y0, RayPacket& packet) const {
+    if (x0 < 0 || y0 < 0 || x0 >= pixel_width || y0 >= pixel_height) {
+        throw std::out_of_range("Packet origin is outside the image");
+    }
+    packet.x0 = x0;
+    packet.y0 = y0;
+    countStat(StatCounter::CameraRays,
+              static_cast<uint64_t>(std::min(RayPacket::kWidth, pixel_width - x0)) *
+                  std::min(RayPacket::kHeight, pixel_height - y0));
+
+    const ld origin[3] = {pos->x, pos->y, pos->z};
+    const ld corner[3] = {pixel_00_loc->x, pixel_00_loc->y, pixel_00_loc->z};
+    const ld du[3] = {pixel_delta_u->x, pixel_delta_u->y, pixel_delta_u->z};
+    const ld dv[3] = {pixel_delta_v->x, pixel_delta_v->y, pixel_delta_v->z};
+
+    for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+        const int x = x0 + lane % RayPacket::kWidth;
+        const int y = y0 + lane / RayPacket::kWidth;
+        packet.active[lane] = x < pixel_width && y < pixel_height;
+
+        ld d[3];
+        for (int k = 0; k < 3; ++k) {
+            d[k] = corner[k] + du[k] * x - dv[k] * y - origin[k];
+        }
+        const ld inv_length = 1 / std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        for (int k = 0; k < 3; ++k) {
+            packet.origin[k][lane] = origin[k];
+            packet.direction[k][lane] = d[k] * inv_length;
+            packet.inv_direction[k][lane] = 1 / packet.direction[k][lane];
+        }
+    }
+}
+
+PixelRange Camera::pixels() const {
+    return PixelRange(*this);
+}
+
+Camera::CameraIterator Camera::begin() const {
+    return pixels().begin();
+}
+
+Camera::CameraIterator Camera::end() const {
+    return pixels().end();
+}
+
+PixelRange::PixelRange(const Camera& camera)
+    : origin_(*camera.pos), corner_(*camera.pixel_00_loc), du_(*camera.pixel_delta_u),
+      dv_(*camera.pixel_delta_v), width_(camera.pixel_width), height_(camera.pixel_height) {
+}
+
+Ray PixelRange::operator[](size_t index) const {
+    countStat(StatCounter::CameraRays);
+    const Pixel p = pixel(index);
+    const Point3 pixel_center = corner_ + (du_ * p.x) - (dv_ * p.y);
+    return Ray(origin_, pixel_center);
+}
+
+PixelRange PixelRange::tile(int x0, int y0, int width, int height) const {
+    if (width < 0 || height < 0 || x0 < x0_ || y0 < y0_ || x0 + width > x0_ + width_ ||
+        y0 + height > y0_ + height_) {
+        throw std::out_of_range("Tile is outside the pixel range");
+    }
+    PixelRange result = *this;
+    result.x0_ = x0;
+    result.y0_ = y0;
+    result.width_ = width;
+    result.height_ = height;
+    return result;
+}
 
-    pixel_00_loc = new Point3(top_left_corner + (*pixel_delta_u * 0.5) - (*pixel_delta_v * 0.5));
+std::pair<PixelRange, PixelRange> PixelRange::split() const {
+    if (width_ > height_) {
+        const int left = width_ / 2;
+        return {tile(x0_, y0_, left, height_), tile(x0_ + left, y0_, width_ - left, height_)};
+    }
+    const int top = height_ / 2;
+    return {tile(x0_, y0_, width_, top), tile(x0_, y0_ + top, width_, height_ - top)};
 }
 
 Camera::~Camera() {
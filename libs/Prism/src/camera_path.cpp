@@ -0,0 +1,145 @@
+#include "Prism/camera_path.hpp"
+#include "Prism/camera.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Prism {
+
+namespace {
+
+const ld kPi = std::acos(ld(-1));
+
+// Uniform Catmull-Rom spline from p1 (s = 0) to p2 (s = 1), written relative to p1.
+Point3 catmullRom(const Point3& p0, const Point3& p1, const Point3& p2, const Point3& p3, ld s) {
+    const Vector3 d0 = p0 - p1;
+    const Vector3 d2 = p2 - p1;
+    const Vector3 d3 = p3 - p1;
+    const Vector3 offset = (d2 - d0) * s + (d0 * 2 + d2 * 4 - d3) * (s * s) +
+                           (d3 - d0 - d2 * 3) * (s * s * s);
+    return p1 + offset * ld(0.5);
+}
+
+// The missing neighbour of an end key of an open path: the other key of the end segment
+// mirrored through it, so that the spline leaves or reaches the end key along that segment.
+Point3 mirror(const Point3& end, const Point3& other) {
+    return end + (end - other);
+}
+
+} // namespace
+
+CameraPath CameraPath::turntable(const Point3& target, const Point3& start, ld duration,
+                                 int keys_per_turn) {
+    if (!(duration > 0)) {
+        throw std::invalid_argument("Turntable duration must be positive");
+    }
+    if (keys_per_turn < 4) {
+        throw std::invalid_argument("A turntable needs at least 4 keys per turn");
+    }
+    const Vector3 arm = start - target;
+    CameraPath path;
+    for (int i = 0; i <= keys_per_turn; ++i) {
+        const ld angle = 2 * kPi * i / keys_per_turn;
+        const ld c = std::cos(angle), s = std::sin(angle);
+        CameraKey key;
+        key.time = duration * i / keys_per_turn;
+        key.position = target + Vector3(c * arm.x + s * arm.z, arm.y, c * arm.z - s * arm.x);
+        key.target = target;
+        path.addKey(key);
+    }
+    path.setClosed(true);
+    return path;
+}
+
+void CameraPath::addKey(const CameraKey& key) {
+    if (!keys_.empty() && !(key.time > keys_.back().time)) {
+        throw std::invalid_argument("Camera keys must be added in increasing time");
+    }
+    if (!(key.fov >= 0) || !(key.fov < kPi)) {
+        throw std::invalid_argument("Field of view must be in [0, pi)");
+    }
+    keys_.push_back(key);
+}
+
+ld CameraPath::startTime() const {
+    if (keys_.empty()) {
+        throw std::logic_error("Camera path has no key");
+    }
+    return keys_.front().time;
+}
+
+ld CameraPath::endTime() const {
+    if (keys_.empty()) {
+        throw std::logic_error("Camera path has no key");
+    }
+    return keys_.back().time;
+}
+
+CameraKey CameraPath::at(ld time) const {
+    if (keys_.empty()) {
+        throw std::logic_error("Camera path has no key");
+    }
+    if (keys_.size() == 1 || !(time > keys_.front().time)) {
+        CameraKey key = keys_.front();
+        key.time = time;
+        return key;
+    }
+    if (time >= keys_.back().time) {
+        CameraKey key = keys_.back();
+        key.time = time;
+        return key;
+    }
+
+    // The segment [keys_[i], keys_[i + 1]) holding the time.
+    const auto after =
+        std::upper_bound(keys_.begin(), keys_.end(), time,
+                         [](ld t, const CameraKey& key) { return t < key.time; });
+    const size_t i = static_cast<size_t>(after - keys_.begin()) - 1;
+    const CameraKey& k1 = keys_[i];
+    const CameraKey& k2 = keys_[i + 1];
+    const ld s = (time - k1.time) / (k2.time - k1.time);
+
+    CameraKey key;
+    key.time = time;
+    const auto point = [&](Point3 CameraKey::*member) {
+        const Point3& p1 = k1.*member;
+        const Point3& p2 = k2.*member;
+        const size_t n = keys_.size();
+        Point3 p0 = mirror(p1, p2), p3 = mirror(p2, p1);
+        if (i > 0) {
+            p0 = keys_[i - 1].*member;
+        } else if (closed_ && n > 2) {
+            p0 = keys_[n - 2].*member;
+        }
+        if (i + 2 < n) {
+            p3 = keys_[i + 2].*member;
+        } else if (closed_ && n > 2) {
+            p3 = keys_[1].*member;
+        }
+        return catmullRom(p0, p1, p2, p3, s);
+    };
+    key.position = point(&CameraKey::position);
+    key.target = point(&CameraKey::target);
+    key.fov = k1.fov > 0 && k2.fov > 0 ? k1.fov + (k2.fov - k1.fov) * s : 0;
+    return key;
+}
+
+void CameraPath::apply(ld time, Camera& camera) const {
+    const CameraKey key = at(time);
+    camera.lookAt(key.position, key.target);
+    if (key.fov > 0) {
+        camera.setFieldOfView(key.fov);
+    }
+}
+
+ld CameraPath::frameTime(int frame, int frame_count) const {
+    const ld start = startTime();
+    // The last key of a closed path is the first view again, so a loop stops one frame short.
+    const int intervals = closed_ ? frame_count : frame_count - 1;
+    if (intervals <= 0) {
+        return start;
+    }
+    return start + (endTime() - start) * frame / intervals;
+}
+
+} // namespace Prism
@@ -0,0 +1,13 @@
+#include "Prism/image.hpp"
+#include <stdexcept>
+
+namespace Prism {
+
+Image::Image(int width, int height) : width_(width), height_(height) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Image dimensions must be greater than zero.");
+    }
+    pixels_.resize(static_cast<size_t>(width) * height);
+}
+
+} // namespace Prism
@@ -0,0 +1,257 @@
+#include "Prism/image_writer.hpp"
+#include "Prism/stats.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <stdexcept>
+
+namespace Prism {
+
+namespace {
+
+constexpr uint8_t kPngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+constexpr size_t kIdatSize = 1 << 16;   ///< Zlib bytes gathered before an IDAT chunk is written.
+constexpr size_t kStoredBlock = 0xFFFF; ///< Largest stored deflate block.
+constexpr uint32_t kAdlerModulo = 65521;
+constexpr size_t kAdlerRun = 5552; ///< Bytes summed before the Adler-32 sums can overflow.
+
+const std::array<uint32_t, 256>& crcTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> values{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            values[n] = c;
+        }
+        return values;
+    }();
+    return table;
+}
+
+uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size) {
+    const std::array<uint32_t, 256>& table = crcTable();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void putBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint8_t quantize(ld channel) {
+    // Written so that NaN maps to 0.
+    const ld clamped = channel > 0 ? (channel < 1 ? channel : 1) : 0;
+    return static_cast<uint8_t>(clamped * 255 + ld(0.5));
+}
+
+} // namespace
+
+ImageFormat imageFormatFromPath(const std::string& path) {
+    const size_t dot = path.rfind('.');
+    std::string extension = dot == std::string::npos ? "" : path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == "ppm") {
+        return ImageFormat::PPM;
+    }
+    if (extension == "png") {
+        return ImageFormat::PNG;
+    }
+    throw std::invalid_argument("Unsupported image format: " + path);
+}
+
+ImageWriter::ImageWriter(const std::string& path, int width, int height, int window_rows)
+    : path_(path), format_(imageFormatFromPath(path)), width_(width), height_(height),
+      window_rows_(std::min(window_rows, height)) {
+    if (width <= 0 || height <= 0 || window_rows <= 0) {
+        throw std::invalid_argument("Image dimensions must be greater than zero.");
+    }
+    window_.resize(static_cast<size_t>(window_rows_) * width_ * 3);
+    filled_.assign(window_rows_, 0);
+
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        throw std::runtime_error("Could not write image: " + path);
+    }
+
+    if (format_ == ImageFormat::PPM) {
+        const std::string header =
+            "P6\n" + std::to_string(width_) + " " + std::to_string(height_) + "\n255\n";
+        writeBytes(header.data(), header.size());
+        return;
+    }
+
+    writeBytes(kPngSignature, sizeof(kPngSignature));
+    std::vector<uint8_t> chunk = {'I', 'H', 'D', 'R'};
+    putBigEndian(chunk, static_cast<uint32_t>(width_));
+    putBigEndian(chunk, static_cast<uint32_t>(height_));
+    // 8 bits per channel, RGB, deflate, adaptive filtering, no interlacing.
+    chunk.insert(chunk.end(), {8, 2, 0, 0, 0});
+    std::vector<uint8_t> header;
+    putBigEndian(header, static_cast<uint32_t>(chunk.size() - 4));
+    header.insert(header.end(), chunk.begin(), chunk.end());
+    putBigEndian(header, crc32(0, chunk.data(), chunk.size()));
+    writeBytes(header.data(), header.size());
+
+    // Zlib header: deflate with a 32K window, no preset dictionary, fastest compression.
+    idat_ = {0x78, 0x01};
+}
+
+ImageWriter::~ImageWriter() = default;
+
+void ImageWriter::writeTile(const Tile& tile, const Vector3* pixels) {
+    if (tile.x0 < 0 || tile.y0 < 0 || tile.x1 > width_ || tile.y1 > height_ ||
+        tile.x0 >= tile.x1 || tile.y0 >= tile.y1) {
+        throw std::out_of_range("Tile is outside the image");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_) {
+        throw std::logic_error("Image was already finished");
+    }
+    if (tile.y0 < next_row_ || tile.y1 > next_row_ + window_rows_) {
+        throw std::out_of_range("Tile is outside the row window of the image writer");
+    }
+
+    const int tile_width = tile.x1 - tile.x0;
+    for (int y = tile.y0; y < tile.y1; ++y) {
+        const int slot = y % window_rows_;
+        if (filled_[slot] + tile_width > width_) {
+            throw std::logic_error("Image row received more pixels than its width");
+        }
+        uint8_t* rgb = &window_[(static_cast<size_t>(slot) * width_ + tile.x0) * 3];
+        const Vector3* row = pixels + static_cast<size_t>(y - tile.y0) * tile_width;
+        for (int x = 0; x < tile_width; ++x) {
+            rgb[3 * x] = quantize(row[x].x);
+            rgb[3 * x + 1] = quantize(row[x].y);
+            rgb[3 * x + 2] = quantize(row[x].z);
+        }
+        filled_[slot] += tile_width;
+    }
+
+    flushRows();
+}
+
+void ImageWriter::finish() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_) {
+        return;
+    }
+    if (next_row_ != height_) {
+        throw std::logic_error("Image is missing rows: " + std::to_string(height_ - next_row_));
+    }
+
+    StageTimer timer(StatStage::Write);
+    if (format_ == ImageFormat::PNG) {
+        // Empty final stored block, then the Adler-32 of the uncompressed data.
+        idat_.insert(idat_.end(), {0x01, 0x00, 0x00, 0xFF, 0xFF});
+        putBigEndian(idat_, (adler_b_ << 16) | adler_a_);
+        writeIdat();
+
+        const uint8_t end[12] = {0, 0, 0, 0, 'I', 'E', 'N', 'D', 0xAE, 0x42, 0x60, 0x82};
+        writeBytes(end, sizeof(end));
+    }
+    file_.close();
+    if (!file_) {
+        throw std::runtime_error("Could not write image: " + path_);
+    }
+    finished_ = true;
+}
+
+int ImageWriter::rowsWritten() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return next_row_;
+}
+
+void ImageWriter::flushRows() {
+    if (filled_[next_row_ % window_rows_] != width_) {
+        return;
+    }
+    StageTimer timer(StatStage::Write);
+    while (next_row_ < height_ && filled_[next_row_ % window_rows_] == width_) {
+        const int slot = next_row_ % window_rows_;
+        writeRow(&window_[static_cast<size_t>(slot) * width_ * 3]);
+        filled_[slot] = 0;
+        ++next_row_;
+    }
+}
+
+void ImageWriter::writeRow(const uint8_t* rgb) {
+    const size_t row_bytes = static_cast<size_t>(width_) * 3;
+    if (format_ == ImageFormat::PPM) {
+        writeBytes(rgb, row_bytes);
+        return;
+    }
+
+    // PNG scanline: filter type 0 (none) followed by the pixels, split into stored blocks.
+    size_t remaining = row_bytes + 1;
+    bool filter_byte = true;
+    while (remaining > 0) {
+        const uint16_t length = static_cast<uint16_t>(std::min(remaining, kStoredBlock));
+        const uint16_t inverse = static_cast<uint16_t>(~length);
+        idat_.insert(idat_.end(),
+                     {0x00, static_cast<uint8_t>(length), static_cast<uint8_t>(length >> 8),
+                      static_cast<uint8_t>(inverse), static_cast<uint8_t>(inverse >> 8)});
+        size_t data_length = length;
+        if (filter_byte) {
+            idat_.push_back(0);
+            --data_length;
+            filter_byte = false;
+        }
+        idat_.insert(idat_.end(), rgb, rgb + data_length);
+        rgb += data_length;
+        remaining -= length;
+        if (idat_.size() >= kIdatSize) {
+            writeIdat();
+        }
+    }
+
+    // The filter byte is 0 and only adds to the second sum.
+    adler_b_ = (adler_b_ + adler_a_) % kAdlerModulo;
+    const uint8_t* data = rgb - row_bytes;
+    for (size_t start = 0; start < row_bytes; start += kAdlerRun) {
+        const size_t stop = std::min(row_bytes, start + kAdlerRun);
+        for (size_t i = start; i < stop; ++i) {
+            adler_a_ += data[i];
+            adler_b_ += adler_a_;
+        }
+        adler_a_ %= kAdlerModulo;
+        adler_b_ %= kAdlerModulo;
+    }
+}
+
+void ImageWriter::writeIdat() {
+    std::vector<uint8_t> chunk;
+    chunk.reserve(idat_.size() + 12);
+    putBigEndian(chunk, static_cast<uint32_t>(idat_.size()));
+    chunk.insert(chunk.end(), {'I', 'D', 'A', 'T'});
+    chunk.insert(chunk.end(), idat_.begin(), idat_.end());
+    putBigEndian(chunk, crc32(0, chunk.data() + 4, idat_.size() + 4));
+    writeBytes(chunk.data(), chunk.size());
+    idat_.clear();
+}
+
+void ImageWriter::writeBytes(const void* data, size_t size) {
+    if (!file_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size))) {
+        throw std::runtime_error("Could not write image: " + path_);
+    }
+}
+
+void writeImage(const std::string& path, const Image& image) {
+    ImageWriter writer(path, image.width(), image.height(), 1);
+    for (int y = 0; y < image.height(); ++y) {
+        const Tile row{0, y, image.width(), y + 1};
+        writer.writeTile(row, &image.pixels()[static_cast<size_t>(y) * image.width()]);
+    }
+    writer.finish();
+}
+
+} // namespace Prism
@@ -0,0 +1,135 @@
+#include "Prism/instance.hpp"
+#include "Prism/point.hpp"
+#include "Prism/vector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Prism {
+
+namespace {
+
+// Relative tolerance when checking that a transform is a similarity; rotations built from sines
+// and cosines are only orthogonal up to rounding.
+constexpr ld kSimilarityTolerance = ld(1e-5);
+
+bool isSimilarity(const Mat4& m) {
+    const Vector3 columns[3] = {Vector3(m(0, 0), m(1, 0), m(2, 0)),
+                                Vector3(m(0, 1), m(1, 1), m(2, 1)),
+                                Vector3(m(0, 2), m(1, 2), m(2, 2))};
+    const ld norm = columns[0].dot(columns[0]);
+    const ld tolerance = kSimilarityTolerance * norm;
+    for (int i = 0; i < 3; ++i) {
+        if (std::abs(columns[i].dot(columns[i]) - norm) > tolerance ||
+            std::abs(columns[i].dot(columns[(i + 1) % 3])) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+Instance::Instance(const Object& geometry, const Mat4& object_to_world) : geometry_(&geometry) {
+    setTransform(object_to_world);
+}
+
+void Instance::setTransform(const Mat4& object_to_world) {
+    if (object_to_world(3, 0) != 0 || object_to_world(3, 1) != 0 ||
+        object_to_world(3, 2) != 0 || object_to_world(3, 3) != 1) {
+        throw std::invalid_argument("Instance transforms must be affine.");
+    }
+    world_to_object_ = object_to_world.inverse();
+    object_to_world_ = object_to_world;
+    similarity_ = isSimilarity(world_to_object_);
+
+    AABB local;
+    bounded_ = geometry_->boundingBox(local);
+    bounds_ = AABB();
+    if (bounded_) {
+        for (int corner = 0; corner < 8; ++corner) {
+            const Point3 p(corner & 1 ? local.max.x : local.min.x,
+                           corner & 2 ? local.max.y : local.min.y,
+                           corner & 4 ? local.max.z : local.min.z);
+            bounds_.expand(transformPoint(object_to_world_, p));
+        }
+    }
+}
+
+Ray Instance::toObject(const Ray& ray, ld& scale) const {
+    const Vector3 direction = transformVector(world_to_object_, ray.direction);
+    scale = direction.magnitude();
+    return Ray(transformPoint(world_to_object_, ray.origin), direction);
+}
+
+void Instance::toWorld(HitRecord& rec, ld scale) const {
+    // The object-space normal already faces the ray, and the inverse transpose keeps it on the
+    // same side of the transformed ray, so front_face carries over.
+    rec.t /= scale;
+    rec.p = transformPoint(object_to_world_, rec.p);
+    rec.normal = transformNormal(world_to_object_, rec.normal).normalize();
+}
+
+bool Instance::hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const {
+    ld scale;
+    const Ray local = toObject(ray, scale);
+    if (!geometry_->hit(local, t_min * scale, t_max * scale, rec)) {
+        return false;
+    }
+    toWorld(rec, scale);
+    return true;
+}
+
+bool Instance::occluded(const Ray& ray, ld t_min, ld t_max) const {
+    ld scale;
+    const Ray local = toObject(ray, scale);
+    return geometry_->occluded(local, t_min * scale, t_max * scale);
+}
+
+void Instance::hitPacket(const RayPacket& packet, ld t_min, PacketHit& hits) const {
+    if (!similarity_) {
+        Object::hitPacket(packet, t_min, hits);
+        return;
+    }
+
+    // Every lane is scaled alike up to rounding; the smallest factor keeps t_min conservative.
+    // Inactive lanes stay zeroed: the geometry may read all of them without branching.
+    RayPacket local{};
+    PacketHit local_hits{};
+    ld scale[RayPacket::kSize];
+    ld min_scale = std::numeric_limits<ld>::infinity();
+    for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+        if (packet.active[lane]) {
+            local.set(lane, toObject(packet.ray(lane), scale[lane]));
+            local_hits.t_max[lane] = hits.t_max[lane] * scale[lane];
+            min_scale = std::min(min_scale, scale[lane]);
+        }
+    }
+    local.x0 = packet.x0;
+    local.y0 = packet.y0;
+    if (local.firstActive() < 0) {
+        return;
+    }
+
+    geometry_->hitPacket(local, t_min * min_scale, local_hits);
+    for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+        if (local_hits.hit[lane]) {
+            HitRecord& rec = local_hits.records[lane];
+            toWorld(rec, scale[lane]);
+            hits.records[lane] = rec;
+            hits.t_max[lane] = rec.t;
+            hits.hit[lane] = true;
+        }
+    }
+}
+
+bool Instance::boundingBox(AABB& box) const {
+    if (!bounded_) {
+        return false;
+    }
+    box = bounds_;
+    return true;
+}
+
+} // namespace Prism
@@ -0,0 +1,38 @@
+#include "Prism/material.hpp"
+#include <stdexcept>
+
+namespace Prism {
+
+namespace {
+
+Vector3 color(const float* rgb) {
+    return Vector3(rgb[0], rgb[1], rgb[2]);
+}
+
+} // namespace
+
+Material::Material(const MeshMaterial& material)
+    : ka(color(material.ka)), kd(color(material.kd)), ks(color(material.ks)),
+      ke(color(material.ke)), ns(material.ns), ni(material.ni), d(material.d) {
+}
+
+uint16_t MaterialTable::add(const Material& material) {
+    if (materials_.size() >= kNoMaterial) {
+        throw std::length_error("Material table is full");
+    }
+    materials_.push_back(material);
+    return static_cast<uint16_t>(materials_.size() - 1);
+}
+
+uint16_t MaterialTable::add(const MeshMaterial* materials, size_t count) {
+    if (materials_.size() + count > kNoMaterial) {
+        throw std::length_error("Material table is full");
+    }
+    const uint16_t first = static_cast<uint16_t>(materials_.size());
+    for (size_t i = 0; i < count; ++i) {
+        materials_.push_back(materials != nullptr ? Material(materials[i]) : Material());
+    }
+    return first;
+}
+
+} // namespace Prism
@@ -0,0 +1,240 @@
+#include "Prism/mesh_cache.hpp"
+#include "Prism/stats.hpp"
+#include "replace_file.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Prism {
+
+namespace {
+
+constexpr char kMagic[8] = {'P', 'R', 'I', 'S', 'M', 'M', 'S', 'H'};
+constexpr uint32_t kByteOrder = 0x01020304;
+constexpr uint64_t kAlignment = 16;
+
+enum Section {
+    kPositions,
+    kNormals,
+    kIndices,
+    kNormalIndices,
+    kMaterialIds,
+    kMaterials,
+    kStrings,
+    kSectionCount
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    SourceFingerprint source;
+    uint64_t vertex_count;
+    uint64_t normal_count;
+    uint64_t triangle_count;
+    uint64_t material_count;
+    uint64_t material_coefficient_count;
+    uint64_t offsets[kSectionCount];
+    uint64_t sizes[kSectionCount];
+};
+
+static_assert(std::is_trivially_copyable<SourceFingerprint>::value &&
+                  sizeof(SourceFingerprint) == 4 * sizeof(uint64_t),
+              "SourceFingerprint is written as is");
+static_assert(std::is_trivially_copyable<Header>::value, "The cache header is written as is");
+static_assert(std::is_trivially_copyable<MeshMaterial>::value &&
+                  sizeof(MeshMaterial) == 15 * sizeof(float),
+              "MeshMaterial is written as is");
+
+uint64_t alignUp(uint64_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+[[noreturn]] void corrupt(const std::string& path, const char* what) {
+    throw std::runtime_error("Invalid mesh cache " + path + ": " + what);
+}
+
+template <typename T>
+ArrayView<T> section(const MappedFile& file, const Header& header, Section id, uint64_t count,
+                     const std::string& path) {
+    const uint64_t offset = header.offsets[id];
+    const uint64_t size = header.sizes[id];
+    if (offset % kAlignment != 0 || offset < sizeof(Header) || offset > file.size() ||
+        size > file.size() - offset) {
+        corrupt(path, "section outside of the file");
+    }
+    if (count > size / sizeof(T) || count * sizeof(T) != size) {
+        corrupt(path, "section size does not match the element count");
+    }
+    return ArrayView<T>(reinterpret_cast<const T*>(file.data() + offset), count);
+}
+
+template <typename T> void writeSection(std::ofstream& out, const T* data, size_t count) {
+    const std::streamoff padding = static_cast<std::streamoff>(alignUp(out.tellp()) - out.tellp());
+    const char zeros[kAlignment] = {};
+    out.write(zeros, padding);
+    out.write(reinterpret_cast<const char*>(data),
+              static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+// Size and write time of a file, left at 0 when it cannot be read.
+void stamp(const std::string& path, uint64_t& size, int64_t& time) {
+    std::error_code error;
+    const uintmax_t bytes = std::filesystem::file_size(path, error);
+    if (error) {
+        return;
+    }
+    const std::filesystem::file_time_type written = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return;
+    }
+    size = static_cast<uint64_t>(bytes);
+    time = static_cast<int64_t>(written.time_since_epoch().count());
+}
+
+} // namespace
+
+SourceFingerprint fingerprintSources(const std::string& obj_path, const std::string& mtl_path) {
+    SourceFingerprint source;
+    stamp(obj_path, source.obj_size, source.obj_time);
+    stamp(mtl_path, source.mtl_size, source.mtl_time);
+    return source;
+}
+
+void writeMeshCache(const std::string& path, const MeshData& mesh,
+                    const SourceFingerprint& source) {
+    StageTimer timer(StatStage::Write);
+    const size_t triangles = mesh.triangleCount();
+    if (mesh.positions.size() % 3 != 0 || mesh.normals.size() % 3 != 0 ||
+        mesh.indices.size() != 3 * triangles || mesh.normal_indices.size() != 3 * triangles ||
+        mesh.material_ids.size() != triangles ||
+        (!mesh.materials.empty() && mesh.materials.size() != mesh.material_names.size())) {
+        throw std::invalid_argument("Mesh arrays have inconsistent sizes");
+    }
+
+    std::string strings = mesh.material_library + '\0';
+    for (const std::string& name : mesh.material_names) {
+        strings += name + '\0';
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = MeshCache::kVersion;
+    header.byte_order = kByteOrder;
+    header.source = source;
+    header.vertex_count = mesh.vertexCount();
+    header.normal_count = mesh.normalCount();
+    header.triangle_count = triangles;
+    header.material_count = mesh.material_names.size();
+    header.material_coefficient_count = mesh.materials.size();
+    header.sizes[kPositions] = mesh.positions.size() * sizeof(float);
+    header.sizes[kNormals] = mesh.normals.size() * sizeof(float);
+    header.sizes[kIndices] = mesh.indices.size() * sizeof(uint32_t);
+    header.sizes[kNormalIndices] = mesh.normal_indices.size() * sizeof(uint32_t);
+    header.sizes[kMaterialIds] = mesh.material_ids.size() * sizeof(uint32_t);
+    header.sizes[kMaterials] = mesh.materials.size() * sizeof(MeshMaterial);
+    header.sizes[kStrings] = strings.size();
+    uint64_t offset = sizeof(Header);
+    for (int i = 0; i < kSectionCount; ++i) {
+        header.offsets[i] = alignUp(offset);
+        offset = header.offsets[i] + header.sizes[i];
+    }
+
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Could not write mesh cache: " + path);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeSection(out, mesh.positions.data(), mesh.positions.size());
+        writeSection(out, mesh.normals.data(), mesh.normals.size());
+        writeSection(out, mesh.indices.data(), mesh.indices.size());
+        writeSection(out, mesh.normal_indices.data(), mesh.normal_indices.size());
+        writeSection(out, mesh.material_ids.data(), mesh.material_ids.size());
+        writeSection(out, mesh.materials.data(), mesh.materials.size());
+        writeSection(out, strings.data(), strings.size());
+        if (!out.flush()) {
+            out.close();
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Could not write mesh cache: " + path);
+        }
+    }
+    if (!replaceFile(temporary, path)) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Could not write mesh cache: " + path);
+    }
+}
+
+MeshCache::MeshCache(const std::string& path) : file_(path) {
+    StageTimer timer(StatStage::Load);
+    Header header;
+    if (file_.size() < sizeof(Header)) {
+        corrupt(path, "file is too small");
+    }
+    std::memcpy(&header, file_.data(), sizeof(Header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        corrupt(path, "not a mesh cache");
+    }
+    if (header.version != kVersion) {
+        corrupt(path, "unsupported version");
+    }
+    if (header.byte_order != kByteOrder) {
+        corrupt(path, "written with a different byte order");
+    }
+    if (header.vertex_count > file_.size() || header.normal_count > file_.size() ||
+        header.triangle_count > file_.size() ||
+        (header.material_coefficient_count != 0 &&
+         header.material_coefficient_count != header.material_count)) {
+        corrupt(path, "inconsistent element counts");
+    }
+    source_ = header.source;
+
+    positions_ = section<float>(file_, header, kPositions, 3 * header.vertex_count, path);
+    normals_ = section<float>(file_, header, kNormals, 3 * header.normal_count, path);
+    indices_ = section<uint32_t>(file_, header, kIndices, 3 * header.triangle_count, path);
+    normal_indices_ =
+        section<uint32_t>(file_, header, kNormalIndices, 3 * header.triangle_count, path);
+    material_ids_ = section<uint32_t>(file_, header, kMaterialIds, header.triangle_count, path);
+    materials_ = section<MeshMaterial>(file_, header, kMaterials,
+                                       header.material_coefficient_count, path);
+    ArrayView<char> strings = section<char>(file_, header, kStrings, header.sizes[kStrings], path);
+
+    // The string block holds the material library followed by one name per material.
+    std::vector<std::string> names;
+    const char* begin = strings.begin();
+    while (begin < strings.end()) {
+        const void* terminator =
+            std::memchr(begin, '\0', static_cast<size_t>(strings.end() - begin));
+        if (terminator == nullptr) {
+            corrupt(path, "unterminated string");
+        }
+        names.emplace_back(begin, static_cast<const char*>(terminator));
+        begin = static_cast<const char*>(terminator) + 1;
+    }
+    if (names.size() != header.material_count + 1) {
+        corrupt(path, "wrong number of material names");
+    }
+    material_library_ = std::move(names.front());
+    material_names_.assign(std::make_move_iterator(names.begin() + 1),
+                           std::make_move_iterator(names.end()));
+}
+
+MeshData MeshCache::toMeshData() const {
+    MeshData mesh;
+    mesh.positions.assign(positions_.begin(), positions_.end());
+    mesh.normals.assign(normals_.begin(), normals_.end());
+    mesh.indices.assign(indices_.begin(), indices_.end());
+    mesh.normal_indices.assign(normal_indices_.begin(), normal_indices_.end());
+    mesh.material_ids.assign(material_ids_.begin(), material_ids_.end());
+    mesh.materials.assign(materials_.begin(), materials_.end());
+    mesh.material_names = material_names_;
+    mesh.material_library = material_library_;
+    return mesh;
+}
+
+} // namespace Prism
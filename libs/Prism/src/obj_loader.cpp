@@ -0,0 +1,381 @@
+#include "Prism/obj_loader.hpp"
+#include "Prism/mapped_file.hpp"
+#include "Prism/stats.hpp"
+#include "Prism/thread_pool.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Prism {
+
+namespace {
+
+/// Material id of the triangles that come before the first usemtl of a chunk: they keep the
+/// material that was active at the end of the previous chunk.
+constexpr uint32_t kInheritMaterial = MeshData::kNoIndex - 1;
+constexpr int64_t kMaxIndex = int64_t(MeshData::kNoIndex) - 1;
+
+/// An index written relative to the vertices read so far, resolved once the number of vertices
+/// in the previous chunks is known.
+struct RelativeIndex {
+    size_t slot;
+    int64_t local;
+};
+
+/// Everything parsed from one chunk, with chunk-local vertex counts and material ids.
+struct Chunk {
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> normal_indices;
+    std::vector<uint32_t> material_ids;
+    std::vector<RelativeIndex> relative_indices;
+    std::vector<RelativeIndex> relative_normal_indices;
+    std::vector<std::string> material_names;
+    uint32_t last_material = kInheritMaterial;
+    std::string material_library;
+};
+
+[[noreturn]] void fail(const char* what) {
+    throw std::runtime_error(std::string("Malformed OBJ data: ") + what);
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && isBlank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+bool hasKeyword(const char* p, const char* end, const char* keyword) {
+    const size_t length = std::strlen(keyword);
+    return static_cast<size_t>(end - p) >= length && std::memcmp(p, keyword, length) == 0 &&
+           (p + length == end || isBlank(p[length]));
+}
+
+float parseFloat(const char*& p, const char* end) {
+    p = skipBlanks(p, end);
+    if (p < end && *p == '+') {
+        ++p;
+    }
+    double value = 0;
+    const std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) {
+        fail("expected a number");
+    }
+    p = result.ptr;
+    return static_cast<float>(value);
+}
+
+int64_t parseIndex(const char*& p, const char* end) {
+    const bool negative = p < end && *p == '-';
+    if (negative) {
+        ++p;
+    }
+    if (p == end || !isDigit(*p)) {
+        fail("expected an index");
+    }
+    int64_t value = 0;
+    while (p < end && isDigit(*p)) {
+        value = value * 10 + (*p - '0');
+        if (value > kMaxIndex) {
+            fail("index out of range");
+        }
+        ++p;
+    }
+    if (value == 0) {
+        fail("indices start at 1");
+    }
+    return negative ? -value : value;
+}
+
+/**
+ * Parses the lines of one chunk. Statements are dispatched on their first character and numbers
+ * are read in place, so no line is ever copied.
+ */
+class ChunkParser {
+  public:
+    explicit ChunkParser(Chunk& chunk) : chunk_(chunk) {
+    }
+
+    void parse(const char* begin, const char* end) {
+        while (begin < end) {
+            const void* newline = std::memchr(begin, '\n', static_cast<size_t>(end - begin));
+            const char* line_end = newline ? static_cast<const char*>(newline) : end;
+            parseLine(begin, line_end);
+            begin = line_end + 1;
+        }
+        chunk_.last_material = material_;
+    }
+
+  private:
+    struct Corner {
+        int64_t vertex;
+        int64_t normal;
+    };
+
+    void parseLine(const char* p, const char* end) {
+        p = skipBlanks(p, end);
+        if (p == end) {
+            return;
+        }
+        switch (*p) {
+            case 'v':
+                if (hasKeyword(p, end, "v")) {
+                    parseTriple(p + 1, end, chunk_.positions);
+                } else if (hasKeyword(p, end, "vn")) {
+                    parseTriple(p + 2, end, chunk_.normals);
+                }
+                break;
+            case 'f':
+                if (hasKeyword(p, end, "f")) {
+                    parseFace(p + 1, end);
+                }
+                break;
+            case 'u':
+                if (hasKeyword(p, end, "usemtl")) {
+                    useMaterial(parseName(p + 6, end));
+                }
+                break;
+            case 'm':
+                if (hasKeyword(p, end, "mtllib") && chunk_.material_library.empty()) {
+                    chunk_.material_library = parseName(p + 6, end);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    void parseTriple(const char* p, const char* end, std::vector<float>& out) {
+        const float x = parseFloat(p, end);
+        const float y = parseFloat(p, end);
+        const float z = parseFloat(p, end);
+        out.push_back(x);
+        out.push_back(y);
+        out.push_back(z);
+    }
+
+    static std::string parseName(const char* p, const char* end) {
+        p = skipBlanks(p, end);
+        while (end > p && isBlank(end[-1])) {
+            --end;
+        }
+        if (p == end) {
+            fail("expected a name");
+        }
+        return std::string(p, end);
+    }
+
+    void parseFace(const char* p, const char* end) {
+        corners_.clear();
+        p = skipBlanks(p, end);
+        while (p < end) {
+            Corner corner{parseIndex(p, end), 0};
+            if (p < end && *p == '/') {
+                ++p;
+                if (p < end && *p != '/') {
+                    parseIndex(p, end); // Texture coordinates are not used.
+                }
+                if (p < end && *p == '/') {
+                    ++p;
+                    corner.normal = parseIndex(p, end);
+                }
+            }
+            if (p < end && !isBlank(*p)) {
+                fail("unexpected character in face");
+            }
+            corners_.push_back(corner);
+            p = skipBlanks(p, end);
+        }
+        if (corners_.size() < 3) {
+            fail("a face needs at least three vertices");
+        }
+
+        for (size_t i = 1; i + 1 < corners_.size(); ++i) {
+            addCorner(corners_[0]);
+            addCorner(corners_[i]);
+            addCorner(corners_[i + 1]);
+            chunk_.material_ids.push_back(material_);
+        }
+    }
+
+    void addCorner(const Corner& corner) {
+        addIndex(corner.vertex, chunk_.positions.size() / 3, chunk_.indices,
+                 chunk_.relative_indices);
+        if (corner.normal == 0) {
+            chunk_.normal_indices.push_back(MeshData::kNoIndex);
+        } else {
+            addIndex(corner.normal, chunk_.normals.size() / 3, chunk_.normal_indices,
+                     chunk_.relative_normal_indices);
+        }
+    }
+
+    static void addIndex(int64_t index, size_t count, std::vector<uint32_t>& out,
+                         std::vector<RelativeIndex>& relative) {
+        if (index > 0) {
+            out.push_back(static_cast<uint32_t>(index - 1));
+        } else {
+            relative.push_back({out.size(), static_cast<int64_t>(count) + index});
+            out.push_back(0);
+        }
+    }
+
+    void useMaterial(const std::string& name) {
+        auto it = std::find(chunk_.material_names.begin(), chunk_.material_names.end(), name);
+        material_ = static_cast<uint32_t>(it - chunk_.material_names.begin());
+        if (it == chunk_.material_names.end()) {
+            chunk_.material_names.push_back(name);
+        }
+    }
+
+    Chunk& chunk_;
+    std::vector<Corner> corners_;
+    uint32_t material_ = kInheritMaterial;
+};
+
+void runAll(ThreadPool* pool, size_t count, const std::function<void(size_t)>& body) {
+    if (pool != nullptr && count > 1) {
+        pool->parallelFor(count, body);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            body(i);
+        }
+    }
+}
+
+uint32_t resolve(const RelativeIndex& index, size_t offset) {
+    const int64_t absolute = static_cast<int64_t>(offset) + index.local;
+    if (absolute < 0) {
+        fail("relative index points before the first element");
+    }
+    return static_cast<uint32_t>(absolute);
+}
+
+} // namespace
+
+MeshData parseObj(const char* data, size_t size, ThreadPool* pool, size_t chunk_bytes) {
+    StageTimer timer(StatStage::Load);
+    if (chunk_bytes == 0) {
+        throw std::invalid_argument("OBJ chunk size must be positive");
+    }
+
+    // Cut the text right after a newline so that no statement spans two chunks.
+    std::vector<std::pair<const char*, const char*>> ranges;
+    const char* end = data + size;
+    for (const char* begin = data; begin < end;) {
+        const char* cut = begin + std::min(chunk_bytes, static_cast<size_t>(end - begin));
+        if (cut < end) {
+            const void* newline = std::memchr(cut, '\n', static_cast<size_t>(end - cut));
+            cut = newline ? static_cast<const char*>(newline) + 1 : end;
+        }
+        ranges.emplace_back(begin, cut);
+        begin = cut;
+    }
+
+    std::vector<Chunk> chunks(ranges.size());
+    runAll(pool, chunks.size(), [&](size_t i) {
+        ChunkParser(chunks[i]).parse(ranges[i].first, ranges[i].second);
+    });
+
+    // Offsets of every chunk in the merged arrays, and the chunk-to-mesh material mapping.
+    MeshData mesh;
+    std::vector<size_t> position_offset(chunks.size() + 1, 0);
+    std::vector<size_t> normal_offset(chunks.size() + 1, 0);
+    std::vector<size_t> index_offset(chunks.size() + 1, 0);
+    std::vector<size_t> triangle_offset(chunks.size() + 1, 0);
+    std::vector<std::vector<uint32_t>> material_remap(chunks.size());
+    std::vector<uint32_t> inherited_material(chunks.size());
+    std::unordered_map<std::string, uint32_t> material_lookup;
+    uint32_t active_material = MeshData::kNoIndex;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const Chunk& chunk = chunks[i];
+        position_offset[i + 1] = position_offset[i] + chunk.positions.size();
+        normal_offset[i + 1] = normal_offset[i] + chunk.normals.size();
+        index_offset[i + 1] = index_offset[i] + chunk.indices.size();
+        triangle_offset[i + 1] = triangle_offset[i] + chunk.material_ids.size();
+
+        for (const std::string& name : chunk.material_names) {
+            auto inserted = material_lookup.emplace(
+                name, static_cast<uint32_t>(mesh.material_names.size()));
+            if (inserted.second) {
+                mesh.material_names.push_back(name);
+            }
+            material_remap[i].push_back(inserted.first->second);
+        }
+        inherited_material[i] = active_material;
+        if (chunk.last_material != kInheritMaterial) {
+            active_material = material_remap[i][chunk.last_material];
+        }
+        if (mesh.material_library.empty()) {
+            mesh.material_library = chunk.material_library;
+        }
+    }
+    if (position_offset.back() / 3 > static_cast<size_t>(kMaxIndex) ||
+        normal_offset.back() / 3 > static_cast<size_t>(kMaxIndex)) {
+        fail("too many vertices");
+    }
+
+    mesh.positions.resize(position_offset.back());
+    mesh.normals.resize(normal_offset.back());
+    mesh.indices.resize(index_offset.back());
+    mesh.normal_indices.resize(index_offset.back());
+    mesh.material_ids.resize(triangle_offset.back());
+    const size_t vertex_count = mesh.vertexCount();
+    const size_t normal_count = mesh.normalCount();
+
+    runAll(pool, chunks.size(), [&](size_t i) {
+        Chunk& chunk = chunks[i];
+        std::copy(chunk.positions.begin(), chunk.positions.end(),
+                  mesh.positions.begin() + position_offset[i]);
+        std::copy(chunk.normals.begin(), chunk.normals.end(),
+                  mesh.normals.begin() + normal_offset[i]);
+
+        for (const RelativeIndex& index : chunk.relative_indices) {
+            chunk.indices[index.slot] = resolve(index, position_offset[i] / 3);
+        }
+        for (const RelativeIndex& index : chunk.relative_normal_indices) {
+            chunk.normal_indices[index.slot] = resolve(index, normal_offset[i] / 3);
+        }
+        for (uint32_t index : chunk.indices) {
+            if (index >= vertex_count) {
+                fail("vertex index out of range");
+            }
+        }
+        for (uint32_t index : chunk.normal_indices) {
+            if (index != MeshData::kNoIndex && index >= normal_count) {
+                fail("normal index out of range");
+            }
+        }
+        std::copy(chunk.indices.begin(), chunk.indices.end(),
+                  mesh.indices.begin() + index_offset[i]);
+        std::copy(chunk.normal_indices.begin(), chunk.normal_indices.end(),
+                  mesh.normal_indices.begin() + index_offset[i]);
+
+        auto material = mesh.material_ids.begin() + triangle_offset[i];
+        for (uint32_t id : chunk.material_ids) {
+            *material++ = id == kInheritMaterial ? inherited_material[i] : material_remap[i][id];
+        }
+        chunk = Chunk();
+    });
+
+    return mesh;
+}
+
+MeshData loadObj(const std::string& path, ThreadPool* pool) {
+    MappedFile file(path);
+    return parseObj(file.data(), file.size(), pool);
+}
+
+} // namespace Prism
@@ -0,0 +1,101 @@
+#include "ObjReader/ObjReader.hpp"
+#include "Prism/mesh_cache.hpp"
+#include <stdexcept>
+
+namespace Prism {
+
+namespace {
+
+void store(const vetor& color, float* out) {
+    out[0] = static_cast<float>(color.getX());
+    out[1] = static_cast<float>(color.getY());
+    out[2] = static_cast<float>(color.getZ());
+}
+
+MeshMaterial materialOf(const MaterialProperties& properties) {
+    MeshMaterial material;
+    store(properties.ka, material.ka);
+    store(properties.kd, material.kd);
+    store(properties.ks, material.ks);
+    store(properties.ke, material.ke);
+    material.ns = static_cast<float>(properties.ns);
+    material.ni = static_cast<float>(properties.ni);
+    material.d = static_cast<float>(properties.d);
+    return material;
+}
+
+uint32_t checkedIndex(int index, size_t count, bool optional) {
+    if (optional && index < 0) {
+        return MeshData::kNoIndex;
+    }
+    if (index < 0 || static_cast<size_t>(index) >= count) {
+        throw std::runtime_error("objReader face refers to a missing vertex or normal");
+    }
+    return static_cast<uint32_t>(index);
+}
+
+void convertVertices(const std::vector<point>& vertices, const std::vector<vetor>& normals,
+                     MeshData& mesh) {
+    mesh.positions.reserve(3 * vertices.size());
+    for (const point& p : vertices) {
+        mesh.positions.push_back(static_cast<float>(p.getX()));
+        mesh.positions.push_back(static_cast<float>(p.getY()));
+        mesh.positions.push_back(static_cast<float>(p.getZ()));
+    }
+    mesh.normals.reserve(3 * normals.size());
+    for (const vetor& n : normals) {
+        mesh.normals.push_back(static_cast<float>(n.getX()));
+        mesh.normals.push_back(static_cast<float>(n.getY()));
+        mesh.normals.push_back(static_cast<float>(n.getZ()));
+    }
+}
+
+void convertFaces(const std::vector<Face>& faces, const colormap& library, MeshData& mesh) {
+    const size_t vertex_count = mesh.vertexCount();
+    const size_t normal_count = mesh.normalCount();
+    mesh.indices.reserve(3 * faces.size());
+    mesh.normal_indices.reserve(3 * faces.size());
+    mesh.material_ids.reserve(faces.size());
+    // Colormap ids cover every material of the library; the mesh keeps the used ones, in order
+    // of first use.
+    std::vector<uint32_t> mesh_ids(library.size(), MeshData::kNoIndex);
+    for (const Face& face : faces) {
+        for (int i = 0; i < 3; ++i) {
+            mesh.indices.push_back(checkedIndex(face.verticeIndice[i], vertex_count, false));
+            mesh.normal_indices.push_back(checkedIndex(face.normalIndice[i], normal_count, true));
+        }
+
+        if (face.materialId < 0 || face.materialId >= library.size()) {
+            mesh.material_ids.push_back(MeshData::kNoIndex);
+            continue;
+        }
+        uint32_t& id = mesh_ids[face.materialId];
+        if (id == MeshData::kNoIndex) {
+            id = static_cast<uint32_t>(mesh.materials.size());
+            mesh.materials.push_back(materialOf(library.getMaterial(face.materialId)));
+            mesh.material_names.push_back(library.names[face.materialId]);
+        }
+        mesh.material_ids.push_back(id);
+    }
+}
+
+} // namespace
+
+MeshData meshDataFromObjReader(const objReader& reader) {
+    MeshData mesh;
+    convertVertices(reader.getVertices(), reader.getNormals(), mesh);
+    convertFaces(reader.getFaces(), reader.getColormap(), mesh);
+    return mesh;
+}
+
+MeshData meshDataFromObjReader(objReader&& reader) {
+    // Every buffer is released as soon as it is converted, keeping the peak memory close to the
+    // size of the reader alone.
+    reader.takeFacePoints();
+    MeshData mesh;
+    convertVertices(reader.takeVertices(), reader.takeNormals(), mesh);
+    convertFaces(reader.takeFaces(), reader.getColormap(), mesh);
+    return mesh;
+}
+
+} // namespace Prism
@@ -7,9 +7,6 @@ namespace Prism {
 Point3::Point3(ld x, ld y, ld z) : x(x), y(y), z(z) {
 }
 
-Point3::Point3(const Point3& p) : x(p.x), y(p.y), z(p.z) {
-}
-
 Point3::Point3(const Vector3& v) : x(v.x), y(v.y), z(v.z) {
 }
 
@@ -23,15 +20,6 @@ Point3::Point3(std::initializer_list<ld> coords) {
     z = *it;
 }
 
-Point3 Point3::operator=(const Point3& p) {
-    if (this != &p) {
-        x = p.x;
-        y = p.y;
-        z = p.z;
-    }
-    return *this;
-}
-
 bool Point3::operator==(const Point3& p) const {
     return (x == p.x && y == p.y && z == p.z);
 }
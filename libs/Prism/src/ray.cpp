@@ -3,45 +3,29 @@
 #include "Prism/matrix.hpp"
 #include "Prism/objects.hpp"
 #include "Prism/point.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/stats.hpp"
 #include "Prism/utils.hpp"
 #include "Prism/vector.hpp"
 #include <cmath>
 #include <stdexcept>
 
-using ld = long double;
-
 namespace Prism {
 
-Ray::Ray(const Point3& origin_pt, const Vector3& direction_vec) {
-    Point3* newpoint = new Point3;
-    Vector3* newvec = new Vector3;
-
-    *newpoint = origin_pt;
-    origin = newpoint;
-    *newvec = direction_vec.normalize();
-    direction = newvec;
-}
-
-Ray::Ray(const Point3& origin_pt, const Point3& target_point) {
-    Point3* newpoint = new Point3;
-    Vector3* newvec = new Vector3;
-
-    *newpoint = origin_pt;
-    origin = newpoint;
-
-    *newvec = (target_point - origin_pt).normalize();
-
-    direction = newvec;
+Ray::Ray(const Point3& origin_pt, const Vector3& direction_vec)
+    : origin(origin_pt), direction(direction_vec.normalize()),
+      inv_direction(1 / direction.x, 1 / direction.y, 1 / direction.z) {
 }
 
-Vector3* Ray::Direction() const {
-    return direction;
+Ray::Ray(const Point3& origin_pt, const Point3& target_point)
+    : Ray(origin_pt, target_point - origin_pt) {
 }
 
 HitRecord Ray::Gethit(const std::vector<Object*>& objects, const ld& t_min, const ld& t_max) {
 
     HitRecord first_hit;
     first_hit.t = t_max;
+    countStat(StatCounter::ObjectTests, objects.size());
     for (int i = 0; i < objects.size(); i++) {
         HitRecord rec;
         bool hit_happened = (objects[i]->hit(*this, t_min, t_max, rec));
@@ -52,4 +36,16 @@ HitRecord Ray::Gethit(const std::vector<Object*>& objects, const ld& t_min, cons
     return first_hit;
 }
 
+HitRecord Ray::Gethit(const Scene& scene, const ld& t_min, const ld& t_max) {
+    HitRecord first_hit;
+    first_hit.t = t_max;
+
+    HitRecord rec;
+    if (scene.hit(*this, t_min, t_max, rec)) {
+        first_hit = rec;
+    }
+
+    return first_hit;
+}
+
 } // namespace Prism
\ No newline at end of file
@@ -0,0 +1,239 @@
+#include "Prism/renderer.hpp"
+#include "Prism/accumulator.hpp"
+#include "Prism/camera_path.hpp"
+#include "Prism/image_writer.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/shadow_queue.hpp"
+#include "Prism/stats.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace Prism {
+
+namespace {
+
+// Each sample is drawn from the sampler at the index of the pixel's next sample, so samples are
+// reproducible.
+void addSample(const Camera& camera, const Renderer::SampledShader& shade, Sampler& sampler,
+               Accumulator& accumulator, int x, int y) {
+    sampler.startPixelSample(x, y, accumulator.samples(x, y));
+    const Ray ray = camera.getRay(x, y, sampler);
+    accumulator.add(x, y, shade(ray, sampler));
+}
+
+Renderer::SampledShader ignoreSampler(const Renderer::Shader& shade) {
+    return [&shade](const Ray& ray, Sampler&) { return shade(ray); };
+}
+
+void checkSize(const Camera& camera, const Accumulator& accumulator) {
+    if (accumulator.width() != camera.pixel_width ||
+        accumulator.height() != camera.pixel_height) {
+        throw std::invalid_argument("Accumulation buffer size does not match the camera image.");
+    }
+}
+
+} // namespace
+
+Renderer::Renderer(size_t thread_count, int tile_size)
+    : pool_(thread_count), tile_size_(tile_size), sampler_(new SobolSampler()) {
+    if (tile_size <= 0) {
+        throw std::invalid_argument("Tile size must be greater than zero.");
+    }
+}
+
+Image Renderer::render(const Camera& camera, const Shader& shade) {
+    Image image(camera.pixel_width, camera.pixel_height);
+    const std::vector<Tile> tiles = makeTiles(image.width(), image.height(), tile_size_);
+
+    const PixelRange pixels = camera.pixels();
+    pool_.parallelFor(tiles.size(), [&](size_t i) {
+        const Tile& tile = tiles[i];
+        StageTimer timer(StatStage::Shade);
+        const PixelRange range =
+            pixels.tile(tile.x0, tile.y0, tile.x1 - tile.x0, tile.y1 - tile.y0);
+        for (PixelIterator it = range.begin(); it != range.end(); ++it) {
+            const Pixel p = it.pixel();
+            image.pixel(p.x, p.y) = shade(*it);
+        }
+    });
+
+    return image;
+}
+
+Image Renderer::renderDeferred(const Camera& camera, const DeferredShader& shade,
+                               const Scene& scene) {
+    if (!scene.isBuilt()) {
+        throw std::logic_error("Scene must be built before tracing rays.");
+    }
+    Image image(camera.pixel_width, camera.pixel_height);
+    const std::vector<Tile> tiles = makeTiles(image.width(), image.height(), tile_size_);
+    const uint32_t width = static_cast<uint32_t>(image.width());
+
+    const PixelRange pixels = camera.pixels();
+    pool_.parallelFor(tiles.size(), [&](size_t i) {
+        // One stream per worker thread, reused from tile to tile.
+        thread_local ShadowQueue queue;
+        queue.clear();
+        const Tile& tile = tiles[i];
+        {
+            StageTimer timer(StatStage::Shade);
+            const PixelRange range =
+                pixels.tile(tile.x0, tile.y0, tile.x1 - tile.x0, tile.y1 - tile.y0);
+            for (PixelIterator it = range.begin(); it != range.end(); ++it) {
+                const Pixel p = it.pixel();
+                queue.setPixel(static_cast<uint32_t>(p.y) * width + static_cast<uint32_t>(p.x));
+                image.pixel(p.x, p.y) = shade(*it, queue);
+            }
+        }
+        // Scene::occluded times every query under the occlusion stage.
+        queue.trace(scene, [&](const ShadowRay& shadow) {
+            Vector3& pixel = image.pixel(static_cast<int>(shadow.pixel % width),
+                                         static_cast<int>(shadow.pixel / width));
+            pixel = pixel + shadow.contribution;
+        });
+    });
+
+    return image;
+}
+
+void Renderer::renderFrames(Camera& camera, const CameraPath& path, int frame_count,
+                            const Shader& shade, const FrameCallback& on_frame) {
+    if (frame_count <= 0) {
+        throw std::invalid_argument("Frame count must be positive");
+    }
+    for (int frame = 0; frame < frame_count; ++frame) {
+        path.apply(path.frameTime(frame, frame_count), camera);
+        on_frame(frame, render(camera, shade));
+    }
+}
+
+void Renderer::render(const Camera& camera, const Shader& shade, ImageWriter& out) {
+    const int width = camera.pixel_width;
+    const int height = camera.pixel_height;
+    if (out.width() != width || out.height() != height) {
+        throw std::invalid_argument("Image writer size does not match the camera image.");
+    }
+    if (out.windowRows() < std::min(tile_size_, height)) {
+        throw std::invalid_argument("Image writer window is shorter than a tile.");
+    }
+
+    // Each band fits in the writer window, so its tiles can be written in any order.
+    const int band_rows = std::max(tile_size_, out.windowRows() / tile_size_ * tile_size_);
+    for (int band = 0; band < height; band += band_rows) {
+        std::vector<Tile> tiles = makeTiles(width, std::min(band_rows, height - band), tile_size_);
+        const PixelRange camera_pixels = camera.pixels();
+        pool_.parallelFor(tiles.size(), [&](size_t i) {
+            Tile tile = tiles[i];
+            tile.y0 += band;
+            tile.y1 += band;
+            std::vector<Vector3> pixels;
+            pixels.reserve(static_cast<size_t>(tile.x1 - tile.x0) * (tile.y1 - tile.y0));
+            {
+                StageTimer timer(StatStage::Shade);
+                for (const Ray& ray : camera_pixels.tile(tile.x0, tile.y0, tile.x1 - tile.x0,
+                                                         tile.y1 - tile.y0)) {
+                    pixels.push_back(shade(ray));
+                }
+            }
+            out.writeTile(tile, pixels.data());
+        });
+    }
+    out.finish();
+}
+
+bool Renderer::renderPass(const Camera& camera, const Shader& shade, Accumulator& accumulator,
+                          const std::atomic<bool>* stop) {
+    return renderPass(camera, ignoreSampler(shade), accumulator, stop);
+}
+
+bool Renderer::renderPass(const Camera& camera, const SampledShader& shade,
+                          Accumulator& accumulator, const std::atomic<bool>* stop) {
+    checkSize(camera, accumulator);
+    const std::vector<Tile> tiles =
+        makeTiles(accumulator.width(), accumulator.height(), tile_size_);
+    std::atomic<bool> complete{true};
+
+    pool_.parallelFor(tiles.size(), [&](size_t i) {
+        if (stop != nullptr && stop->load(std::memory_order_relaxed)) {
+            complete.store(false, std::memory_order_relaxed);
+            return;
+        }
+        const Tile& tile = tiles[i];
+        StageTimer timer(StatStage::Shade);
+        const std::unique_ptr<Sampler> sampler = sampler_->clone();
+        for (int y = tile.y0; y < tile.y1; ++y) {
+            for (int x = tile.x0; x < tile.x1; ++x) {
+                addSample(camera, shade, *sampler, accumulator, x, y);
+            }
+        }
+    });
+
+    return complete.load();
+}
+
+uint64_t Renderer::renderAdaptive(const Camera& camera, const Shader& shade,
+                                  Accumulator& accumulator, const AdaptiveSettings& settings,
+                                  const std::atomic<bool>* stop) {
+    return renderAdaptive(camera, ignoreSampler(shade), accumulator, settings, stop);
+}
+
+uint64_t Renderer::renderAdaptive(const Camera& camera, const SampledShader& shade,
+                                  Accumulator& accumulator, const AdaptiveSettings& settings,
+                                  const std::atomic<bool>* stop) {
+    checkSize(camera, accumulator);
+    if (settings.min_samples < 2 || settings.max_samples < settings.min_samples ||
+        !(settings.max_error >= 0)) {
+        throw std::invalid_argument("Invalid adaptive sampling settings.");
+    }
+    const auto converged = [&](int x, int y) {
+        const uint32_t n = accumulator.samples(x, y);
+        return n >= settings.max_samples || (n >= settings.min_samples &&
+                                             accumulator.standardError(x, y) <= settings.max_error);
+    };
+
+    const std::vector<Tile> tiles =
+        makeTiles(accumulator.width(), accumulator.height(), tile_size_);
+    std::vector<uint8_t> active(tiles.size(), 1);
+    uint64_t total = 0;
+    bool sampling = true;
+    while (sampling && !(stop != nullptr && stop->load(std::memory_order_relaxed))) {
+        std::atomic<uint64_t> taken{0};
+        pool_.parallelFor(tiles.size(), [&](size_t i) {
+            if (!active[i] || (stop != nullptr && stop->load(std::memory_order_relaxed))) {
+                return;
+            }
+            const Tile& tile = tiles[i];
+            StageTimer timer(StatStage::Shade);
+            const std::unique_ptr<Sampler> sampler = sampler_->clone();
+            uint64_t count = 0;
+            for (int y = tile.y0; y < tile.y1; ++y) {
+                for (int x = tile.x0; x < tile.x1; ++x) {
+                    if (!converged(x, y)) {
+                        addSample(camera, shade, *sampler, accumulator, x, y);
+                        ++count;
+                    }
+                }
+            }
+            // Converged pixels never take another sample, so the tile can be dropped.
+            active[i] = count != 0;
+            taken.fetch_add(count, std::memory_order_relaxed);
+        });
+        total += taken.load();
+        sampling = taken.load() != 0;
+    }
+    return total;
+}
+
+std::vector<Tile> Renderer::makeTiles(int width, int height, int tile_size) {
+    std::vector<Tile> tiles;
+    for (int y = 0; y < height; y += tile_size) {
+        for (int x = 0; x < width; x += tile_size) {
+            tiles.push_back(Tile{x, y, std::min(x + tile_size, width),
+                                 std::min(y + tile_size, height)});
+        }
+    }
+    return tiles;
+}
+
+} // namespace Prism
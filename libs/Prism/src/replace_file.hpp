@@ -0,0 +1,17 @@
+#ifndef PRISM_REPLACE_FILE_HPP_
+#define PRISM_REPLACE_FILE_HPP_
+
+#include <string>
+
+namespace Prism {
+
+/**
+ * @brief Moves a file over another in one step, so the target is never missing, even after a
+ * crash. Used to publish files written next to their final path.
+ * @return false if the file could not be moved.
+ */
+bool replaceFile(const std::string& from, const std::string& to);
+
+} // namespace Prism
+
+#endif // PRISM_REPLACE_FILE_HPP_
@@ -0,0 +1,210 @@
+#include "Prism/sampler.hpp"
+#include "blue_noise.hpp"
+#include <array>
+
+namespace Prism {
+
+namespace {
+
+constexpr int kBits = 32;
+
+// Joe and Kuo's primitive polynomials (degree s, coefficients a) and initial direction numbers m
+// for Sobol' dimensions 2 to 16; dimension 1 is the van der Corput sequence.
+struct SobolParameters {
+    int s;
+    uint32_t a;
+    uint32_t m[6];
+};
+
+constexpr SobolParameters kSobolParameters[SobolSampler::kSobolDimensions - 1] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+};
+
+using SobolMatrices = std::array<std::array<uint32_t, kBits>, SobolSampler::kSobolDimensions>;
+
+// Column j of a matrix is the direction number XORed in when bit j of the index is set.
+constexpr SobolMatrices makeSobolMatrices() {
+    SobolMatrices matrices{};
+    for (int k = 0; k < kBits; ++k) {
+        matrices[0][k] = 1u << (kBits - 1 - k);
+    }
+    for (int d = 1; d < SobolSampler::kSobolDimensions; ++d) {
+        const SobolParameters& p = kSobolParameters[d - 1];
+        std::array<uint32_t, kBits>& v = matrices[d];
+        for (int k = 0; k < p.s; ++k) {
+            v[k] = p.m[k] << (kBits - 1 - k);
+        }
+        for (int k = p.s; k < kBits; ++k) {
+            v[k] = v[k - p.s] ^ (v[k - p.s] >> p.s);
+            for (int i = 1; i < p.s; ++i) {
+                if ((p.a >> (p.s - 1 - i)) & 1) {
+                    v[k] ^= v[k - i];
+                }
+            }
+        }
+    }
+    return matrices;
+}
+
+// The matrix-vector product of every byte of the index, so that a point takes four lookups.
+using SobolTables =
+    std::array<std::array<std::array<uint32_t, 256>, 4>, SobolSampler::kSobolDimensions>;
+
+constexpr SobolTables makeSobolTables() {
+    constexpr SobolMatrices matrices = makeSobolMatrices();
+    SobolTables tables{};
+    for (int d = 0; d < SobolSampler::kSobolDimensions; ++d) {
+        for (int byte = 0; byte < 4; ++byte) {
+            for (uint32_t value = 0; value < 256; ++value) {
+                uint32_t x = 0;
+                for (int k = 0; k < 8; ++k) {
+                    if ((value >> k) & 1) {
+                        x ^= matrices[d][8 * byte + k];
+                    }
+                }
+                tables[d][byte][value] = x;
+            }
+        }
+    }
+    return tables;
+}
+
+constexpr SobolTables kSobolTables = makeSobolTables();
+
+// Murmur3 finalizer; spreads every input bit over the whole word.
+uint32_t mix(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+uint32_t reverseBits(uint32_t x) {
+    x = (x << 16) | (x >> 16);
+    x = ((x & 0x00FF00FFu) << 8) | ((x & 0xFF00FF00u) >> 8);
+    x = ((x & 0x0F0F0F0Fu) << 4) | ((x & 0xF0F0F0F0u) >> 4);
+    x = ((x & 0x33333333u) << 2) | ((x & 0xCCCCCCCCu) >> 2);
+    x = ((x & 0x55555555u) << 1) | ((x & 0xAAAAAAAAu) >> 1);
+    return x;
+}
+
+// Burley's hash-based nested uniform scramble: every bit is flipped depending on the bits above
+// it, so aligned intervals are permuted as a whole and stratification is preserved.
+uint32_t owenScramble(uint32_t x, uint32_t seed) {
+    x = reverseBits(x);
+    x += seed;
+    x ^= x * 0x6C50B47Cu;
+    x ^= x * 0xB82F1E52u;
+    x ^= x * 0xC7AFE638u;
+    x ^= x * 0x8D22F6E6u;
+    return reverseBits(x);
+}
+
+// Uniform value in [0, 1) from the top 24 bits of a fixed-point fraction.
+ld toUnit(uint32_t x) {
+    return (x >> 8) * (ld(1) / (1u << 24));
+}
+
+} // namespace
+
+uint32_t SobolSampler::sobol(uint32_t index, int dimension) {
+    const std::array<std::array<uint32_t, 256>, 4>& t = kSobolTables[dimension];
+    return t[0][index & 0xFF] ^ t[1][(index >> 8) & 0xFF] ^ t[2][(index >> 16) & 0xFF] ^
+           t[3][index >> 24];
+}
+
+void SobolSampler::startPixelSample(int x, int y, uint32_t index) {
+    pixel_seed_ = mix(mix(static_cast<uint32_t>(x) * 0x9E3779B9u ^ static_cast<uint32_t>(y)) ^
+                      mix(seed_ + 0x68E31DA4u));
+    index_ = index;
+    dimension_ = 0;
+    block_ = 0;
+    shuffled_index_ = owenScramble(index_, mix(pixel_seed_));
+}
+
+uint32_t SobolSampler::sample(int dimension) {
+    // Every block of kSobolDimensions dimensions is a new set of Sobol' points, with its own
+    // index shuffle so that it is not correlated with the previous ones.
+    const int block = dimension / kSobolDimensions;
+    if (block != block_) {
+        block_ = block;
+        shuffled_index_ =
+            owenScramble(index_, mix(pixel_seed_ ^ mix(static_cast<uint32_t>(block))));
+    }
+    const uint32_t x = sobol(shuffled_index_, dimension % kSobolDimensions);
+    return owenScramble(x, mix(pixel_seed_ + mix(static_cast<uint32_t>(dimension) + 1)));
+}
+
+ld SobolSampler::get1D() {
+    return toUnit(sample(dimension_++));
+}
+
+Sample2D SobolSampler::get2D() {
+    const Sample2D s{toUnit(sample(dimension_)), toUnit(sample(dimension_ + 1))};
+    dimension_ += 2;
+    return s;
+}
+
+std::unique_ptr<Sampler> SobolSampler::clone() const {
+    return std::unique_ptr<Sampler>(new SobolSampler(*this));
+}
+
+float BlueNoiseSampler::blueNoise(int x, int y) {
+    static_assert(kBlueNoiseSize == kBlueNoiseTileSize, "The tile is precomputed at this size");
+    x = ((x % kBlueNoiseSize) + kBlueNoiseSize) % kBlueNoiseSize;
+    y = ((y % kBlueNoiseSize) + kBlueNoiseSize) % kBlueNoiseSize;
+    return (kBlueNoiseRanks[y * kBlueNoiseSize + x] + 0.5f) / (kBlueNoiseSize * kBlueNoiseSize);
+}
+
+void BlueNoiseSampler::startPixelSample(int x, int y, uint32_t index) {
+    x_ = x;
+    y_ = y;
+    index_ = index;
+    dimension_ = 0;
+}
+
+uint32_t BlueNoiseSampler::sample(int dimension) const {
+    // The same scrambled points in every pixel, rotated by the pixel's blue-noise value. Each
+    // dimension reads the tile at its own offset so that dimensions are not correlated.
+    const uint32_t block = static_cast<uint32_t>(dimension / SobolSampler::kSobolDimensions);
+    const uint32_t index = block == 0 ? index_ : owenScramble(index_, mix(block));
+    const uint32_t x = owenScramble(
+        SobolSampler::sobol(index, dimension % SobolSampler::kSobolDimensions),
+        mix(static_cast<uint32_t>(dimension) + 1));
+    const uint32_t offset = mix(static_cast<uint32_t>(dimension) * 0x9E3779B9u);
+    const float shift = blueNoise(x_ + static_cast<int>(offset & 0xFFFF),
+                                  y_ + static_cast<int>(offset >> 16));
+    return x + static_cast<uint32_t>(shift * 4294967296.0);
+}
+
+ld BlueNoiseSampler::get1D() {
+    return toUnit(sample(dimension_++));
+}
+
+Sample2D BlueNoiseSampler::get2D() {
+    const Sample2D s{toUnit(sample(dimension_)), toUnit(sample(dimension_ + 1))};
+    dimension_ += 2;
+    return s;
+}
+
+std::unique_ptr<Sampler> BlueNoiseSampler::clone() const {
+    return std::unique_ptr<Sampler>(new BlueNoiseSampler(*this));
+}
+
+} // namespace Prism
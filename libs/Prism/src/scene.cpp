@@ -0,0 +1,56 @@
+#include "Prism/scene.hpp"
+#include "Prism/stats.hpp"
+#include <stdexcept>
+
+namespace Prism {
+
+Scene::Scene(const std::vector<Object*>& objects) : objects_(objects) {
+    build();
+}
+
+void Scene::add(Object* object) {
+    objects_.push_back(object);
+    bvh_.reset();
+}
+
+void Scene::build() {
+    bvh_ = std::make_unique<BVH>(objects_);
+}
+
+bool Scene::hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const {
+    if (!bvh_) {
+        throw std::logic_error("Scene must be built before tracing rays.");
+    }
+    StageTimer timer(StatStage::Trace);
+    const bool hit = bvh_->hit(ray, t_min, t_max, rec);
+    countStat(hit ? StatCounter::SceneHits : StatCounter::SceneMisses);
+    return hit;
+}
+
+bool Scene::occluded(const Ray& ray, ld t_min, ld t_max) const {
+    if (!bvh_) {
+        throw std::logic_error("Scene must be built before tracing rays.");
+    }
+    StageTimer timer(StatStage::Occlusion);
+    const bool blocked = bvh_->occluded(ray, t_min, t_max);
+    countStat(blocked ? StatCounter::OccludedRays : StatCounter::UnoccludedRays);
+    return blocked;
+}
+
+void Scene::hit(const RayPacket& packet, ld t_min, ld t_max, PacketHit& hits) const {
+    if (!bvh_) {
+        throw std::logic_error("Scene must be built before tracing rays.");
+    }
+    StageTimer timer(StatStage::Trace);
+    hits.reset(t_max);
+    bvh_->hitPacket(packet, t_min, hits);
+    if (kStatsEnabled) {
+        for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+            if (packet.active[lane]) {
+                countStat(hits.hit[lane] ? StatCounter::SceneHits : StatCounter::SceneMisses);
+            }
+        }
+    }
+}
+
+} // namespace Prism
@@ -0,0 +1,61 @@
+#include "Prism/shadow_queue.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Prism {
+
+namespace {
+
+// Spreads the low 20 bits of v so that two zero bits separate each of them.
+uint64_t spreadBits(uint64_t v) {
+    v &= 0xFFFFF;
+    v = (v | (v << 32)) & 0x001F00000000FFFFull;
+    v = (v | (v << 16)) & 0x001F0000FF0000FFull;
+    v = (v | (v << 8)) & 0x100F00F00F00F00Full;
+    v = (v | (v << 4)) & 0x10C30C30C30C30C3ull;
+    v = (v | (v << 2)) & 0x1249249249249249ull;
+    return v;
+}
+
+// Position of x inside [lo, hi] on a grid of 2^ShadowQueue::kMortonBits cells.
+uint64_t quantize(ld x, ld lo, ld hi) {
+    constexpr ld kCells = ld(1 << ShadowQueue::kMortonBits);
+    if (!(hi > lo)) {
+        return 0;
+    }
+    const ld cell = std::floor((x - lo) / (hi - lo) * kCells);
+    return static_cast<uint64_t>(std::min(std::max(cell, ld(0)), kCells - 1));
+}
+
+} // namespace
+
+uint64_t ShadowQueue::sortKey(const Ray& ray, const AABB& origins) {
+    const uint64_t octant = (ray.direction.x < 0 ? 1u : 0u) | (ray.direction.y < 0 ? 2u : 0u) |
+                            (ray.direction.z < 0 ? 4u : 0u);
+    const uint64_t morton =
+        spreadBits(quantize(ray.origin.x, origins.min.x, origins.max.x)) << 2 |
+        spreadBits(quantize(ray.origin.y, origins.min.y, origins.max.y)) << 1 |
+        spreadBits(quantize(ray.origin.z, origins.min.z, origins.max.z));
+    return octant << (3 * kMortonBits) | morton;
+}
+
+void ShadowQueue::sort() {
+    AABB origins;
+    for (const ShadowRay& shadow : rays_) {
+        origins.expand(shadow.ray.origin);
+    }
+    keys_.clear();
+    for (size_t i = 0; i < rays_.size(); ++i) {
+        keys_.emplace_back(sortKey(rays_[i].ray, origins), static_cast<uint32_t>(i));
+    }
+    // Pairs compare by key, then by push order, which makes the sort stable.
+    std::sort(keys_.begin(), keys_.end());
+
+    sorted_.clear();
+    for (const auto& key : keys_) {
+        sorted_.push_back(rays_[key.second]);
+    }
+    rays_.swap(sorted_);
+}
+
+} // namespace Prism
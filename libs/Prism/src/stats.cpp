@@ -0,0 +1,153 @@
+#include "Prism/stats.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace Prism {
+
+namespace {
+
+constexpr int kSlotCount = kStatCounterCount + kStatStageCount;
+
+// Statistics of one thread. Only the owning thread writes them, so increments need no atomic
+// read-modify-write; the atomics only make concurrent snapshots well defined.
+struct Slots {
+    std::atomic<uint64_t> values[kSlotCount] = {};
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<Slots*> live;
+    uint64_t retired[kSlotCount] = {}; ///< Totals of the threads that exited.
+};
+
+// Never destroyed, so threads exiting during shutdown can still unregister.
+Registry& registry() {
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+struct ThreadSlots {
+    ThreadSlots() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.live.push_back(&slots);
+    }
+
+    ~ThreadSlots() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (int i = 0; i < kSlotCount; ++i) {
+            reg.retired[i] += slots.values[i].load(std::memory_order_relaxed);
+        }
+        reg.live.erase(std::find(reg.live.begin(), reg.live.end(), &slots));
+    }
+
+    Slots slots;
+};
+
+void bump(int slot, uint64_t amount) {
+    thread_local ThreadSlots local;
+    std::atomic<uint64_t>& value = local.slots.values[slot];
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+} // namespace
+
+void addStat(StatCounter counter, uint64_t amount) {
+    bump(static_cast<int>(counter), amount);
+}
+
+void addStageTime(StatStage stage, uint64_t nanoseconds) {
+    bump(kStatCounterCount + static_cast<int>(stage), nanoseconds);
+}
+
+StatsSnapshot statsSnapshot() {
+    uint64_t totals[kSlotCount];
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        std::copy(reg.retired, reg.retired + kSlotCount, totals);
+        for (const Slots* slots : reg.live) {
+            for (int i = 0; i < kSlotCount; ++i) {
+                totals[i] += slots->values[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    StatsSnapshot snapshot;
+    std::copy(totals, totals + kStatCounterCount, snapshot.counters);
+    std::copy(totals + kStatCounterCount, totals + kSlotCount, snapshot.stage_nanoseconds);
+    return snapshot;
+}
+
+void resetStats() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::fill(reg.retired, reg.retired + kSlotCount, 0);
+    for (Slots* slots : reg.live) {
+        for (int i = 0; i < kSlotCount; ++i) {
+            slots->values[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+const char* statCounterName(StatCounter counter) {
+    switch (counter) {
+        case StatCounter::CameraRays:
+            return "camera_rays";
+        case StatCounter::ObjectTests:
+            return "object_tests";
+        case StatCounter::BVHNodes:
+            return "bvh_nodes";
+        case StatCounter::SceneHits:
+            return "scene_hits";
+        case StatCounter::SceneMisses:
+            return "scene_misses";
+        case StatCounter::OcclusionTests:
+            return "occlusion_tests";
+        case StatCounter::OcclusionNodes:
+            return "occlusion_nodes";
+        case StatCounter::OccludedRays:
+            return "occluded_rays";
+        case StatCounter::UnoccludedRays:
+            return "unoccluded_rays";
+    }
+    return "unknown";
+}
+
+const char* statStageName(StatStage stage) {
+    switch (stage) {
+        case StatStage::Load:
+            return "load";
+        case StatStage::Build:
+            return "build";
+        case StatStage::Trace:
+            return "trace";
+        case StatStage::Occlusion:
+            return "occlusion";
+        case StatStage::Shade:
+            return "shade";
+        case StatStage::Write:
+            return "write";
+    }
+    return "unknown";
+}
+
+void writeStatsJson(std::ostream& out, const StatsSnapshot& stats) {
+    out << "{\"enabled\": " << (kStatsEnabled ? "true" : "false") << ", \"counters\": {";
+    for (int i = 0; i < kStatCounterCount; ++i) {
+        out << (i == 0 ? "" : ", ") << '"' << statCounterName(static_cast<StatCounter>(i))
+            << "\": " << stats.counters[i];
+    }
+    out << "}, \"stage_seconds\": {";
+    for (int i = 0; i < kStatStageCount; ++i) {
+        const StatStage stage = static_cast<StatStage>(i);
+        out << (i == 0 ? "" : ", ") << '"' << statStageName(stage)
+            << "\": " << stats.seconds(stage);
+    }
+    out << "}}\n";
+}
+
+} // namespace Prism
@@ -0,0 +1,156 @@
+#include "Prism/thread_pool.hpp"
+#include <exception>
+
+namespace Prism {
+
+namespace {
+
+// Identifies the pool and queue of the calling thread, so nested parallelFor calls push to the
+// worker's own queue instead of the shared one.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_queue = 0;
+
+} // namespace
+
+struct ThreadPool::Batch {
+    const std::function<void(size_t)>* body;
+    std::atomic<size_t> remaining;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+};
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::thread::hardware_concurrency();
+        if (thread_count == 0) {
+            thread_count = 1;
+        }
+    }
+
+    for (size_t i = 0; i < thread_count + 1; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    Batch batch;
+    batch.body = &body;
+    batch.remaining.store(count);
+
+    const bool inside_worker = current_pool == this;
+    const size_t home = inside_worker ? current_queue : workers_.size();
+
+    queued_.fetch_add(count);
+    if (inside_worker) {
+        Queue& queue = *queues_[home];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (size_t i = 0; i < count; ++i) {
+            queue.tasks.push_back(Task{&batch, i});
+        }
+    } else {
+        // Deal the iterations out round-robin so every worker starts with local work.
+        for (size_t w = 0; w < workers_.size() && w < count; ++w) {
+            Queue& queue = *queues_[w];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            for (size_t i = w; i < count; i += workers_.size()) {
+                queue.tasks.push_back(Task{&batch, i});
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    wake_.notify_all();
+
+    // Help until the whole batch is done; this also drains nested batches.
+    while (batch.remaining.load(std::memory_order_acquire) > 0) {
+        Task task;
+        if (tryPop(home, task)) {
+            run(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+void ThreadPool::workerLoop(size_t queue_index) {
+    current_pool = this;
+    current_queue = queue_index;
+
+    while (true) {
+        Task task;
+        if (tryPop(queue_index, task)) {
+            run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+        if (stop_ && queued_.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::tryPop(size_t queue_index, Task& task) {
+    {
+        Queue& own = *queues_[queue_index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        Queue& victim = *queues_[(queue_index + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(const Task& task) {
+    Batch& batch = *task.batch;
+    try {
+        (*batch.body)(task.index);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(batch.error_mutex);
+        if (!batch.error) {
+            batch.error = std::current_exception();
+        }
+    }
+    batch.remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace Prism
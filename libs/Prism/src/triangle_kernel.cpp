@@ -0,0 +1,290 @@
+#include "Prism/triangle_kernel.hpp"
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PRISM_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define PRISM_TARGET(isa)
+#else
+#define PRISM_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace Prism {
+
+namespace {
+
+using Kernel = int (*)(const TriangleBlock&, const BlockRay&, float, float, BlockHit&);
+
+int intersectScalar(const TriangleBlock& b, const BlockRay& ray, float t_min, float t_max,
+                    BlockHit& hit) {
+    const float* o = ray.origin;
+    const float* d = ray.direction;
+    int closest = -1;
+    for (int i = 0; i < kTriangleBlockWidth; ++i) {
+        const float e1x = b.e1[0][i], e1y = b.e1[1][i], e1z = b.e1[2][i];
+        const float e2x = b.e2[0][i], e2y = b.e2[1][i], e2z = b.e2[2][i];
+
+        const float px = d[1] * e2z - d[2] * e2y;
+        const float py = d[2] * e2x - d[0] * e2z;
+        const float pz = d[0] * e2y - d[1] * e2x;
+        const float det = e1x * px + e1y * py + e1z * pz;
+        if (det == 0) {
+            continue;
+        }
+        const float inv_det = 1 / det;
+
+        const float sx = o[0] - b.v0[0][i], sy = o[1] - b.v0[1][i], sz = o[2] - b.v0[2][i];
+        const float u = (sx * px + sy * py + sz * pz) * inv_det;
+        const float qx = sy * e1z - sz * e1y;
+        const float qy = sz * e1x - sx * e1z;
+        const float qz = sx * e1y - sy * e1x;
+        const float v = (d[0] * qx + d[1] * qy + d[2] * qz) * inv_det;
+        const float t = (e2x * qx + e2y * qy + e2z * qz) * inv_det;
+
+        // Written as positive tests so that NaNs are rejected like in the vector kernels.
+        if (u >= 0 && u <= 1 && v >= 0 && u + v <= 1 && t > t_min && t < t_max) {
+            t_max = t;
+            closest = i;
+            hit = {t, u, v};
+        }
+    }
+    return closest;
+}
+
+#ifdef PRISM_X86
+
+// Picks the closest lane among those set in mask, from values stored by a vector kernel.
+int closestLane(int mask, const float* t, const float* u, const float* v, BlockHit& hit) {
+    int closest = -1;
+    for (int i = 0; i < kTriangleBlockWidth; ++i) {
+        if ((mask >> i & 1) && (closest < 0 || t[i] < t[closest])) {
+            closest = i;
+        }
+    }
+    hit = {t[closest], u[closest], v[closest]};
+    return closest;
+}
+
+PRISM_TARGET("sse4.1")
+int intersectSse4(const TriangleBlock& b, const BlockRay& ray, float t_min, float t_max,
+                  BlockHit& hit) {
+    alignas(16) float ts[kTriangleBlockWidth];
+    alignas(16) float us[kTriangleBlockWidth];
+    alignas(16) float vs[kTriangleBlockWidth];
+    const __m128 ox = _mm_set1_ps(ray.origin[0]);
+    const __m128 oy = _mm_set1_ps(ray.origin[1]);
+    const __m128 oz = _mm_set1_ps(ray.origin[2]);
+    const __m128 dx = _mm_set1_ps(ray.direction[0]);
+    const __m128 dy = _mm_set1_ps(ray.direction[1]);
+    const __m128 dz = _mm_set1_ps(ray.direction[2]);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 t_near = _mm_set1_ps(t_min);
+    const __m128 t_far = _mm_set1_ps(t_max);
+
+    int mask = 0;
+    for (int half = 0; half < kTriangleBlockWidth; half += 4) {
+        const __m128 e1x = _mm_load_ps(b.e1[0] + half);
+        const __m128 e1y = _mm_load_ps(b.e1[1] + half);
+        const __m128 e1z = _mm_load_ps(b.e1[2] + half);
+        const __m128 e2x = _mm_load_ps(b.e2[0] + half);
+        const __m128 e2y = _mm_load_ps(b.e2[1] + half);
+        const __m128 e2z = _mm_load_ps(b.e2[2] + half);
+
+        const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)),
+                                      _mm_mul_ps(e1z, pz));
+        const __m128 inv_det = _mm_div_ps(one, det);
+
+        const __m128 sx = _mm_sub_ps(ox, _mm_load_ps(b.v0[0] + half));
+        const __m128 sy = _mm_sub_ps(oy, _mm_load_ps(b.v0[1] + half));
+        const __m128 sz = _mm_sub_ps(oz, _mm_load_ps(b.v0[2] + half));
+        const __m128 u = _mm_mul_ps(
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)),
+            inv_det);
+        const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        const __m128 v = _mm_mul_ps(
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)),
+            inv_det);
+        const __m128 t = _mm_mul_ps(
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)),
+            inv_det);
+
+        __m128 valid = _mm_cmpneq_ps(det, zero);
+        valid = _mm_and_ps(valid, _mm_cmpge_ps(u, zero));
+        valid = _mm_and_ps(valid, _mm_cmple_ps(u, one));
+        valid = _mm_and_ps(valid, _mm_cmpge_ps(v, zero));
+        valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(u, v), one));
+        valid = _mm_and_ps(valid, _mm_cmpgt_ps(t, t_near));
+        valid = _mm_and_ps(valid, _mm_cmplt_ps(t, t_far));
+        mask |= _mm_movemask_ps(valid) << half;
+
+        _mm_store_ps(ts + half, t);
+        _mm_store_ps(us + half, u);
+        _mm_store_ps(vs + half, v);
+    }
+    return mask == 0 ? -1 : closestLane(mask, ts, us, vs, hit);
+}
+
+PRISM_TARGET("avx2")
+int intersectAvx2(const TriangleBlock& b, const BlockRay& ray, float t_min, float t_max,
+                  BlockHit& hit) {
+    const __m256 e1x = _mm256_load_ps(b.e1[0]);
+    const __m256 e1y = _mm256_load_ps(b.e1[1]);
+    const __m256 e1z = _mm256_load_ps(b.e1[2]);
+    const __m256 e2x = _mm256_load_ps(b.e2[0]);
+    const __m256 e2y = _mm256_load_ps(b.e2[1]);
+    const __m256 e2z = _mm256_load_ps(b.e2[2]);
+    const __m256 dx = _mm256_set1_ps(ray.direction[0]);
+    const __m256 dy = _mm256_set1_ps(ray.direction[1]);
+    const __m256 dz = _mm256_set1_ps(ray.direction[2]);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+    const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+    const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+    const __m256 det = _mm256_add_ps(
+        _mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+    const __m256 inv_det = _mm256_div_ps(one, det);
+
+    const __m256 sx = _mm256_sub_ps(_mm256_set1_ps(ray.origin[0]), _mm256_load_ps(b.v0[0]));
+    const __m256 sy = _mm256_sub_ps(_mm256_set1_ps(ray.origin[1]), _mm256_load_ps(b.v0[1]));
+    const __m256 sz = _mm256_sub_ps(_mm256_set1_ps(ray.origin[2]), _mm256_load_ps(b.v0[2]));
+    const __m256 u = _mm256_mul_ps(
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)),
+                      _mm256_mul_ps(sz, pz)),
+        inv_det);
+    const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+    const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+    const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+    const __m256 v = _mm256_mul_ps(
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)),
+                      _mm256_mul_ps(dz, qz)),
+        inv_det);
+    const __m256 t = _mm256_mul_ps(
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)),
+                      _mm256_mul_ps(e2z, qz)),
+        inv_det);
+
+    __m256 valid = _mm256_cmp_ps(det, zero, _CMP_NEQ_OQ);
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(u, one, _CMP_LE_OQ));
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(t, _mm256_set1_ps(t_min), _CMP_GT_OQ));
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(t, _mm256_set1_ps(t_max), _CMP_LT_OQ));
+    const int mask = _mm256_movemask_ps(valid);
+    if (mask == 0) {
+        return -1;
+    }
+
+    alignas(32) float ts[kTriangleBlockWidth];
+    alignas(32) float us[kTriangleBlockWidth];
+    alignas(32) float vs[kTriangleBlockWidth];
+    _mm256_store_ps(ts, t);
+    _mm256_store_ps(us, u);
+    _mm256_store_ps(vs, v);
+    return closestLane(mask, ts, us, vs, hit);
+}
+
+bool supports(SimdLevel level) {
+    if (level == SimdLevel::Scalar) {
+        return true;
+    }
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    const bool sse41 = (info[2] & (1 << 19)) != 0;
+    const bool os_avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 &&
+                        (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    const bool avx2 = os_avx && (info[1] & (1 << 5)) != 0;
+#else
+    const bool sse41 = __builtin_cpu_supports("sse4.1");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    return level == SimdLevel::SSE4 ? sse41 : avx2;
+}
+
+#else
+
+bool supports(SimdLevel level) {
+    return level == SimdLevel::Scalar;
+}
+
+#endif
+
+Kernel kernelFor(SimdLevel level) {
+#ifdef PRISM_X86
+    switch (level) {
+        case SimdLevel::AVX2:
+            return intersectAvx2;
+        case SimdLevel::SSE4:
+            return intersectSse4;
+        default:
+            break;
+    }
+#endif
+    return intersectScalar;
+}
+
+struct Dispatch {
+    std::atomic<SimdLevel> level{detectSimdLevel()};
+    std::atomic<Kernel> kernel{kernelFor(level.load())};
+};
+
+Dispatch& dispatch() {
+    static Dispatch instance;
+    return instance;
+}
+
+} // namespace
+
+SimdLevel detectSimdLevel() {
+    if (supports(SimdLevel::AVX2)) {
+        return SimdLevel::AVX2;
+    }
+    return supports(SimdLevel::SSE4) ? SimdLevel::SSE4 : SimdLevel::Scalar;
+}
+
+SimdLevel simdLevel() {
+    return dispatch().level.load(std::memory_order_relaxed);
+}
+
+void setSimdLevel(SimdLevel level) {
+    if (!supports(level)) {
+        throw std::invalid_argument(std::string("This processor does not support ") +
+                                    simdLevelName(level));
+    }
+    dispatch().level.store(level, std::memory_order_relaxed);
+    dispatch().kernel.store(kernelFor(level), std::memory_order_relaxed);
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2:
+            return "AVX2";
+        case SimdLevel::SSE4:
+            return "SSE4.1";
+        default:
+            return "scalar";
+    }
+}
+
+int intersectTriangleBlock(const TriangleBlock& block, const BlockRay& ray, float t_min,
+                           float t_max, BlockHit& hit) {
+    return dispatch().kernel.load(std::memory_order_relaxed)(block, ray, t_min, t_max, hit);
+}
+
+} // namespace Prism
@@ -0,0 +1,337 @@
+#include "Prism/triangle_mesh.hpp"
+#include "Prism/mesh_cache.hpp"
+#include "Prism/stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Prism {
+
+namespace {
+
+Point3 vertex(const ArrayView<float>& positions, uint32_t i) {
+    return Point3(positions[3 * i], positions[3 * i + 1], positions[3 * i + 2]);
+}
+
+template <typename T> std::vector<T> permute(const ArrayView<T>& values, size_t stride,
+                                             const std::vector<uint32_t>& order) {
+    std::vector<T> permuted;
+    permuted.reserve(values.size());
+    for (uint32_t primitive : order) {
+        for (size_t k = 0; k < stride; ++k) {
+            permuted.push_back(values[stride * primitive + k]);
+        }
+    }
+    return permuted;
+}
+
+// Recomputes a hit found by the single-precision kernel in full precision. Returns false if
+// the triangle is degenerate at this precision, in which case the kernel values are kept.
+bool refine(const Point3& p0, const Vector3& e1, const Vector3& e2, const Ray& ray, ld& t, ld& u,
+            ld& v) {
+    const ld e1x = e1.x, e1y = e1.y, e1z = e1.z;
+    const ld e2x = e2.x, e2y = e2.y, e2z = e2.z;
+    const Vector3& d = ray.direction;
+
+    const ld px = d.y * e2z - d.z * e2y;
+    const ld py = d.z * e2x - d.x * e2z;
+    const ld pz = d.x * e2y - d.y * e2x;
+    const ld det = e1x * px + e1y * py + e1z * pz;
+    if (det == 0) {
+        return false;
+    }
+    const ld inv_det = 1 / det;
+
+    const ld sx = ray.origin.x - p0.x;
+    const ld sy = ray.origin.y - p0.y;
+    const ld sz = ray.origin.z - p0.z;
+    const ld qx = sy * e1z - sz * e1y;
+    const ld qy = sz * e1x - sx * e1z;
+    const ld qz = sx * e1y - sy * e1x;
+    u = (sx * px + sy * py + sz * pz) * inv_det;
+    v = (d.x * qx + d.y * qy + d.z * qz) * inv_det;
+    t = (e2x * qx + e2y * qy + e2z * qz) * inv_det;
+    return true;
+}
+
+// Narrows a ray distance for the single-precision kernel. Distances beyond the float range,
+// e.g. a numeric_limits<ld>::max() t_max, saturate instead of overflowing the conversion.
+float kernelDistance(ld t) {
+    const ld limit = std::numeric_limits<float>::max();
+    return static_cast<float>(std::max(-limit, std::min(t, limit)));
+}
+
+} // namespace
+
+TriangleMesh::TriangleMesh(const MeshData& mesh, MaterialTable* materials,
+                           const BVHBuildOptions& bvh) {
+    build({mesh.positions, mesh.normals, mesh.indices, mesh.normal_indices, mesh.material_ids,
+           mesh.material_names.size(), mesh.materials.empty() ? nullptr : mesh.materials.data()},
+          materials, bvh);
+}
+
+TriangleMesh::TriangleMesh(const MeshCache& mesh, MaterialTable* materials,
+                           const BVHBuildOptions& bvh) {
+    build({mesh.positions(), mesh.normals(), mesh.indices(), mesh.normalIndices(),
+           mesh.materialIds(), mesh.materialNames().size(),
+           mesh.materials().empty() ? nullptr : mesh.materials().data()},
+          materials, bvh);
+}
+
+void TriangleMesh::build(const Source& source, MaterialTable* materials, BVHBuildOptions bvh) {
+    StageTimer timer(StatStage::Build);
+    const size_t vertex_count = source.positions.size() / 3;
+    const size_t normal_count = source.normals.size() / 3;
+    const size_t triangle_count = source.material_ids.size();
+    if (source.indices.size() != 3 * triangle_count ||
+        source.normal_indices.size() != 3 * triangle_count) {
+        throw std::invalid_argument("Mesh arrays have inconsistent sizes");
+    }
+
+    x_.resize(vertex_count);
+    y_.resize(vertex_count);
+    z_.resize(vertex_count);
+    for (size_t i = 0; i < vertex_count; ++i) {
+        x_[i] = source.positions[3 * i];
+        y_[i] = source.positions[3 * i + 1];
+        z_[i] = source.positions[3 * i + 2];
+    }
+    nx_.resize(normal_count);
+    ny_.resize(normal_count);
+    nz_.resize(normal_count);
+    for (size_t i = 0; i < normal_count; ++i) {
+        nx_[i] = source.normals[3 * i];
+        ny_[i] = source.normals[3 * i + 1];
+        nz_[i] = source.normals[3 * i + 2];
+    }
+
+    uint16_t first_material = MaterialTable::kNoMaterial;
+    if (materials != nullptr) {
+        first_material = materials->add(source.materials, source.material_count);
+        materials_ = materials;
+    }
+
+    std::vector<uint16_t> material_ids(triangle_count, MaterialTable::kNoMaterial);
+    std::vector<AABB> bounds(triangle_count);
+    bool has_normals = false;
+    for (size_t t = 0; t < triangle_count; ++t) {
+        for (size_t k = 3 * t; k < 3 * t + 3; ++k) {
+            if (source.indices[k] >= vertex_count) {
+                throw std::invalid_argument("Triangle refers to a missing vertex");
+            }
+            if (source.normal_indices[k] != MeshData::kNoIndex) {
+                if (source.normal_indices[k] >= normal_count) {
+                    throw std::invalid_argument("Triangle refers to a missing normal");
+                }
+                has_normals = true;
+            }
+            bounds[t].expand(vertex(source.positions, source.indices[k]));
+        }
+
+        const uint32_t material = source.material_ids[t];
+        if (material != MeshData::kNoIndex) {
+            if (material >= source.material_count) {
+                throw std::invalid_argument("Triangle refers to a missing material");
+            }
+            if (materials_ != nullptr) {
+                material_ids[t] = static_cast<uint16_t>(first_material + material);
+            }
+        }
+    }
+
+    bvh.max_leaf_size = kTriangleBlockWidth;
+    bvh.leaf_width = kTriangleBlockWidth;
+    tree_ = BVHTree(bounds, bvh);
+    const std::vector<uint32_t>& order = tree_.primitiveOrder();
+    indices_ = permute(source.indices, 3, order);
+    if (has_normals) {
+        normal_indices_ = permute(source.normal_indices, 3, order);
+    }
+    material_ids_ = permute(ArrayView<uint16_t>(material_ids), 1, order);
+}
+
+void TriangleMesh::loadBlock(uint32_t first, uint32_t count, TriangleBlock& block) const {
+    const float* axes[3] = {x_.data(), y_.data(), z_.data()};
+    for (uint32_t lane = 0; lane < count; ++lane) {
+        const uint32_t* corner = &indices_[3 * (first + lane)];
+        for (int k = 0; k < 3; ++k) {
+            const float p0 = axes[k][corner[0]];
+            block.v0[k][lane] = p0;
+            block.e1[k][lane] = axes[k][corner[1]] - p0;
+            block.e2[k][lane] = axes[k][corner[2]] - p0;
+        }
+    }
+    for (uint32_t lane = count; lane < kTriangleBlockWidth; ++lane) {
+        for (int k = 0; k < 3; ++k) {
+            block.v0[k][lane] = 0;
+            block.e1[k][lane] = 0;
+            block.e2[k][lane] = 0;
+        }
+    }
+}
+
+bool TriangleMesh::hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const {
+    const BlockRay block_ray = {
+        {static_cast<float>(ray.origin.x), static_cast<float>(ray.origin.y),
+         static_cast<float>(ray.origin.z)},
+        {static_cast<float>(ray.direction.x), static_cast<float>(ray.direction.y),
+         static_cast<float>(ray.direction.z)}};
+    const float t_near = kernelDistance(t_min);
+
+    bool hit_any = false;
+    uint32_t closest = 0;
+    BlockHit closest_hit{};
+    tree_.traverseLeaves(ray, t_min, t_max, [&](const BVHNode& leaf, ld& t_far) {
+        bool hit_leaf = false;
+        for (uint32_t i = 0; i < leaf.count; i += kTriangleBlockWidth) {
+            TriangleBlock block;
+            loadBlock(leaf.offset + i, std::min<uint32_t>(kTriangleBlockWidth, leaf.count - i),
+                      block);
+            BlockHit block_hit;
+            const int lane = intersectTriangleBlock(block, block_ray, t_near,
+                                                    kernelDistance(t_far), block_hit);
+            if (lane >= 0) {
+                t_far = block_hit.t;
+                closest = leaf.offset + i + lane;
+                closest_hit = block_hit;
+                hit_leaf = true;
+            }
+        }
+        hit_any |= hit_leaf;
+        return hit_leaf;
+    });
+    if (!hit_any) {
+        return false;
+    }
+    fillRecord(ray, closest, closest_hit, rec);
+    return true;
+}
+
+bool TriangleMesh::occluded(const Ray& ray, ld t_min, ld t_max) const {
+    const BlockRay block_ray = {
+        {static_cast<float>(ray.origin.x), static_cast<float>(ray.origin.y),
+         static_cast<float>(ray.origin.z)},
+        {static_cast<float>(ray.direction.x), static_cast<float>(ray.direction.y),
+         static_cast<float>(ray.direction.z)}};
+    const float t_near = kernelDistance(t_min);
+    const float t_far = kernelDistance(t_max);
+
+    return tree_.traverseAny(ray, t_min, t_max, [&](const BVHNode& leaf) {
+        for (uint32_t i = 0; i < leaf.count; i += kTriangleBlockWidth) {
+            TriangleBlock block;
+            loadBlock(leaf.offset + i, std::min<uint32_t>(kTriangleBlockWidth, leaf.count - i),
+                      block);
+            BlockHit block_hit;
+            if (intersectTriangleBlock(block, block_ray, t_near, t_far, block_hit) >= 0) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+void TriangleMesh::hitPacket(const RayPacket& packet, ld t_min, PacketHit& hits) const {
+    BlockRay block_rays[RayPacket::kSize];
+    for (int r = 0; r < RayPacket::kSize; ++r) {
+        for (int k = 0; k < 3; ++k) {
+            block_rays[r].origin[k] = static_cast<float>(packet.origin[k][r]);
+            block_rays[r].direction[k] = static_cast<float>(packet.direction[k][r]);
+        }
+    }
+    const float t_near = kernelDistance(t_min);
+
+    bool found[RayPacket::kSize] = {};
+    uint32_t closest[RayPacket::kSize];
+    BlockHit closest_hit[RayPacket::kSize];
+    tree_.traversePacket(packet, t_min, hits.t_max, [&](const BVHNode& leaf) {
+        for (uint32_t i = 0; i < leaf.count; i += kTriangleBlockWidth) {
+            // One gather serves every ray of the packet.
+            TriangleBlock block;
+            loadBlock(leaf.offset + i, std::min<uint32_t>(kTriangleBlockWidth, leaf.count - i),
+                      block);
+            for (int r = 0; r < RayPacket::kSize; ++r) {
+                if (!packet.active[r]) {
+                    continue;
+                }
+                BlockHit block_hit;
+                const int lane = intersectTriangleBlock(block, block_rays[r], t_near,
+                                                        kernelDistance(hits.t_max[r]), block_hit);
+                if (lane >= 0) {
+                    hits.t_max[r] = block_hit.t;
+                    closest[r] = leaf.offset + i + lane;
+                    closest_hit[r] = block_hit;
+                    found[r] = true;
+                }
+            }
+        }
+    });
+
+    for (int r = 0; r < RayPacket::kSize; ++r) {
+        if (found[r]) {
+            fillRecord(packet.ray(r), closest[r], closest_hit[r], hits.records[r]);
+            hits.t_max[r] = hits.records[r].t;
+            hits.hit[r] = true;
+        }
+    }
+}
+
+void TriangleMesh::fillRecord(const Ray& ray, uint32_t triangle, const BlockHit& block_hit,
+                              HitRecord& rec) const {
+    const uint32_t* corner = &indices_[3 * triangle];
+    const Point3 p0(x_[corner[0]], y_[corner[0]], z_[corner[0]]);
+    const Vector3 e1 = Point3(x_[corner[1]], y_[corner[1]], z_[corner[1]]) - p0;
+    const Vector3 e2 = Point3(x_[corner[2]], y_[corner[2]], z_[corner[2]]) - p0;
+    ld t = block_hit.t;
+    ld u = block_hit.u;
+    ld v = block_hit.v;
+    refine(p0, e1, e2, ray, t, u, v);
+
+    // Vertex normals that cancel out fall back to the geometric normal, and slivers too thin
+    // for a cross product to the reversed ray, so a bad triangle never stops a render.
+    Vector3 normal = e1.cross(e2);
+    ld length = normal.magnitude();
+    if (!normal_indices_.empty()) {
+        const uint32_t* n = &normal_indices_[3 * triangle];
+        if (n[0] != MeshData::kNoIndex && n[1] != MeshData::kNoIndex &&
+            n[2] != MeshData::kNoIndex) {
+            const ld w = 1 - u - v;
+            const Vector3 shading(w * nx_[n[0]] + u * nx_[n[1]] + v * nx_[n[2]],
+                                  w * ny_[n[0]] + u * ny_[n[1]] + v * ny_[n[2]],
+                                  w * nz_[n[0]] + u * nz_[n[1]] + v * nz_[n[2]]);
+            const ld shading_length = shading.magnitude();
+            if (shading_length > 0) {
+                normal = shading;
+                length = shading_length;
+            }
+        }
+    }
+    if (!(length > 0)) {
+        normal = ray.direction * -1;
+        length = normal.magnitude();
+    }
+
+    rec.t = t;
+    rec.p = ray.origin + ray.direction * t;
+    rec.material = material_ids_[triangle] == MaterialTable::kNoMaterial
+                       ? nullptr
+                       : &(*materials_)[material_ids_[triangle]];
+    rec.set_face_normal(ray, normal / length);
+}
+
+bool TriangleMesh::boundingBox(AABB& box) const {
+    if (triangleCount() == 0) {
+        return false;
+    }
+    box = tree_.bounds();
+    return true;
+}
+
+size_t TriangleMesh::memoryUsage() const {
+    return sizeof(float) * (x_.capacity() + y_.capacity() + z_.capacity()) +
+           sizeof(float) * (nx_.capacity() + ny_.capacity() + nz_.capacity()) +
+           sizeof(uint32_t) * (indices_.capacity() + normal_indices_.capacity()) +
+           sizeof(uint16_t) * material_ids_.capacity();
+}
+
+} // namespace Prism
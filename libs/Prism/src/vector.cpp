@@ -4,16 +4,11 @@
 #include <cmath>
 #include <stdexcept>
 
-using ld = long double;
-
 namespace Prism {
 
 Vector3::Vector3(ld x, ld y, ld z) : x(x), y(y), z(z) {
 }
 
-Vector3::Vector3(const Vector3& v) : x(v.x), y(v.y), z(v.z) {
-}
-
 Vector3::Vector3(const Point3& v) : x(v.x), y(v.y), z(v.z) {
 }
 
@@ -35,15 +30,6 @@ bool Vector3::operator!=(const Vector3& v) const {
     return !(*this == v);
 }
 
-Vector3& Vector3::operator=(const Vector3& v) {
-    if (this != &v) {
-        x = v.x;
-        y = v.y;
-        z = v.z;
-    }
-    return *this;
-}
-
 Vector3 Vector3::operator+(const Vector3& v) const {
     return Vector3(x + v.x, y + v.y, z + v.z);
 }
@@ -0,0 +1,380 @@
+#include "Prism/wavefront.hpp"
+#include "Prism/accumulator.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/scene.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Prism {
+
+namespace {
+
+const ld kPi = std::acos(ld(-1));
+
+// States of a shadow slot.
+constexpr uint8_t kShadowNone = 0;    // No shadow ray: light behind the surface or path missed.
+constexpr uint8_t kShadowPending = 1; // Traced by the connect stage.
+constexpr uint8_t kShadowVisible = 2; // Nothing blocks the light.
+
+void resizeAll(std::vector<ld> (&arrays)[3], size_t n) {
+    for (std::vector<ld>& array : arrays) {
+        array.resize(n);
+    }
+}
+
+// Adds the time until destruction to one stage.
+class WavefrontTimer {
+  public:
+    WavefrontTimer(WavefrontStats& stats, WavefrontStage stage)
+        : seconds_(stats.stage_seconds[static_cast<int>(stage)]),
+          start_(std::chrono::steady_clock::now()) {
+    }
+
+    ~WavefrontTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        seconds_ += std::chrono::duration<double>(elapsed).count();
+    }
+
+  private:
+    double& seconds_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace
+
+const char* wavefrontStageName(WavefrontStage stage) {
+    switch (stage) {
+        case WavefrontStage::Generate:
+            return "generate";
+        case WavefrontStage::Extend:
+            return "extend";
+        case WavefrontStage::Shade:
+            return "shade";
+        case WavefrontStage::Connect:
+            return "connect";
+        case WavefrontStage::Accumulate:
+            return "accumulate";
+    }
+    return "unknown";
+}
+
+void WavefrontIntegrator::PathBuffer::resize(size_t n) {
+    resizeAll(origin, n);
+    resizeAll(direction, n);
+    resizeAll(throughput, n);
+    pixel.resize(n);
+    sample.resize(n);
+    size = n;
+}
+
+void WavefrontIntegrator::HitBuffer::resize(size_t n) {
+    hit.resize(n);
+    resizeAll(point, n);
+    resizeAll(normal, n);
+    material.resize(n);
+}
+
+void WavefrontIntegrator::ShadowBuffer::resize(size_t n) {
+    resizeAll(direction, n);
+    distance.resize(n);
+    resizeAll(contribution, n);
+    state.resize(n);
+}
+
+WavefrontIntegrator::WavefrontIntegrator(size_t thread_count, const WavefrontSettings& settings)
+    : pool_(thread_count), sampler_(new SobolSampler()) {
+    setSettings(settings);
+}
+
+void WavefrontIntegrator::setSettings(const WavefrontSettings& settings) {
+    if (settings.max_depth < 0 || settings.roulette_depth < 0 || !(settings.ray_epsilon >= 0) ||
+        settings.chunk_size == 0) {
+        throw std::invalid_argument("Invalid wavefront settings.");
+    }
+    settings_ = settings;
+}
+
+template <typename Body> void WavefrontIntegrator::forChunks(size_t count, Body&& body) {
+    const size_t chunk = settings_.chunk_size;
+    pool_.parallelFor((count + chunk - 1) / chunk, [&](size_t c) {
+        body(c * chunk, std::min(count, (c + 1) * chunk));
+    });
+}
+
+void WavefrontIntegrator::renderPass(const Camera& camera, const Scene& scene,
+                                     Accumulator& accumulator) {
+    if (accumulator.width() != camera.pixel_width ||
+        accumulator.height() != camera.pixel_height) {
+        throw std::invalid_argument("Accumulation buffer size does not match the camera image.");
+    }
+    if (!scene.isBuilt()) {
+        throw std::logic_error("Scene must be built before tracing rays.");
+    }
+
+    generate(camera, accumulator);
+    for (int depth = 0; depth <= settings_.max_depth && paths_.size > 0; ++depth) {
+        extend(scene);
+        shade(depth, camera.pixel_width);
+        connect(scene);
+        accumulate(depth);
+    }
+
+    WavefrontTimer timer(stats_, WavefrontStage::Accumulate);
+    const int width = accumulator.width();
+    forChunks(radiance_[0].size(), [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            accumulator.add(static_cast<int>(p % width), static_cast<int>(p / width),
+                            Vector3(radiance_[0][p], radiance_[1][p], radiance_[2][p]));
+        }
+    });
+}
+
+void WavefrontIntegrator::generate(const Camera& camera, const Accumulator& accumulator) {
+    WavefrontTimer timer(stats_, WavefrontStage::Generate);
+    const int width = camera.pixel_width;
+    const size_t count = static_cast<size_t>(width) * camera.pixel_height;
+    paths_.resize(count);
+    for (std::vector<ld>& channel : radiance_) {
+        channel.assign(count, 0);
+    }
+
+    forChunks(count, [&](size_t begin, size_t end) {
+        const std::unique_ptr<Sampler> sampler = sampler_->clone();
+        for (size_t i = begin; i < end; ++i) {
+            const int x = static_cast<int>(i % width);
+            const int y = static_cast<int>(i / width);
+            const uint32_t index = accumulator.samples(x, y);
+            sampler->startPixelSample(x, y, index);
+            const Ray ray = camera.getRay(x, y, *sampler);
+            paths_.origin[0][i] = ray.origin.x;
+            paths_.origin[1][i] = ray.origin.y;
+            paths_.origin[2][i] = ray.origin.z;
+            paths_.direction[0][i] = ray.direction.x;
+            paths_.direction[1][i] = ray.direction.y;
+            paths_.direction[2][i] = ray.direction.z;
+            paths_.pixel[i] = static_cast<uint32_t>(i);
+            paths_.sample[i] = index;
+        }
+    });
+    for (std::vector<ld>& channel : paths_.throughput) {
+        std::fill(channel.begin(), channel.end(), ld(1));
+    }
+}
+
+void WavefrontIntegrator::extend(const Scene& scene) {
+    WavefrontTimer timer(stats_, WavefrontStage::Extend);
+    const size_t count = paths_.size;
+    hits_.resize(count);
+    stats_.extension_rays += count;
+
+    forChunks(count, [&](size_t begin, size_t end) {
+        HitRecord rec;
+        for (size_t i = begin; i < end; ++i) {
+            const Ray ray(
+                Point3(paths_.origin[0][i], paths_.origin[1][i], paths_.origin[2][i]),
+                Vector3(paths_.direction[0][i], paths_.direction[1][i], paths_.direction[2][i]));
+            const bool hit =
+                scene.hit(ray, settings_.ray_epsilon, std::numeric_limits<ld>::infinity(), rec);
+            hits_.hit[i] = hit;
+            if (!hit) {
+                continue;
+            }
+            // Lambertian surfaces shade the side the ray comes from.
+            const ld side = rec.normal.dot(ray.direction) > 0 ? -1 : 1;
+            hits_.point[0][i] = rec.p.x;
+            hits_.point[1][i] = rec.p.y;
+            hits_.point[2][i] = rec.p.z;
+            hits_.normal[0][i] = side * rec.normal.x;
+            hits_.normal[1][i] = side * rec.normal.y;
+            hits_.normal[2][i] = side * rec.normal.z;
+            hits_.material[i] =
+                rec.material != nullptr ? rec.material : &settings_.default_material;
+        }
+    });
+}
+
+void WavefrontIntegrator::shade(int depth, int width) {
+    WavefrontTimer timer(stats_, WavefrontStage::Shade);
+    const size_t count = paths_.size;
+    const size_t light_count = lights_.size();
+    shadows_.resize(count * light_count);
+    alive_.resize(count);
+    const ld* background[3] = {&settings_.background.x, &settings_.background.y,
+                               &settings_.background.z};
+
+    forChunks(count, [&](size_t begin, size_t end) {
+        const std::unique_ptr<Sampler> sampler = sampler_->clone();
+        for (size_t i = begin; i < end; ++i) {
+            ld* throughput[3] = {&paths_.throughput[0][i], &paths_.throughput[1][i],
+                                 &paths_.throughput[2][i]};
+            const uint32_t pixel = paths_.pixel[i];
+            if (!hits_.hit[i]) {
+                for (int c = 0; c < 3; ++c) {
+                    radiance_[c][pixel] += *throughput[c] * *background[c];
+                }
+                std::fill_n(shadows_.state.begin() + i * light_count, light_count, kShadowNone);
+                alive_[i] = 0;
+                continue;
+            }
+
+            const Material& material = *hits_.material[i];
+            const ld emitted[3] = {material.ke.x, material.ke.y, material.ke.z};
+            const ld albedo[3] = {material.kd.x, material.kd.y, material.kd.z};
+            const ld p[3] = {hits_.point[0][i], hits_.point[1][i], hits_.point[2][i]};
+            const ld n[3] = {hits_.normal[0][i], hits_.normal[1][i], hits_.normal[2][i]};
+            for (int c = 0; c < 3; ++c) {
+                radiance_[c][pixel] += *throughput[c] * emitted[c];
+            }
+
+            // Direct light: a shadow ray per point light in front of the surface.
+            for (size_t k = 0; k < light_count; ++k) {
+                const size_t slot = i * light_count + k;
+                const PointLight& light = lights_[k];
+                const ld to_light[3] = {light.position.x - p[0], light.position.y - p[1],
+                                        light.position.z - p[2]};
+                const ld distance2 = to_light[0] * to_light[0] + to_light[1] * to_light[1] +
+                                     to_light[2] * to_light[2];
+                const ld distance = std::sqrt(distance2);
+                const ld cosine =
+                    (n[0] * to_light[0] + n[1] * to_light[1] + n[2] * to_light[2]) / distance;
+                if (!(cosine > 0) || distance <= settings_.ray_epsilon) {
+                    shadows_.state[slot] = kShadowNone;
+                    continue;
+                }
+                const ld intensity[3] = {light.intensity.x, light.intensity.y,
+                                         light.intensity.z};
+                const ld scale = cosine / (kPi * distance2);
+                for (int c = 0; c < 3; ++c) {
+                    shadows_.direction[c][slot] = to_light[c] / distance;
+                    shadows_.contribution[c][slot] =
+                        *throughput[c] * albedo[c] * intensity[c] * scale;
+                }
+                shadows_.distance[slot] = distance;
+                shadows_.state[slot] = kShadowPending;
+            }
+
+            if (depth == settings_.max_depth) {
+                alive_[i] = 0;
+                continue;
+            }
+
+            // Replay the dimensions of the camera and the earlier bounces of this sample.
+            sampler->startPixelSample(static_cast<int>(pixel % width),
+                                      static_cast<int>(pixel / width), paths_.sample[i]);
+            sampler->get2D();
+            for (int d = 0; d < depth; ++d) {
+                sampler->get2D();
+                sampler->get1D();
+            }
+            const Sample2D u = sampler->get2D();
+            const ld roulette = sampler->get1D();
+
+            // Cosine-distributed bounce around n, in the basis of Duff et al. (2017).
+            const ld sign = std::copysign(ld(1), n[2]);
+            const ld a = -1 / (sign + n[2]);
+            const ld b = n[0] * n[1] * a;
+            const ld tangent[3] = {1 + sign * n[0] * n[0] * a, sign * b, -sign * n[0]};
+            const ld bitangent[3] = {b, sign + n[1] * n[1] * a, -n[1]};
+            const ld r = std::sqrt(u.u);
+            const ld phi = 2 * kPi * u.v;
+            const ld lx = r * std::cos(phi);
+            const ld ly = r * std::sin(phi);
+            const ld lz = std::sqrt(std::max(ld(0), 1 - u.u));
+            ld survival = 0;
+            for (int c = 0; c < 3; ++c) {
+                paths_.origin[c][i] = p[c];
+                paths_.direction[c][i] = tangent[c] * lx + bitangent[c] * ly + n[c] * lz;
+                *throughput[c] *= albedo[c];
+                survival = std::max(survival, *throughput[c]);
+            }
+
+            if (depth + 1 >= settings_.roulette_depth && survival < 1) {
+                if (roulette >= survival) {
+                    alive_[i] = 0;
+                    continue;
+                }
+                for (int c = 0; c < 3; ++c) {
+                    *throughput[c] /= survival;
+                }
+            }
+            alive_[i] = survival > 0;
+        }
+    });
+}
+
+void WavefrontIntegrator::connect(const Scene& scene) {
+    WavefrontTimer timer(stats_, WavefrontStage::Connect);
+    const size_t light_count = lights_.size();
+    std::atomic<uint64_t> traced{0};
+
+    forChunks(paths_.size * light_count, [&](size_t begin, size_t end) {
+        uint64_t chunk_traced = 0;
+        for (size_t slot = begin; slot < end; ++slot) {
+            if (shadows_.state[slot] != kShadowPending) {
+                continue;
+            }
+            const size_t i = slot / light_count;
+            const Ray ray(
+                Point3(hits_.point[0][i], hits_.point[1][i], hits_.point[2][i]),
+                Vector3(shadows_.direction[0][slot], shadows_.direction[1][slot],
+                        shadows_.direction[2][slot]));
+            ++chunk_traced;
+            if (!scene.occluded(ray, settings_.ray_epsilon,
+                                shadows_.distance[slot] - settings_.ray_epsilon)) {
+                shadows_.state[slot] = kShadowVisible;
+            }
+        }
+        traced.fetch_add(chunk_traced, std::memory_order_relaxed);
+    });
+    stats_.shadow_rays += traced.load();
+}
+
+void WavefrontIntegrator::accumulate(int depth) {
+    WavefrontTimer timer(stats_, WavefrontStage::Accumulate);
+    const size_t count = paths_.size;
+    const size_t light_count = lights_.size();
+
+    // Every live path belongs to a different pixel, so the chunks never write the same pixel.
+    forChunks(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t pixel = paths_.pixel[i];
+            for (size_t slot = i * light_count; slot < (i + 1) * light_count; ++slot) {
+                if (shadows_.state[slot] == kShadowVisible) {
+                    for (int c = 0; c < 3; ++c) {
+                        radiance_[c][pixel] += shadows_.contribution[c][slot];
+                    }
+                }
+            }
+        }
+    });
+    if (depth == settings_.max_depth) {
+        return;
+    }
+
+    // Move the live paths to the front, in order, so the next bounce only sees them.
+    size_t live = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!alive_[i]) {
+            continue;
+        }
+        if (live != i) {
+            for (int c = 0; c < 3; ++c) {
+                paths_.origin[c][live] = paths_.origin[c][i];
+                paths_.direction[c][live] = paths_.direction[c][i];
+                paths_.throughput[c][live] = paths_.throughput[c][i];
+            }
+            paths_.pixel[live] = paths_.pixel[i];
+            paths_.sample[live] = paths_.sample[i];
+        }
+        ++live;
+    }
+    paths_.size = live;
+}
+
+} // namespace Prism
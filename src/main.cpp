@@ -1,6 +1,10 @@
 #include "ObjReader/ObjReader.hpp"
 #include "Prism.hpp"
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 int main() {
     Prism::Vector3 v1(1, 2, 3);
@@ -14,9 +18,69 @@ int main() {
 
     std::cout << "Hello, Sílvio!" << std::endl;
 
-    objReader obj("data/inputs/cubo.obj");
+    // Reuse the binary mesh cache while it matches the OBJ and MTL it was built from, and parse
+    // the OBJ again when there is none or an asset has changed since. The cache stays mapped and
+    // the mesh is built from it in place.
+    const std::string obj_path = "data/inputs/cubo.obj";
+    const std::string cache_path = "data/inputs/cubo.pmesh";
+    const Prism::SourceFingerprint source =
+        Prism::fingerprintSources(obj_path, "data/inputs/cubo.mtl");
+    std::unique_ptr<Prism::MeshCache> cache;
+    try {
+        cache = std::make_unique<Prism::MeshCache>(cache_path);
+        if (cache->source() == source) {
+            std::cout << "Loaded " << cache->triangleCount() << " triangles from " << cache_path
+                      << std::endl;
+        } else {
+            cache.reset();
+        }
+    } catch (const std::runtime_error&) {
+        // No cache yet, or one written by another version: read the OBJ below.
+    }
+    Prism::MeshData mesh;
+    if (!cache) {
+        objReader obj(obj_path);
 
-    obj.print_faces();
+        obj.print_faces();
+
+        mesh = Prism::meshDataFromObjReader(std::move(obj));
+        if (mesh.triangleCount() > 0) {
+            Prism::writeMeshCache(cache_path, mesh, source);
+        }
+    }
+
+    // Render the mesh from a corner of its bounding box, streaming the rows to disk.
+    if ((cache ? cache->triangleCount() : mesh.triangleCount()) > 0) {
+        Prism::TriangleMesh object =
+            cache ? Prism::TriangleMesh(*cache) : Prism::TriangleMesh(mesh);
+        Prism::Scene scene({&object});
+        Prism::AABB box;
+        object.boundingBox(box);
+        const Prism::Point3 center = box.centroid();
+        const Prism::Vector3 diagonal = box.max - box.min;
+        const Prism::Point3 eye = center + diagonal * 1.2;
+
+        const int size = 512;
+        Prism::Camera camera(eye, center, Prism::Vector3(0, 1, 0), 1.0, 1.0, 1.0, size, size);
+        Prism::Renderer renderer;
+        Prism::ImageWriter image("cubo.png", size, size);
+        renderer.render(
+            camera,
+            [&scene](const Prism::Ray& ray) {
+                Prism::HitRecord rec;
+                if (!scene.hit(ray, 0.001, 1e9, rec)) {
+                    return Prism::Vector3(0.1, 0.1, 0.1);
+                }
+                return (rec.normal + Prism::Vector3(1, 1, 1)) * 0.5;
+            },
+            image);
+        std::cout << "Wrote cubo.png" << std::endl;
+    }
+
+    // Machine-readable summary of the run when Prism was built with PRISM_ENABLE_STATS.
+    if (Prism::kStatsEnabled) {
+        Prism::writeStatsJson(std::cout, Prism::statsSnapshot());
+    }
 
     return 0;
 }
\ No newline at end of file
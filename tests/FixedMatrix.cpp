@@ -0,0 +1,119 @@
+#include "Prism/fixed_matrix.hpp"
+#include "Prism/matrix.hpp"
+#include "Prism/point.hpp"
+#include "Prism/utils.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <type_traits>
+
+using Prism::FixedMatrix;
+using Prism::kEpsilon;
+using Prism::ld;
+using Prism::Mat3;
+using Prism::Mat4;
+using Prism::Matrix;
+using Prism::Point3;
+using Prism::Vector3;
+
+namespace {
+
+template <typename T, size_t R, size_t C>
+void AssertFixedMatrixAlmostEqual(const FixedMatrix<T, R, C>& m1,
+                                  const FixedMatrix<T, R, C>& m2) {
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < C; ++j) {
+            ASSERT_NEAR(m1(i, j), m2(i, j), kEpsilon);
+        }
+    }
+}
+
+} // namespace
+
+TEST(FixedMatrixTest, ConstructionAndAccess) {
+    static_assert(sizeof(Mat4) == 16 * sizeof(ld), "FixedMatrix must not carry extra storage");
+    static_assert(std::is_trivially_copyable<Mat4>::value, "FixedMatrix must be a plain value");
+
+    constexpr FixedMatrix<int, 2, 3> zero;
+    static_assert(zero(1, 2) == 0, "Default construction must zero the matrix");
+
+    FixedMatrix<int, 2, 3> m = {{1, 2, 3}, {4, 5, 6}};
+    ASSERT_EQ(m.getRows(), 2);
+    ASSERT_EQ(m.getCols(), 3);
+    ASSERT_EQ(m[1][1], 5);
+    ASSERT_EQ(m(0, 2), 3);
+
+    m[0][2] = 42;
+    ASSERT_EQ(m(0, 2), 42);
+    ASSERT_EQ(m.data()[2], 42);
+
+    ASSERT_THROW((FixedMatrix<int, 2, 2>{{1, 2}, {3}}), std::invalid_argument);
+    ASSERT_THROW((FixedMatrix<int, 2, 2>{{1, 2}}), std::invalid_argument);
+}
+
+TEST(FixedMatrixTest, FromDynamicMatrix) {
+    Matrix<ld> dynamic = Prism::orthonormalBasisContaining(Vector3(1, 2, 3));
+    Mat3 fixed(dynamic);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            ASSERT_EQ(fixed(i, j), dynamic[i][j]);
+        }
+    }
+
+    ASSERT_THROW(Mat4{dynamic}, std::invalid_argument);
+}
+
+TEST(FixedMatrixTest, MultiplicationAndTranspose) {
+    FixedMatrix<double, 2, 3> m1 = {{1, 2, 3}, {4, 5, 6}};
+    FixedMatrix<double, 3, 2> m2 = {{7, 8}, {9, 10}, {11, 12}};
+
+    FixedMatrix<double, 2, 2> expected = {{58, 64}, {139, 154}};
+    ASSERT_TRUE(m1 * m2 == expected);
+    ASSERT_TRUE(m1.transpose() == (FixedMatrix<double, 3, 2>{{1, 4}, {2, 5}, {3, 6}}));
+
+    FixedMatrix<double, 2, 2> scaled = expected * 0.5;
+    ASSERT_DOUBLE_EQ(scaled(1, 1), 77);
+    scaled *= 2.0;
+    ASSERT_TRUE(scaled == expected);
+
+    Mat3 identity = Mat3::identity();
+    Mat3 m = {{2, 0, 1}, {1, 3, 2}, {1, 1, 1}};
+    ASSERT_TRUE(m * identity == m);
+    m *= identity;
+    ASSERT_TRUE(identity * m == m);
+}
+
+TEST(FixedMatrixTest, InverseAndDeterminant) {
+    Mat3 m = {{2, 0, 1}, {1, 3, 2}, {1, 1, 2}};
+    ASSERT_NEAR(m.determinant(), 6, kEpsilon);
+    AssertFixedMatrixAlmostEqual(m * m.inverse(), Mat3::identity());
+
+    Mat4 t = Prism::translation(Vector3(1, -2, 3)) * Prism::rotation(Vector3(1, 1, 0), 0.7) *
+             Prism::scaling(Vector3(2, 3, 4));
+    AssertFixedMatrixAlmostEqual(t.inverse() * t, Mat4::identity());
+    ASSERT_NEAR(t.determinant(), 24, 1e3 * kEpsilon);
+
+    Mat3 singular = {{1, 2, 3}, {2, 4, 6}, {0, 1, 1}};
+    ASSERT_EQ(singular.determinant(), 0);
+    ASSERT_THROW(singular.inverse(), std::invalid_argument);
+}
+
+TEST(FixedMatrixTest, TransformsPointsVectorsAndNormals) {
+    Mat4 move = Prism::translation(Vector3(1, 2, 3));
+    AssertPointAlmostEqual(Prism::transformPoint(move, Point3(1, 1, 1)), Point3(2, 3, 4));
+    AssertVectorAlmostEqual(Prism::transformVector(move, Vector3(1, 1, 1)), Vector3(1, 1, 1));
+
+    const ld pi = std::acos(ld(-1));
+    Mat4 turn = Prism::rotation(Vector3(0, 0, 1), pi / 2);
+    AssertVectorAlmostEqual(Prism::transformVector(turn, Vector3(1, 0, 0)), Vector3(0, 1, 0));
+
+    Mat3 swap = {{0, 1, 0}, {1, 0, 0}, {0, 0, 1}};
+    AssertVectorAlmostEqual(Prism::transformVector(swap, Vector3(1, 2, 3)), Vector3(2, 1, 3));
+
+    // A plane with normal (1, 1, 0) squashed along x: the normal must stay perpendicular.
+    Mat4 squash = Prism::scaling(Vector3(0.5, 1, 1));
+    Vector3 tangent = Prism::transformVector(squash, Vector3(1, -1, 0));
+    Vector3 normal = Prism::transformNormal(squash.inverse(), Vector3(1, 1, 0));
+    ASSERT_NEAR(tangent.dot(normal), 0, kEpsilon);
+}
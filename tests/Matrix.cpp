@@ -3,7 +3,7 @@
 #include <gtest/gtest.h>
 
 using Prism::Matrix;
-using ld = long double;
+using Prism::ld;
 
 TEST(MatrixTest, Construction) {
     Matrix<double> m1(2, 3);
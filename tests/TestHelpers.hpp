@@ -1,22 +1,34 @@
 #ifndef TESTS_TESTHELPERS_HPP
 #define TESTS_TESTHELPERS_HPP
 
+#include "Prism/aabb.hpp"
 #include "Prism/matrix.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/objects.hpp"
 #include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/scene.hpp"
 #include "Prism/vector.hpp"
+#include <cmath>
+#include <cstdint>
 #include <gtest/gtest.h>
+#include <type_traits>
 
 namespace Prism {
-using ld = long double;
+
+/**
+ * @brief Default tolerance for comparisons, scaled to the configured precision of ld.
+ */
+constexpr ld kEpsilon = std::is_same<ld, float>::value ? ld(1e-4) : ld(1e-9);
 
 /**
  * @brief Asserts that two Point3 objects are almost equal within a given epsilon.
  * @param p1 The first point to compare.
  * @param p2 The second point to compare.
- * @param eps The epsilon value for comparison (default is 1e-9).
+ * @param eps The epsilon value for comparison (default is kEpsilon).
  * @note This function compares each corresponding component using ASSERT_NEAR.
  */
-inline void AssertPointAlmostEqual(const Point3& p1, const Point3& p2, ld eps = 1e-9) {
+inline void AssertPointAlmostEqual(const Point3& p1, const Point3& p2, ld eps = kEpsilon) {
     ASSERT_NEAR(p1.x, p2.x, eps);
     ASSERT_NEAR(p1.y, p2.y, eps);
     ASSERT_NEAR(p1.z, p2.z, eps);
@@ -26,10 +38,10 @@ inline void AssertPointAlmostEqual(const Point3& p1, const Point3& p2, ld eps =
  * @brief Asserts that two Vector3 objects are almost equal within a given epsilon.
  * @param v1 The first vector to compare.
  * @param v2 The second vector to compare.
- * @param eps The epsilon value for comparison (default is 1e-9).
+ * @param eps The epsilon value for comparison (default is kEpsilon).
  * @note This function compares each corresponding component using ASSERT_NEAR.
  */
-inline void AssertVectorAlmostEqual(const Vector3& v1, const Vector3& v2, ld eps = 1e-9) {
+inline void AssertVectorAlmostEqual(const Vector3& v1, const Vector3& v2, ld eps = kEpsilon) {
     ASSERT_NEAR(v1.x, v2.x, eps);
     ASSERT_NEAR(v1.y, v2.y, eps);
     ASSERT_NEAR(v1.z, v2.z, eps);
@@ -39,7 +51,7 @@ inline void AssertVectorAlmostEqual(const Vector3& v1, const Vector3& v2, ld eps
  * @brief Asserts that two Matrix objects are almost equal within a given epsilon.
  * @param m1 The first matrix to compare.
  * @param m2 The second matrix to compare.
- * @param eps The epsilon value for comparison (default is 1e-9).
+ * @param eps The epsilon value for comparison (default is kEpsilon).
  * @tparam T The type of elements in the matrix (should support near comparison).
  * @throws std::out_of_range if the matrices have different dimensions.
  * @throws std::invalid_argument if the matrices are empty.
@@ -48,7 +60,7 @@ inline void AssertVectorAlmostEqual(const Vector3& v1, const Vector3& v2, ld eps
  *       and then compares each corresponding element using ASSERT_NEAR.
  */
 template <typename T>
-void AssertMatrixAlmostEqual(const Matrix<T>& m1, const Matrix<T>& m2, ld eps = 1e-9) {
+void AssertMatrixAlmostEqual(const Matrix<T>& m1, const Matrix<T>& m2, ld eps = kEpsilon) {
     ASSERT_EQ(m1.getRows(), m2.getRows());
     ASSERT_EQ(m1.getCols(), m2.getCols());
     for (size_t i = 0; i < m1.getRows(); ++i) {
@@ -58,6 +70,94 @@ void AssertMatrixAlmostEqual(const Matrix<T>& m1, const Matrix<T>& m2, ld eps =
     }
 }
 
+/**
+ * @brief Minimal bounded sphere used to exercise the acceleration structures.
+ */
+class TestSphere : public Object {
+  public:
+    TestSphere(const Point3& center, ld radius) : center(center), radius(radius) {
+    }
+
+    bool hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const override {
+        const Vector3& dir = ray.Direction();
+        Vector3 oc = ray.origin - center;
+        ld a = dir.dot(dir);
+        ld half_b = oc.dot(dir);
+        ld c = oc.dot(oc) - radius * radius;
+        ld discriminant = half_b * half_b - a * c;
+        if (discriminant < 0) {
+            return false;
+        }
+
+        ld sqrtd = std::sqrt(discriminant);
+        ld root = (-half_b - sqrtd) / a;
+        if (root <= t_min || root >= t_max) {
+            root = (-half_b + sqrtd) / a;
+            if (root <= t_min || root >= t_max) {
+                return false;
+            }
+        }
+
+        rec.t = root;
+        rec.p = ray.origin + dir * root;
+        rec.material = nullptr;
+        rec.set_face_normal(ray, (rec.p - center) / radius);
+        return true;
+    }
+
+    bool boundingBox(AABB& box) const override {
+        Vector3 extent(radius, radius, radius);
+        box = AABB(center + extent * -1, center + extent);
+        return true;
+    }
+
+    Point3 center;
+    ld radius;
+};
+
+/**
+ * @brief Two spheres over a big floor sphere, with light positions above and below them, for
+ * shadow and lighting tests.
+ */
+struct LitScene {
+    LitScene()
+        : floor(Point3(0, -1001, -5), 1000), ball(Point3(0, 0, -5), 1),
+          small(Point3(1.5, 1, -4), 0.4), scene({&floor, &ball, &small}) {
+    }
+
+    TestSphere floor;
+    TestSphere ball;
+    TestSphere small;
+    Scene scene;
+    Point3 lights[3] = {Point3(-3, 4, 1), Point3(3, 4, 1), Point3(0, -4, 2)};
+};
+
+/**
+ * @brief Builds an n x n vertex grid spanning [-size / 2, size / 2) in x and y, two triangles per
+ * cell, without normals or materials.
+ * @param n The number of vertices along each side.
+ * @param size The extent of the grid along x and y.
+ * @param height Called as height(x, y) for the z coordinate of every vertex.
+ */
+template <typename Height> MeshData GridMesh(uint32_t n, float size, Height&& height) {
+    MeshData grid;
+    for (uint32_t j = 0; j < n; ++j) {
+        for (uint32_t i = 0; i < n; ++i) {
+            const float x = size * (float(i) / n - 0.5f), y = size * (float(j) / n - 0.5f);
+            grid.positions.insert(grid.positions.end(), {x, y, height(x, y)});
+        }
+    }
+    for (uint32_t j = 0; j + 1 < n; ++j) {
+        for (uint32_t i = 0; i + 1 < n; ++i) {
+            const uint32_t a = j * n + i;
+            grid.indices.insert(grid.indices.end(), {a, a + 1, a + n + 1, a, a + n + 1, a + n});
+        }
+    }
+    grid.normal_indices.assign(grid.indices.size(), MeshData::kNoIndex);
+    grid.material_ids.assign(grid.indices.size() / 3, MeshData::kNoIndex);
+    return grid;
+}
+
 } // namespace Prism
 
 #endif // TESTS_TESTHELPERS_HPP
\ No newline at end of file
@@ -10,7 +10,8 @@ using Prism ::Matrix;
 using Prism::orthonormalBasisContaining;
 using Prism::Point3;
 using Prism ::Vector3;
-using ld = long double;
+using Prism::kEpsilon;
+using Prism::ld;
 
 TEST(UtilsTest, CentroidOfMultiplePoints) {
     Point3 p1(0.0, 0.0, 0.0);
@@ -65,16 +66,16 @@ TEST(OrthonormalBasisTest, ProducesOrthonormalBasisContainingVector) {
     Vector3 v3 = GetColumn(basis, 2);
 
     // Verify vectors are unit length
-    ASSERT_NEAR(v1.magnitude(), 1.0, 1e-9);
-    ASSERT_NEAR(v2.magnitude(), 1.0, 1e-9);
-    ASSERT_NEAR(v3.magnitude(), 1.0, 1e-9);
+    ASSERT_NEAR(v1.magnitude(), 1.0, kEpsilon);
+    ASSERT_NEAR(v2.magnitude(), 1.0, kEpsilon);
+    ASSERT_NEAR(v3.magnitude(), 1.0, kEpsilon);
 
     // Verify vectors are orthogonal
-    ASSERT_NEAR(v1.dot(v2), 0.0, 1e-9);
-    ASSERT_NEAR(v1.dot(v3), 0.0, 1e-9);
-    ASSERT_NEAR(v2.dot(v3), 0.0, 1e-9);
+    ASSERT_NEAR(v1.dot(v2), 0.0, kEpsilon);
+    ASSERT_NEAR(v1.dot(v3), 0.0, kEpsilon);
+    ASSERT_NEAR(v2.dot(v3), 0.0, kEpsilon);
 
     // Verify that v1 is in the same direction as input.normalized()
     Vector3 normalized_input = input.normalize();
-    ASSERT_NEAR(v1.dot(normalized_input), 1.0, 1e-9); // Should be same direction
+    ASSERT_NEAR(v1.dot(normalized_input), 1.0, kEpsilon); // Should be same direction
 }
\ No newline at end of file
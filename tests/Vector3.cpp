@@ -3,7 +3,8 @@
 #include <gtest/gtest.h>
 
 using Prism::Vector3;
-using ld = long double;
+using Prism::kEpsilon;
+using Prism::ld;
 
 TEST(Vector3Test, ConstructorsAndAssignment) {
     Vector3 v1(1.0, 2.0, 3.0);
@@ -66,8 +67,8 @@ TEST(Vector3Test, DotAndCrossProduct) {
     Vector3 v1(1, 2, 3), v2(4, -5, 6);
 
     ld expected_dot = 1 * 4 + 2 * (-5) + 3 * 6;
-    ASSERT_NEAR(v1.dot(v2), expected_dot, 1e-9);
-    ASSERT_NEAR(v1 * v2, expected_dot, 1e-9);
+    ASSERT_NEAR(v1.dot(v2), expected_dot, kEpsilon);
+    ASSERT_NEAR(v1 * v2, expected_dot, kEpsilon);
 
     Vector3 cross = v1.cross(v2);
     Vector3 expected_cross(27, 6, -13);
@@ -76,10 +77,10 @@ TEST(Vector3Test, DotAndCrossProduct) {
 
 TEST(Vector3Test, MagnitudeAndNormalize) {
     Vector3 v1(3, 4, 0);
-    ASSERT_NEAR(v1.magnitude(), 5.0, 1e-9);
+    ASSERT_NEAR(v1.magnitude(), 5.0, kEpsilon);
 
     Vector3 norm = v1.normalize();
-    ASSERT_NEAR(norm.magnitude(), 1.0, 1e-9);
+    ASSERT_NEAR(norm.magnitude(), 1.0, kEpsilon);
     AssertVectorAlmostEqual(norm, Vector3(0.6, 0.8, 0.0));
 
     Vector3 zero(0, 0, 0);
@@ -0,0 +1,224 @@
+#include "Prism/accumulator.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/image.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/renderer.hpp"
+#include "Prism/vector.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace Prism;
+
+namespace {
+
+Camera MakeCamera() {
+    return Camera(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 24, 20);
+}
+
+// White inside the circle of radius 0.5 on the image plane, black outside: edge pixels converge
+// to the covered fraction of their area.
+Vector3 Disk(const Ray& ray) {
+    const ld x = ray.direction.x / -ray.direction.z;
+    const ld y = ray.direction.y / -ray.direction.z;
+    return x * x + y * y < 0.25 ? Vector3(1, 1, 1) : Vector3(0, 0, 0);
+}
+
+void ExpectSameBuffer(const Accumulator& a, const Accumulator& b) {
+    ASSERT_EQ(a.width(), b.width());
+    ASSERT_EQ(a.height(), b.height());
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            ASSERT_EQ(a.samples(x, y), b.samples(x, y)) << x << " " << y;
+            const Vector3 ma = a.mean(x, y), mb = b.mean(x, y);
+            ASSERT_EQ(ma.x, mb.x) << x << " " << y;
+            ASSERT_EQ(ma.y, mb.y) << x << " " << y;
+            ASSERT_EQ(ma.z, mb.z) << x << " " << y;
+        }
+    }
+}
+
+} // namespace
+
+TEST(AccumulatorTest, AveragesSamples) {
+    Accumulator buffer(3, 2);
+    ASSERT_EQ(buffer.totalSamples(), 0u);
+    buffer.add(1, 1, Vector3(1, 2, 3));
+    buffer.add(1, 1, Vector3(3, 0, 1));
+    ASSERT_EQ(buffer.samples(1, 1), 2u);
+    ASSERT_EQ(buffer.totalSamples(), 2u);
+    const Image image = buffer.resolve();
+    ASSERT_NEAR(image.pixel(1, 1).x, 2, 1e-6);
+    ASSERT_NEAR(image.pixel(1, 1).y, 1, 1e-6);
+    ASSERT_NEAR(image.pixel(1, 1).z, 2, 1e-6);
+    ASSERT_EQ(image.pixel(0, 0).x, 0);
+    ASSERT_THROW(Accumulator(0, 2), std::invalid_argument);
+}
+
+TEST(AccumulatorTest, TracksLuminanceVariance) {
+    Accumulator buffer(2, 1);
+    for (int i = 0; i < 4; ++i) {
+        buffer.add(0, 0, Vector3(0.5, 0.5, 0.5));
+        buffer.add(1, 0, i % 2 ? Vector3(1, 1, 1) : Vector3(0, 0, 0));
+    }
+    ASSERT_EQ(buffer.variance(0, 0), 0);
+    ASSERT_NEAR(buffer.variance(1, 0), 1.0 / 3, 1e-6);
+    ASSERT_NEAR(buffer.standardError(1, 0), std::sqrt(1.0 / 12), 1e-6);
+    ASSERT_NEAR(Accumulator::luminance(Vector3(1, 1, 1)), 1, 1e-6);
+}
+
+TEST(AccumulatorTest, SavesAndLoads) {
+    const std::string path = testing::TempDir() + "prism_accumulator_test.acc";
+    Accumulator buffer(5, 4);
+    buffer.add(4, 3, Vector3(0.25, 0.5, 0.75));
+    buffer.add(0, 0, Vector3(1, 1, 1));
+    buffer.add(0, 0, Vector3(0, 1, 0));
+    buffer.save(path);
+    const Accumulator loaded = Accumulator::load(path);
+    ExpectSameBuffer(loaded, buffer);
+    ASSERT_EQ(loaded.variance(0, 0), buffer.variance(0, 0));
+
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(0);
+        file.put('X');
+    }
+    ASSERT_THROW(Accumulator::load(path), std::runtime_error);
+
+    buffer.save(path);
+    std::ofstream(path, std::ios::binary | std::ios::app).put(0);
+    ASSERT_THROW(Accumulator::load(path), std::runtime_error);
+    std::remove(path.c_str());
+    ASSERT_THROW(Accumulator::load(path), std::runtime_error);
+}
+
+TEST(AccumulatorTest, PassesDoNotDependOnThreads) {
+    const Camera cam = MakeCamera();
+    Accumulator serial(cam.pixel_width, cam.pixel_height);
+    Accumulator parallel(cam.pixel_width, cam.pixel_height);
+    Renderer one(1, 5);
+    Renderer many(4, 7);
+    for (int pass = 0; pass < 3; ++pass) {
+        ASSERT_TRUE(one.renderPass(cam, Disk, serial));
+        ASSERT_TRUE(many.renderPass(cam, Disk, parallel));
+    }
+    ASSERT_EQ(serial.totalSamples(), 3u * cam.pixel_width * cam.pixel_height);
+    ExpectSameBuffer(serial, parallel);
+
+    Accumulator wrong(cam.pixel_width + 1, cam.pixel_height);
+    ASSERT_THROW(one.renderPass(cam, Disk, wrong), std::invalid_argument);
+}
+
+TEST(AccumulatorTest, ResumesFromSavedBuffer) {
+    const std::string path = testing::TempDir() + "prism_accumulator_resume.acc";
+    const Camera cam = MakeCamera();
+    Renderer renderer(2, 8);
+
+    Accumulator straight(cam.pixel_width, cam.pixel_height);
+    for (int pass = 0; pass < 4; ++pass) {
+        renderer.renderPass(cam, Disk, straight);
+    }
+
+    Accumulator first(cam.pixel_width, cam.pixel_height);
+    renderer.renderPass(cam, Disk, first);
+    renderer.renderPass(cam, Disk, first);
+    first.save(path);
+    Accumulator resumed = Accumulator::load(path);
+    renderer.renderPass(cam, Disk, resumed);
+    renderer.renderPass(cam, Disk, resumed);
+    ExpectSameBuffer(straight, resumed);
+    std::remove(path.c_str());
+}
+
+TEST(AccumulatorTest, StopsAtAnyTime) {
+    const Camera cam = MakeCamera();
+    Renderer renderer(1, 8);
+    Accumulator buffer(cam.pixel_width, cam.pixel_height);
+    const std::atomic<bool> stop{true};
+    ASSERT_FALSE(renderer.renderPass(cam, Disk, buffer, &stop));
+    ASSERT_EQ(buffer.totalSamples(), 0u);
+
+    // A stopped buffer still resolves, black where no sample landed.
+    const Image image = buffer.resolve();
+    ASSERT_EQ(image.pixel(12, 10).x, 0);
+}
+
+TEST(AccumulatorTest, ConvergesToPixelCoverage) {
+    const Camera cam = MakeCamera();
+    Renderer renderer(2, 8);
+    Accumulator buffer(cam.pixel_width, cam.pixel_height);
+    for (int pass = 0; pass < 256; ++pass) {
+        renderer.renderPass(cam, Disk, buffer);
+    }
+    const Image image = buffer.resolve();
+
+    // Brute-force coverage on a regular 32x32 grid inside each pixel.
+    ld error = 0;
+    bool found_edge = false;
+    for (int y = 0; y < cam.pixel_height; ++y) {
+        for (int x = 0; x < cam.pixel_width; ++x) {
+            ld coverage = 0;
+            for (int j = 0; j < 32; ++j) {
+                for (int i = 0; i < 32; ++i) {
+                    coverage += Disk(cam.getRay(x, y, (i + 0.5) / 32, (j + 0.5) / 32)).x;
+                }
+            }
+            coverage /= 1024;
+            found_edge = found_edge || (coverage > 0.2 && coverage < 0.8);
+            error = std::max(error, std::abs(image.pixel(x, y).x - coverage));
+        }
+    }
+    ASSERT_TRUE(found_edge);
+    ASSERT_LT(error, 0.12);
+}
+
+TEST(AccumulatorTest, AdaptiveSamplingConcentratesOnEdges) {
+    const Camera cam = MakeCamera();
+    Renderer renderer(2, 8);
+    AdaptiveSettings settings;
+    settings.min_samples = 8;
+    settings.max_samples = 256;
+    settings.max_error = 0.01;
+
+    Accumulator adaptive(cam.pixel_width, cam.pixel_height);
+    const uint64_t taken = renderer.renderAdaptive(cam, Disk, adaptive, settings);
+    ASSERT_EQ(taken, adaptive.totalSamples());
+
+    Accumulator uniform(cam.pixel_width, cam.pixel_height);
+    for (uint32_t pass = 0; pass < settings.max_samples; ++pass) {
+        renderer.renderPass(cam, Disk, uniform);
+    }
+
+    // Flat pixels stop at the minimum, edge pixels run to the maximum, and the image matches the
+    // uniform render where it matters: the samples of edge pixels are the same ones.
+    bool found_edge = false;
+    for (int y = 0; y < cam.pixel_height; ++y) {
+        for (int x = 0; x < cam.pixel_width; ++x) {
+            const uint32_t n = adaptive.samples(x, y);
+            if (uniform.variance(x, y) == 0) {
+                ASSERT_EQ(n, settings.min_samples) << x << " " << y;
+                ASSERT_EQ(adaptive.mean(x, y).x, uniform.mean(x, y).x);
+            } else if (n == settings.max_samples) {
+                found_edge = true;
+                ASSERT_EQ(adaptive.mean(x, y).x, uniform.mean(x, y).x);
+            }
+        }
+    }
+    ASSERT_TRUE(found_edge);
+    ASSERT_LT(taken * 4, uniform.totalSamples());
+
+    // Converged buffers take no more samples, and the result does not depend on threads.
+    ASSERT_EQ(renderer.renderAdaptive(cam, Disk, adaptive, settings), 0u);
+    Accumulator serial(cam.pixel_width, cam.pixel_height);
+    Renderer(1, 5).renderAdaptive(cam, Disk, serial, settings);
+    ExpectSameBuffer(serial, adaptive);
+
+    settings.min_samples = 1;
+    ASSERT_THROW(renderer.renderAdaptive(cam, Disk, serial, settings), std::invalid_argument);
+}
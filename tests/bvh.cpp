@@ -0,0 +1,282 @@
+#include "Prism/bvh.hpp"
+#include "Prism/aabb.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/thread_pool.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Prism;
+using std::vector;
+
+namespace {
+
+class InfinitePlane : public Object {
+  public:
+    bool hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const override {
+        // Plane y = -10 facing up.
+        if (ray.direction.y == 0) {
+            return false;
+        }
+        ld t = (-10 - ray.origin.y) / ray.direction.y;
+        if (t <= t_min || t >= t_max) {
+            return false;
+        }
+        rec.t = t;
+        rec.p = ray.origin + ray.direction * t;
+        rec.material = nullptr;
+        rec.set_face_normal(ray, Vector3(0, 1, 0));
+        return true;
+    }
+};
+
+vector<std::unique_ptr<TestSphere>> RandomSpheres(size_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> pos(-50.0, 50.0);
+    std::uniform_real_distribution<double> rad(0.2, 2.0);
+
+    vector<std::unique_ptr<TestSphere>> spheres;
+    for (size_t i = 0; i < count; ++i) {
+        spheres.push_back(
+            std::make_unique<TestSphere>(Point3(pos(gen), pos(gen), pos(gen)), rad(gen)));
+    }
+    return spheres;
+}
+
+vector<Object*> Pointers(const vector<std::unique_ptr<TestSphere>>& spheres) {
+    vector<Object*> objects;
+    for (const auto& sphere : spheres) {
+        objects.push_back(sphere.get());
+    }
+    return objects;
+}
+
+vector<AABB> Bounds(const vector<std::unique_ptr<TestSphere>>& spheres) {
+    vector<AABB> bounds;
+    for (const auto& sphere : spheres) {
+        AABB box;
+        sphere->boundingBox(box);
+        bounds.push_back(box);
+    }
+    return bounds;
+}
+
+// Checks the depth-first layout: first child right after its parent, second child further on,
+// children inside their parent, and every primitive in exactly one leaf.
+void ExpectValidTree(const BVHTree& tree, size_t primitive_count, size_t max_leaf_size) {
+    const auto& nodes = tree.nodes();
+    vector<int> seen(primitive_count, 0);
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        const BVHNode& node = nodes[n];
+        if (node.isLeaf()) {
+            ASSERT_LE(node.count, max_leaf_size);
+            for (uint32_t i = 0; i < node.count; ++i) {
+                seen[tree.primitiveOrder()[node.offset + i]]++;
+            }
+            continue;
+        }
+        ASSERT_GT(node.offset, n + 1);
+        ASSERT_LT(node.offset, nodes.size());
+        for (const BVHNode* child : {&nodes[n + 1], &nodes[node.offset]}) {
+            AABB both = node.bounds;
+            both.expand(child->bounds);
+            ASSERT_EQ(both.surfaceArea(), node.bounds.surfaceArea()) << n;
+        }
+    }
+    for (int count : seen) {
+        ASSERT_EQ(count, 1);
+    }
+}
+
+bool LinearHit(const vector<Object*>& objects, const Ray& ray, ld t_min, ld t_max,
+               HitRecord& rec) {
+    bool hit_anything = false;
+    HitRecord temp;
+    for (const Object* object : objects) {
+        if (object->hit(ray, t_min, t_max, temp)) {
+            hit_anything = true;
+            t_max = temp.t;
+            rec = temp;
+        }
+    }
+    return hit_anything;
+}
+
+} // namespace
+
+TEST(AABBTest, ExpandAndSurfaceArea) {
+    AABB box;
+    ASSERT_TRUE(box.empty());
+    ASSERT_EQ(box.surfaceArea(), 0);
+
+    box.expand(Point3(0, 0, 0));
+    box.expand(Point3(1, 2, 3));
+
+    ASSERT_FALSE(box.empty());
+    AssertPointAlmostEqual(box.centroid(), Point3(0.5, 1, 1.5));
+    ASSERT_NEAR(box.surfaceArea(), 2 * (1 * 2 + 2 * 3 + 3 * 1), kEpsilon);
+    ASSERT_EQ(box.longestAxis(), 2);
+}
+
+TEST(AABBTest, SlabTest) {
+    AABB box(Point3(-1, -1, -1), Point3(1, 1, 1));
+
+    Vector3 towards(0, 0, 1);
+    Vector3 inv_towards(1 / towards.x, 1 / towards.y, 1 / towards.z);
+    ASSERT_TRUE(box.hit(Point3(0, 0, -5), inv_towards, 0, 100));
+    ASSERT_FALSE(box.hit(Point3(0, 0, -5), inv_towards, 0, 3)); // box starts at t = 4
+    ASSERT_FALSE(box.hit(Point3(2, 0, -5), inv_towards, 0, 100));
+
+    Vector3 away(0, 0, -1);
+    Vector3 inv_away(1 / away.x, 1 / away.y, 1 / away.z);
+    ASSERT_FALSE(box.hit(Point3(0, 0, -5), inv_away, 0, 100));
+}
+
+TEST(BVHTest, EveryPrimitiveInExactlyOneLeaf) {
+    auto spheres = RandomSpheres(500, 7);
+    vector<AABB> bounds;
+    for (const auto& sphere : spheres) {
+        AABB box;
+        sphere->boundingBox(box);
+        bounds.push_back(box);
+    }
+
+    BVHTree tree(bounds, 4);
+    const auto& nodes = tree.nodes();
+    ASSERT_FALSE(nodes.empty());
+
+    vector<int> seen(bounds.size(), 0);
+    for (const auto& node : nodes) {
+        if (node.isLeaf()) {
+            ASSERT_LE(node.count, 4);
+            for (uint32_t i = 0; i < node.count; ++i) {
+                seen[tree.primitiveOrder()[node.offset + i]]++;
+            }
+        } else {
+            ASSERT_LT(node.offset, nodes.size());
+        }
+    }
+    for (int count : seen) {
+        ASSERT_EQ(count, 1);
+    }
+    ASSERT_GE(tree.sahCost(), 1);
+}
+
+TEST(BVHTest, MatchesLinearScan) {
+    auto spheres = RandomSpheres(300, 42);
+    vector<Object*> objects = Pointers(spheres);
+    BVH bvh(objects);
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> coord(-60.0, 60.0);
+
+    int hits = 0;
+    for (int i = 0; i < 2000; ++i) {
+        Point3 origin(coord(gen), coord(gen), coord(gen));
+        Point3 target(coord(gen), coord(gen), coord(gen));
+        if (origin == target) {
+            continue;
+        }
+        Ray ray(origin, target);
+
+        HitRecord expected, actual;
+        bool expected_hit = LinearHit(objects, ray, 0.001L, 1000.0L, expected);
+        bool actual_hit = bvh.hit(ray, 0.001L, 1000.0L, actual);
+
+        ASSERT_EQ(expected_hit, actual_hit);
+        if (expected_hit) {
+            hits++;
+            ASSERT_NEAR(expected.t, actual.t, kEpsilon);
+            AssertPointAlmostEqual(expected.p, actual.p);
+        }
+    }
+    ASSERT_GT(hits, 0);
+}
+
+TEST(BVHTest, BinnedBuildIsDeterministicAndCloseToSweep) {
+    // Large enough for the parallel binning and subtree tasks to kick in.
+    const vector<AABB> bounds = Bounds(RandomSpheres(20000, 11));
+    BVHBuildOptions options;
+    options.method = BVHBuildMethod::Binned;
+    const BVHTree serial(bounds, options);
+    ExpectValidTree(serial, bounds.size(), options.max_leaf_size);
+
+    ThreadPool pool(4);
+    options.pool = &pool;
+    const BVHTree parallel(bounds, options);
+    ASSERT_EQ(parallel.primitiveOrder(), serial.primitiveOrder());
+    ASSERT_EQ(parallel.nodes().size(), serial.nodes().size());
+    for (size_t n = 0; n < serial.nodes().size(); ++n) {
+        const BVHNode& a = serial.nodes()[n];
+        const BVHNode& b = parallel.nodes()[n];
+        ASSERT_EQ(a.offset, b.offset) << n;
+        ASSERT_EQ(a.count, b.count) << n;
+        ASSERT_EQ(a.axis, b.axis) << n;
+        ASSERT_EQ(a.bounds.min, b.bounds.min) << n;
+        ASSERT_EQ(a.bounds.max, b.bounds.max) << n;
+    }
+
+    const BVHTree sweep(bounds, 4);
+    ASSERT_LT(serial.sahCost(), sweep.sahCost() * 1.1);
+    ASSERT_GT(serial.buildSeconds(), 0);
+}
+
+TEST(BVHTest, BinnedMatchesLinearScan) {
+    auto spheres = RandomSpheres(300, 42);
+    vector<Object*> objects = Pointers(spheres);
+    BVHBuildOptions options;
+    options.method = BVHBuildMethod::Binned;
+    options.bin_count = 4;
+    BVH bvh(objects, options);
+    ExpectValidTree(bvh.tree(), objects.size(), options.max_leaf_size);
+
+    std::mt19937 gen(99);
+    std::uniform_real_distribution<double> coord(-60.0, 60.0);
+    for (int i = 0; i < 1000; ++i) {
+        Ray ray(Point3(coord(gen), coord(gen), coord(gen)),
+                Vector3(coord(gen), coord(gen), coord(gen)));
+        HitRecord expected, actual;
+        const bool expected_hit = LinearHit(objects, ray, 0.001L, 1000.0L, expected);
+        ASSERT_EQ(bvh.hit(ray, 0.001L, 1000.0L, actual), expected_hit);
+        if (expected_hit) {
+            ASSERT_NEAR(expected.t, actual.t, kEpsilon);
+        }
+    }
+
+    // Identical boxes cannot be binned apart and are split at the median instead.
+    const BVHTree stacked(vector<AABB>(50, AABB(Point3(0, 0, 0), Point3(1, 1, 1))), options);
+    ExpectValidTree(stacked, 50, options.max_leaf_size);
+}
+
+TEST(BVHTest, UnboundedObjectsAreStillTested) {
+    auto spheres = RandomSpheres(20, 3);
+    vector<Object*> objects = Pointers(spheres);
+    InfinitePlane plane;
+    objects.push_back(&plane);
+
+    BVH bvh(objects);
+    AABB box;
+    ASSERT_FALSE(bvh.boundingBox(box));
+
+    Ray ray(Point3(1000, 0, 1000), Vector3(0, -1, 0));
+    HitRecord rec;
+    ASSERT_TRUE(bvh.hit(ray, 0.001L, 1000.0L, rec));
+    ASSERT_NEAR(rec.t, 10.0L, kEpsilon);
+}
+
+TEST(BVHTest, EmptyAndInvalid) {
+    BVH bvh(vector<Object*>{});
+    Ray ray(Point3(0, 0, 0), Vector3(0, 0, 1));
+    HitRecord rec;
+    ASSERT_FALSE(bvh.hit(ray, 0.001L, 1000.0L, rec));
+
+    ASSERT_THROW(BVHTree(vector<AABB>{AABB()}, 0), std::invalid_argument);
+    BVHBuildOptions options;
+    options.bin_count = 1;
+    ASSERT_THROW(BVHTree(vector<AABB>{AABB()}, options), std::invalid_argument);
+}
@@ -4,8 +4,16 @@
 #include "Prism/vector.hpp"
 #include "TestHelpers.hpp"
 #include "Prism/ray.hpp"
+#include "Prism/thread_pool.hpp"
 #include "Prism/utils.hpp"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 using Prism::Camera;
@@ -13,7 +21,8 @@ using Prism::Matrix;
 using Prism::Point3;
 using Prism::Vector3;
 using Prism::Ray;
-using ld = long double;
+using Prism::kEpsilon;
+using Prism::ld;
 
 TEST(CameraTest, Instantiation) {
     // Arrange: create Point3 and Vector3 for constructor parameters
@@ -79,14 +88,14 @@ TEST(CameraTest, CoordinateBasisOrthonormal) {
     AssertVectorAlmostEqual(b1, dir);
 
     // Assert unit length
-    ASSERT_NEAR(b1.magnitude(), 1.0L, 1e-9);
-    ASSERT_NEAR(b2.magnitude(), 1.0L, 1e-9);
-    ASSERT_NEAR(b3.magnitude(), 1.0L, 1e-9);
+    ASSERT_NEAR(b1.magnitude(), 1.0L, kEpsilon);
+    ASSERT_NEAR(b2.magnitude(), 1.0L, kEpsilon);
+    ASSERT_NEAR(b3.magnitude(), 1.0L, kEpsilon);
 
     // Assert orthogonality
-    ASSERT_NEAR(b1.dot(b2), 0.0L, 1e-9);
-    ASSERT_NEAR(b1.dot(b3), 0.0L, 1e-9);
-    ASSERT_NEAR(b2.dot(b3), 0.0L, 1e-9);
+    ASSERT_NEAR(b1.dot(b2), 0.0L, kEpsilon);
+    ASSERT_NEAR(b1.dot(b3), 0.0L, kEpsilon);
+    ASSERT_NEAR(b2.dot(b3), 0.0L, kEpsilon);
 }
 
 TEST(CameraTest,
@@ -167,8 +176,8 @@ TEST(CameraTest, IteratorGeneratesGeometricallyCorrectRays) {
         -distance_to_screen);
 
     auto get_intersection_point = [&](const Prism::Ray& ray) {
-        ld t = (-distance_to_screen - ray.origin->z) / ray.direction->z;
-        return *ray.origin + (*ray.direction * t);
+        ld t = (-distance_to_screen - ray.origin.z) / ray.direction.z;
+        return ray.origin + (ray.direction * t);
     };
 
     Prism::Ray& top_left_ray = generated_rays.front();
@@ -220,8 +229,8 @@ TEST(CameraTest, IteratorGeneratesCorrectRayForAllPixels) {
         top_left_corner + (expected_delta_u * 0.5) - (expected_delta_v * 0.5);
 
     auto get_intersection_point = [&](const Prism::Ray& ray) {
-        ld t = (target - *ray.origin).dot(w_vec) / (ray.direction->dot(w_vec));
-        return *ray.origin + (*ray.direction * t);
+        ld t = (target - ray.origin).dot(w_vec) / (ray.direction.dot(w_vec));
+        return ray.origin + (ray.direction * t);
     };
 
     int ray_index = 0;
@@ -239,4 +248,147 @@ TEST(CameraTest, IteratorGeneratesCorrectRayForAllPixels) {
             ray_index++;
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(CameraTest, PixelRangeIsRandomAccess) {
+    static_assert(std::is_same<std::iterator_traits<Prism::PixelIterator>::iterator_category,
+                               std::random_access_iterator_tag>::value,
+                  "pixel ranges must be random access");
+    const Prism::Camera cam(Prism::Point3(1, 2, 3), Prism::Point3(0, 0, 0), Prism::Vector3(0, 1, 0),
+                            1.0, 2.0, 3.0, 17, 23);
+    const Prism::PixelRange range = cam.pixels();
+    ASSERT_EQ(range.size(), 17u * 23u);
+    ASSERT_EQ(range.end() - range.begin(), static_cast<std::ptrdiff_t>(range.size()));
+
+    for (size_t i = 0; i < range.size(); i += 7) {
+        const Prism::Pixel p = range.pixel(i);
+        const Prism::Ray expected = cam.getRay(p.x, p.y);
+        const Prism::Ray actual = range[i];
+        AssertPointAlmostEqual(actual.origin, expected.origin);
+        AssertVectorAlmostEqual(actual.direction, expected.direction);
+        AssertVectorAlmostEqual((*(range.begin() + i)).direction, expected.direction);
+        AssertVectorAlmostEqual(range.begin()[i].direction, expected.direction);
+    }
+    Prism::PixelIterator it = range.end();
+    it -= 3;
+    ASSERT_EQ(it.pixel().x, 20);
+    ASSERT_EQ(it.pixel().y, 16);
+    ASSERT_TRUE(range.begin() < it);
+
+    // The range keeps its own copy of the geometry.
+    auto temporary = std::make_unique<Prism::Camera>(
+        Prism::Point3(1, 2, 3), Prism::Point3(0, 0, 0), Prism::Vector3(0, 1, 0), 1.0, 2.0, 3.0, 17,
+        23);
+    const Prism::PixelRange detached = temporary->pixels();
+    temporary.reset();
+    AssertVectorAlmostEqual(detached[100].direction, range[100].direction);
+
+    // Algorithms that need random access work on the iterators directly.
+    std::vector<Prism::Ray> rays(range.size());
+    std::copy(range.begin(), range.end(), rays.begin());
+    AssertVectorAlmostEqual(rays[45].direction, range[45].direction);
+}
+
+TEST(CameraTest, PixelRangeSplitsIntoDisjointParts) {
+    const Prism::Camera cam(Prism::Point3(0, 0, 0), Prism::Point3(0, 0, -1),
+                            Prism::Vector3(0, 1, 0), 1.0, 2.0, 2.0, 37, 29);
+    const Prism::PixelRange range = cam.pixels();
+
+    // Recursive splitting down to small parts, run on the pool, covers every pixel once.
+    std::vector<Prism::PixelRange> parts{range};
+    for (size_t i = 0; i < parts.size();) {
+        if (parts[i].size() > 16) {
+            const auto halves = parts[i].split();
+            ASSERT_EQ(halves.first.size() + halves.second.size(), parts[i].size());
+            parts[i] = halves.first;
+            parts.push_back(halves.second);
+        } else {
+            ++i;
+        }
+    }
+    std::vector<std::atomic<int>> visits(range.size());
+    Prism::ThreadPool pool(4);
+    pool.parallelFor(parts.size(), [&](size_t i) {
+        for (auto it = parts[i].begin(); it != parts[i].end(); ++it) {
+            const Prism::Pixel p = it.pixel();
+            ++visits[static_cast<size_t>(p.y) * cam.pixel_width + p.x];
+        }
+    });
+    for (const std::atomic<int>& count : visits) {
+        ASSERT_EQ(count.load(), 1);
+    }
+
+    const Prism::PixelRange tile = range.tile(8, 4, 5, 3);
+    ASSERT_EQ(tile.size(), 15u);
+    ASSERT_EQ(tile.pixel(14).x, 12);
+    ASSERT_EQ(tile.pixel(14).y, 6);
+    AssertVectorAlmostEqual(tile[6].direction, cam.getRay(9, 5).direction);
+    ASSERT_EQ(tile.rows(5, 2).size(), 10u);
+    ASSERT_TRUE(range.tile(3, 3, 0, 5).empty());
+    ASSERT_THROW(range.tile(30, 0, 8, 1), std::out_of_range);
+    ASSERT_THROW(tile.rows(3, 2), std::out_of_range);
+    ASSERT_THROW(range.tile(0, 0, -1, 1), std::out_of_range);
+}
+
+namespace {
+
+void ExpectSameRays(const Prism::Camera& expected, const Prism::Camera& actual) {
+    ASSERT_EQ(actual.pixel_width, expected.pixel_width);
+    ASSERT_EQ(actual.pixel_height, expected.pixel_height);
+    for (int y = 0; y < expected.pixel_height; y += 3) {
+        for (int x = 0; x < expected.pixel_width; x += 3) {
+            const Prism::Ray a = expected.getRay(x, y), b = actual.getRay(x, y);
+            AssertPointAlmostEqual(b.origin, a.origin);
+            AssertVectorAlmostEqual(b.direction, a.direction);
+        }
+    }
+}
+
+} // namespace
+
+TEST(CameraTest, SettersMatchRebuiltCamera) {
+    const Prism::Vector3 up(0, 1, 0);
+    Prism::Camera cam(Prism::Point3(0, 0, 0), Prism::Point3(0, 0, -1), up, 1.0, 2.0, 3.0, 20, 30);
+
+    cam.setPosition(Prism::Point3(1, 2, 3));
+    ExpectSameRays(Prism::Camera(Prism::Point3(1, 2, 3), Prism::Point3(0, 0, -1), up, 1.0, 2.0,
+                                 3.0, 20, 30),
+                   cam);
+    cam.setTarget(Prism::Point3(4, -1, 0));
+    ExpectSameRays(Prism::Camera(Prism::Point3(1, 2, 3), Prism::Point3(4, -1, 0), up, 1.0, 2.0,
+                                 3.0, 20, 30),
+                   cam);
+    cam.lookAt(Prism::Point3(-2, 0, 5), Prism::Point3(0, 1, 0));
+    ExpectSameRays(Prism::Camera(Prism::Point3(-2, 0, 5), Prism::Point3(0, 1, 0), up, 1.0, 2.0,
+                                 3.0, 20, 30),
+                   cam);
+
+    cam.setResolution(16, 40);
+    const Prism::Camera resized(Prism::Point3(-2, 0, 5), Prism::Point3(0, 1, 0), up, 1.0, 2.0,
+                                3.0, 16, 40);
+    ExpectSameRays(resized, cam);
+    ASSERT_EQ(cam.pixels().size(), 16u * 40u);
+
+    // A 90 degree field of view puts the top of the screen as far up as the screen is away.
+    cam.setFieldOfView(std::acos(ld(-1)) / 2);
+    ASSERT_NEAR(cam.screen_height, 2, kEpsilon);
+    ASSERT_NEAR(cam.screen_width, 3, kEpsilon);
+    ASSERT_NEAR(cam.fieldOfView(), std::acos(ld(-1)) / 2, kEpsilon);
+    cam.setViewport(1.0, 4.0);
+    ExpectSameRays(Prism::Camera(Prism::Point3(-2, 0, 5), Prism::Point3(0, 1, 0), up, 1.0, 1.0,
+                                 4.0, 16, 40),
+                   cam);
+
+    // Copies own their state.
+    Prism::Camera copy(cam);
+    copy.setPosition(Prism::Point3(9, 9, 9));
+    cam = copy;
+    copy.setResolution(2, 2);
+    ASSERT_EQ(cam.pixel_width, 40);
+    AssertPointAlmostEqual(*cam.pos, Prism::Point3(9, 9, 9));
+
+    ASSERT_THROW(cam.setResolution(0, 10), std::invalid_argument);
+    ASSERT_THROW(cam.setFieldOfView(0), std::invalid_argument);
+    ASSERT_THROW(cam.setFieldOfView(4), std::invalid_argument);
+    ASSERT_THROW(cam.setViewport(1, -1), std::invalid_argument);
+}
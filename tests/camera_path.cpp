@@ -0,0 +1,129 @@
+#include "Prism/camera_path.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/image.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/renderer.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace Prism;
+
+namespace {
+
+CameraKey Key(ld time, const Point3& position, const Point3& target, ld fov = 0) {
+    CameraKey key;
+    key.time = time;
+    key.position = position;
+    key.target = target;
+    key.fov = fov;
+    return key;
+}
+
+} // namespace
+
+TEST(CameraPathTest, PassesThroughKeys) {
+    CameraPath path;
+    path.addKey(Key(0, Point3(0, 0, 5), Point3(0, 0, 0), 1.0));
+    path.addKey(Key(1, Point3(5, 1, 0), Point3(0, 1, 0), 0.5));
+    path.addKey(Key(3, Point3(0, 2, -5), Point3(1, 0, 0), 0.5));
+    path.addKey(Key(4, Point3(-5, 0, 0), Point3(0, 0, 0)));
+    ASSERT_EQ(path.startTime(), 0);
+    ASSERT_EQ(path.endTime(), 4);
+
+    for (const CameraKey& key : path.keys()) {
+        const CameraKey at = path.at(key.time);
+        AssertPointAlmostEqual(at.position, key.position);
+        AssertPointAlmostEqual(at.target, key.target);
+    }
+    AssertPointAlmostEqual(path.at(-1).position, Point3(0, 0, 5));
+    AssertPointAlmostEqual(path.at(10).position, Point3(-5, 0, 0));
+    ASSERT_NEAR(path.at(0.5).fov, 0.75, kEpsilon);
+    ASSERT_EQ(path.at(3.5).fov, 0);
+
+    // The spline is continuous across keys.
+    const ld h = 1e-3;
+    for (ld t : {ld(1), ld(3)}) {
+        ASSERT_LT((path.at(t + h).position - path.at(t - h).position).magnitude(), 0.05);
+    }
+
+    ASSERT_EQ(path.frameTime(0, 5), 0);
+    ASSERT_EQ(path.frameTime(4, 5), 4);
+    ASSERT_EQ(path.frameTime(2, 5), 2);
+}
+
+TEST(CameraPathTest, TurntableCirclesTarget) {
+    const Point3 target(1, 0, -2);
+    const CameraPath path = CameraPath::turntable(target, Point3(1, 1, 2), 8, 16);
+    ASSERT_EQ(path.keys().size(), 17u);
+    ASSERT_TRUE(path.closed());
+
+    ld worst = 0;
+    for (int i = 0; i <= 400; ++i) {
+        const CameraKey key = path.at(ld(0.02) * i);
+        const Vector3 arm = key.position - target;
+        worst = std::max(worst, std::abs(std::sqrt(arm.x * arm.x + arm.z * arm.z) - 4) / 4);
+        ASSERT_NEAR(arm.y, 1, kEpsilon);
+        AssertPointAlmostEqual(key.target, target);
+    }
+    ASSERT_LT(worst, 1e-3);
+    AssertPointAlmostEqual(path.at(2).position, Point3(5, 1, -2), 1e-4);
+    AssertPointAlmostEqual(path.at(8).position, Point3(1, 1, 2), 1e-4);
+
+    // Frames of a closed path loop without repeating the first view at the end.
+    ASSERT_EQ(path.frameTime(0, 16), 0);
+    ASSERT_EQ(path.frameTime(8, 16), 4);
+    ASSERT_EQ(path.frameTime(15, 16), 7.5);
+    ASSERT_EQ(path.frameTime(0, 1), 0);
+    const Vector3 seam =
+        path.at(path.frameTime(15, 16)).position - path.at(path.frameTime(0, 16)).position;
+    ASSERT_GT(seam.magnitude(), 1);
+}
+
+TEST(CameraPathTest, RejectsInvalidKeys) {
+    CameraPath path;
+    ASSERT_THROW(path.at(0), std::logic_error);
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 4, 4);
+    ASSERT_THROW(path.apply(0, cam), std::logic_error);
+
+    path.addKey(Key(1, Point3(0, 0, 1), Point3(0, 0, 0)));
+    ASSERT_THROW(path.addKey(Key(1, Point3(0, 0, 2), Point3(0, 0, 0))), std::invalid_argument);
+    ASSERT_THROW(path.addKey(Key(2, Point3(0, 0, 2), Point3(0, 0, 0), -1)),
+                 std::invalid_argument);
+    ASSERT_THROW(CameraPath::turntable(Point3(0, 0, 0), Point3(1, 0, 0), 0), std::invalid_argument);
+    ASSERT_THROW(CameraPath::turntable(Point3(0, 0, 0), Point3(1, 0, 0), 1, 3),
+                 std::invalid_argument);
+}
+
+TEST(CameraPathTest, RenderFramesMatchesRebuiltCameras) {
+    CameraPath path;
+    path.addKey(Key(0, Point3(0, 0, 4), Point3(0, 0, 0), 0.8));
+    path.addKey(Key(1, Point3(3, 1, 3), Point3(0, 0.5, 0), 1.2));
+    path.addKey(Key(2, Point3(4, 0, 0), Point3(0, 0, 0), 0.8));
+
+    Camera cam(Point3(0, 0, 1), Point3(0, 0, 0), Vector3(0, 1, 0), 1.0, 2.0, 3.0, 10, 15);
+    Renderer renderer(2, 4);
+    const Renderer::Shader shade = [](const Ray& ray) { return ray.direction; };
+
+    std::vector<int> frames;
+    renderer.renderFrames(cam, path, 5, shade, [&](int frame, const Image& image) {
+        frames.push_back(frame);
+        const CameraKey key = path.at(path.frameTime(frame, 5));
+        const ld height = 2 * std::tan(key.fov / 2);
+        const Camera rebuilt(key.position, key.target, Vector3(0, 1, 0), 1.0, height,
+                             height * 1.5, 10, 15);
+        const Image expected = renderer.render(rebuilt, shade);
+        for (size_t i = 0; i < image.pixels().size(); ++i) {
+            AssertVectorAlmostEqual(image.pixels()[i], expected.pixels()[i], 1e-4);
+        }
+    });
+    ASSERT_EQ(frames, (std::vector<int>{0, 1, 2, 3, 4}));
+    AssertPointAlmostEqual(*cam.pos, Point3(4, 0, 0));
+    ASSERT_THROW(renderer.renderFrames(cam, path, 0, shade, [](int, const Image&) {}),
+                 std::invalid_argument);
+}
@@ -0,0 +1,225 @@
+#include "Prism/image_writer.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/image.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/renderer.hpp"
+#include "Prism/vector.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Prism;
+
+namespace {
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), {});
+}
+
+uint32_t bigEndian(const uint8_t* p) {
+    return uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | p[3];
+}
+
+uint32_t crc32(const uint8_t* data, size_t size) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; ++k) {
+            crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+// Decodes the RGB bytes of a PNG made of stored deflate blocks, checking every checksum.
+std::vector<uint8_t> decodeStoredPng(const std::vector<uint8_t>& file, int& width, int& height) {
+    const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    EXPECT_TRUE(std::equal(signature, signature + 8, file.begin()));
+    std::vector<uint8_t> zlib;
+    size_t at = 8;
+    std::string last;
+    while (at + 12 <= file.size()) {
+        const uint32_t length = bigEndian(&file[at]);
+        const std::string type(file.begin() + at + 4, file.begin() + at + 8);
+        EXPECT_EQ(bigEndian(&file[at + 8 + length]), crc32(&file[at + 4], length + 4)) << type;
+        const uint8_t* data = &file[at + 8];
+        if (type == "IHDR") {
+            width = static_cast<int>(bigEndian(data));
+            height = static_cast<int>(bigEndian(data + 4));
+        } else if (type == "IDAT") {
+            zlib.insert(zlib.end(), data, data + length);
+        }
+        last = type;
+        at += 12 + length;
+    }
+    EXPECT_EQ(last, "IEND");
+    EXPECT_EQ(at, file.size());
+
+    std::vector<uint8_t> raw;
+    size_t p = 2;
+    bool final_block = false;
+    while (!final_block) {
+        final_block = zlib[p] & 1;
+        EXPECT_EQ(zlib[p] & 6, 0);
+        const uint16_t length = uint16_t(zlib[p + 1] | zlib[p + 2] << 8);
+        const uint16_t inverse = uint16_t(zlib[p + 3] | zlib[p + 4] << 8);
+        EXPECT_EQ(uint16_t(~length), inverse);
+        raw.insert(raw.end(), zlib.begin() + p + 5, zlib.begin() + p + 5 + length);
+        p += 5 + length;
+    }
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    EXPECT_EQ(bigEndian(&zlib[p]), b << 16 | a);
+
+    std::vector<uint8_t> rgb;
+    const size_t stride = static_cast<size_t>(width) * 3 + 1;
+    EXPECT_EQ(raw.size(), stride * height);
+    for (int y = 0; y < height; ++y) {
+        EXPECT_EQ(raw[y * stride], 0);
+        rgb.insert(rgb.end(), raw.begin() + y * stride + 1, raw.begin() + (y + 1) * stride);
+    }
+    return rgb;
+}
+
+Vector3 Gradient(int x, int y) {
+    return Vector3(x / 63.0, y / 31.0, (x + y) % 2 ? 1.5 : -0.5);
+}
+
+std::vector<uint8_t> Quantized(int width, int height) {
+    std::vector<uint8_t> rgb;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const Vector3 c = Gradient(x, y);
+            for (ld v : {c.x, c.y, c.z}) {
+                rgb.push_back(static_cast<uint8_t>((v < 0 ? 0 : v > 1 ? 1 : v) * 255 + 0.5));
+            }
+        }
+    }
+    return rgb;
+}
+
+void WriteGradientTile(ImageWriter& writer, const Tile& tile) {
+    std::vector<Vector3> pixels;
+    for (int y = tile.y0; y < tile.y1; ++y) {
+        for (int x = tile.x0; x < tile.x1; ++x) {
+            pixels.push_back(Gradient(x, y));
+        }
+    }
+    writer.writeTile(tile, pixels.data());
+}
+
+} // namespace
+
+TEST(ImageWriterTest, StreamsPpmTilesInAnyOrder) {
+    const std::string path = testing::TempDir() + "prism_image_writer_test.ppm";
+    {
+        ImageWriter writer(path, 64, 32, 8);
+        ASSERT_EQ(writer.format(), ImageFormat::PPM);
+        // Each band of 8 rows is written right to left, bottom to top.
+        for (int band = 0; band < 32; band += 8) {
+            for (int y = band + 4; y >= band; y -= 4) {
+                for (int x = 48; x >= 0; x -= 16) {
+                    WriteGradientTile(writer, Tile{x, y, x + 16, y + 4});
+                }
+            }
+            ASSERT_EQ(writer.rowsWritten(), band + 8);
+        }
+        writer.finish();
+    }
+
+    const std::vector<uint8_t> file = readFile(path);
+    const std::string header = "P6\n64 32\n255\n";
+    ASSERT_EQ(std::string(file.begin(), file.begin() + header.size()), header);
+    ASSERT_EQ(std::vector<uint8_t>(file.begin() + header.size(), file.end()), Quantized(64, 32));
+    std::remove(path.c_str());
+}
+
+TEST(ImageWriterTest, WritesValidPng) {
+    // Rows wider than a stored deflate block are split over several blocks.
+    const std::string path = testing::TempDir() + "prism_image_writer_test.PNG";
+    Image image(23000, 3);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            image.pixel(x, y) = Vector3((x % 256) / 255.0, y / 2.0, 1);
+        }
+    }
+    writeImage(path, image);
+
+    int width = 0, height = 0;
+    const std::vector<uint8_t> rgb = decodeStoredPng(readFile(path), width, height);
+    ASSERT_EQ(width, 23000);
+    ASSERT_EQ(height, 3);
+    ASSERT_EQ(rgb.size(), size_t(23000) * 3 * 3);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; x += 997) {
+            const uint8_t* p = &rgb[(size_t(y) * width + x) * 3];
+            ASSERT_EQ(p[0], x % 256);
+            ASSERT_EQ(p[1], y == 0 ? 0 : y == 1 ? 128 : 255);
+            ASSERT_EQ(p[2], 255);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(ImageWriterTest, RendererStreamsSameImage) {
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 37, 45);
+    const Renderer::Shader shade = [](const Ray& ray) {
+        return (ray.direction + Vector3(1, 1, 1)) * 0.5;
+    };
+    Renderer renderer(3, 8);
+    const Image image = renderer.render(cam, shade);
+
+    const std::string path = testing::TempDir() + "prism_image_writer_render.png";
+    ImageWriter writer(path, 45, 37, 16);
+    renderer.render(cam, shade, writer);
+    ASSERT_EQ(writer.rowsWritten(), 37);
+
+    int width = 0, height = 0;
+    const std::vector<uint8_t> rgb = decodeStoredPng(readFile(path), width, height);
+    ASSERT_EQ(width, 45);
+    ASSERT_EQ(height, 37);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const Vector3& c = image.pixel(x, y);
+            const uint8_t* p = &rgb[(size_t(y) * width + x) * 3];
+            ASSERT_EQ(p[0], static_cast<uint8_t>(c.x * 255 + 0.5));
+            ASSERT_EQ(p[1], static_cast<uint8_t>(c.y * 255 + 0.5));
+            ASSERT_EQ(p[2], static_cast<uint8_t>(c.z * 255 + 0.5));
+        }
+    }
+
+    ImageWriter narrow(path, 45, 37, 4);
+    ASSERT_THROW(renderer.render(cam, shade, narrow), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+TEST(ImageWriterTest, RejectsInvalidUse) {
+    const std::string path = testing::TempDir() + "prism_image_writer_invalid.ppm";
+    ASSERT_THROW(ImageWriter(testing::TempDir() + "image.bmp", 4, 4), std::invalid_argument);
+    ASSERT_THROW(ImageWriter(path, 0, 4), std::invalid_argument);
+    ASSERT_THROW(ImageWriter(testing::TempDir() + "missing/dir/image.png", 4, 4),
+                 std::runtime_error);
+
+    ImageWriter writer(path, 8, 8, 2);
+    const std::vector<Vector3> pixels(64);
+    ASSERT_THROW(writer.writeTile(Tile{0, 0, 9, 1}, pixels.data()), std::out_of_range);
+    ASSERT_THROW(writer.writeTile(Tile{0, 1, 8, 3}, pixels.data()), std::out_of_range);
+    writer.writeTile(Tile{0, 1, 8, 2}, pixels.data());
+    ASSERT_THROW(writer.writeTile(Tile{4, 1, 8, 2}, pixels.data()), std::logic_error);
+    ASSERT_EQ(writer.rowsWritten(), 0);
+    writer.writeTile(Tile{0, 0, 8, 1}, pixels.data());
+    ASSERT_EQ(writer.rowsWritten(), 2);
+    ASSERT_THROW(writer.writeTile(Tile{0, 0, 8, 1}, pixels.data()), std::out_of_range);
+    ASSERT_THROW(writer.finish(), std::logic_error);
+    std::remove(path.c_str());
+}
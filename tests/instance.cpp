@@ -0,0 +1,173 @@
+#include "Prism/instance.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/fixed_matrix.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/ray_packet.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/triangle_mesh.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Prism;
+using std::vector;
+
+namespace {
+
+// Two triangles of a unit tetrahedron-like wedge around the origin, with distinct normals.
+MeshData Wedge() {
+    MeshData mesh;
+    mesh.positions = {-1, -1, 0, 1, -1, 0, 0, 1, 0, 0, 0, 1};
+    mesh.indices = {0, 1, 2, 0, 1, 3};
+    mesh.normal_indices.assign(6, MeshData::kNoIndex);
+    mesh.material_ids = {MeshData::kNoIndex, MeshData::kNoIndex};
+    return mesh;
+}
+
+// The same mesh with its vertices moved by the transform, as a flattened copy would be.
+MeshData Transformed(MeshData mesh, const Mat4& m) {
+    for (size_t i = 0; i < mesh.positions.size(); i += 3) {
+        const Point3 p = transformPoint(
+            m, Point3(mesh.positions[i], mesh.positions[i + 1], mesh.positions[i + 2]));
+        mesh.positions[i] = static_cast<float>(p.x);
+        mesh.positions[i + 1] = static_cast<float>(p.y);
+        mesh.positions[i + 2] = static_cast<float>(p.z);
+    }
+    return mesh;
+}
+
+void ExpectSameHit(const Object& expected, const Object& actual, const Ray& ray) {
+    HitRecord a, b;
+    const bool hit = expected.hit(ray, 0.001L, 1000.0L, a);
+    ASSERT_EQ(actual.hit(ray, 0.001L, 1000.0L, b), hit);
+    if (hit) {
+        const ld eps = 1e-4;
+        ASSERT_NEAR(a.t, b.t, eps);
+        AssertPointAlmostEqual(a.p, b.p, eps);
+        AssertVectorAlmostEqual(a.normal, b.normal, eps);
+        ASSERT_EQ(a.front_face, b.front_face);
+    }
+}
+
+} // namespace
+
+TEST(InstanceTest, MatchesTransformedCopy) {
+    const TriangleMesh mesh(Wedge());
+    const Mat4 transforms[] = {
+        Mat4::identity(),
+        translation(Vector3(3, -2, 5)),
+        translation(Vector3(1, 2, 3)) * rotation(Vector3(1, 1, 0), 0.7) * scaling(Vector3(2, 2, 2)),
+        rotation(Vector3(0, 0, 1), 1.2) * scaling(Vector3(0.5, 3, 1.5)),
+    };
+
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> coord(-6.0, 6.0);
+    for (const Mat4& m : transforms) {
+        const Instance instance(mesh, m);
+        const TriangleMesh copy(Transformed(Wedge(), m));
+
+        AABB expected, box;
+        ASSERT_TRUE(copy.boundingBox(expected));
+        ASSERT_TRUE(instance.boundingBox(box));
+        ASSERT_LE(box.min.x, expected.min.x + 1e-5);
+        ASSERT_GE(box.max.z, expected.max.z - 1e-5);
+
+        const Point3 center = transformPoint(m, Point3(0, 0, 0.3));
+        for (int i = 0; i < 200; ++i) {
+            const Point3 origin(coord(gen), coord(gen), coord(gen));
+            ExpectSameHit(copy, instance, Ray(origin, center));
+        }
+    }
+}
+
+TEST(InstanceTest, ScenesOfInstancesShareGeometry) {
+    const TriangleMesh mesh(Wedge());
+    vector<std::unique_ptr<Instance>> instances;
+    vector<std::unique_ptr<TriangleMesh>> copies;
+    vector<Object*> instanced, flattened;
+    for (int i = 0; i < 100; ++i) {
+        const Mat4 m = translation(Vector3(3 * (i % 10), 3 * (i / 10), -10)) *
+                       rotation(Vector3(0, 1, 1), 0.1 * i);
+        instances.push_back(std::make_unique<Instance>(mesh, m));
+        copies.push_back(std::make_unique<TriangleMesh>(Transformed(Wedge(), m)));
+        instanced.push_back(instances.back().get());
+        flattened.push_back(copies.back().get());
+    }
+    Scene scene(instanced);
+    const Scene reference(flattened);
+    ASSERT_EQ(&instances[42]->geometry(), &mesh);
+
+    std::mt19937 gen(8);
+    std::uniform_real_distribution<double> target(-1.0, 30.0);
+    int hits = 0;
+    for (int i = 0; i < 500; ++i) {
+        const Ray ray(Point3(13, 13, 10), Point3(target(gen), target(gen), -10));
+        HitRecord a, b;
+        const bool hit = reference.hit(ray, 0.001L, 1000.0L, a);
+        ASSERT_EQ(scene.hit(ray, 0.001L, 1000.0L, b), hit);
+        if (hit) {
+            ++hits;
+            ASSERT_NEAR(a.t, b.t, 1e-4);
+        }
+    }
+    ASSERT_GT(hits, 0);
+
+    // Moving an instance only needs the top level rebuilt.
+    const Ray probe(Point3(100, 100.5, 10), Vector3(0, 0, -1));
+    HitRecord rec;
+    ASSERT_FALSE(scene.hit(probe, 0.001L, 1000.0L, rec));
+    instances[7]->setTransform(translation(Vector3(100, 100, -10)));
+    scene.build();
+    ASSERT_TRUE(scene.hit(probe, 0.001L, 1000.0L, rec));
+    ASSERT_NEAR(rec.t, 20, 1e-4);
+}
+
+TEST(InstanceTest, PacketsMatchSingleRays) {
+    const TriangleMesh mesh(Wedge());
+    const Camera cam(Point3(0, 0, 6), Point3(0, 0, 0), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 16, 16);
+    const Mat4 transforms[] = {
+        rotation(Vector3(1, 0, 0), -0.4) * scaling(Vector3(2, 2, 2)), // Traced as a packet.
+        scaling(Vector3(2, 1, 1)),                                    // Traced lane by lane.
+    };
+    for (const Mat4& m : transforms) {
+        const Instance instance(mesh, m);
+        int hits = 0;
+        for (int y0 = 0; y0 < cam.pixel_height; y0 += RayPacket::kHeight) {
+            for (int x0 = 0; x0 < cam.pixel_width; x0 += RayPacket::kWidth) {
+                RayPacket packet;
+                cam.getPacket(x0, y0, packet);
+                PacketHit packet_hits;
+                packet_hits.reset(1000);
+                instance.hitPacket(packet, 0.001L, packet_hits);
+                for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+                    HitRecord rec;
+                    const bool hit = instance.hit(packet.ray(lane), 0.001L, 1000.0L, rec);
+                    ASSERT_EQ(packet_hits.hit[lane], hit);
+                    if (hit) {
+                        ++hits;
+                        ASSERT_NEAR(packet_hits.records[lane].t, rec.t, kEpsilon);
+                        AssertVectorAlmostEqual(packet_hits.records[lane].normal, rec.normal);
+                    }
+                }
+            }
+        }
+        ASSERT_GT(hits, 0);
+    }
+}
+
+TEST(InstanceTest, RejectsSingularAndProjectiveTransforms) {
+    const TriangleMesh mesh(Wedge());
+    ASSERT_THROW(Instance(mesh, scaling(Vector3(1, 0, 1))), std::invalid_argument);
+    Mat4 projective = Mat4::identity();
+    projective(3, 2) = 1;
+    ASSERT_THROW(Instance(mesh, projective), std::invalid_argument);
+
+    Instance instance(mesh);
+    ASSERT_THROW(instance.setTransform(Mat4()), std::invalid_argument);
+}
@@ -0,0 +1,154 @@
+#include "ObjReader/ObjReader.hpp"
+#include "Prism/mesh_cache.hpp"
+#include "Prism/obj_loader.hpp"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Prism::MeshCache;
+using Prism::MeshData;
+
+namespace {
+
+MeshData sampleMesh() {
+    MeshData mesh;
+    mesh.positions = {0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0};
+    mesh.normals = {0, 0, 1};
+    mesh.indices = {0, 1, 2, 0, 2, 3};
+    mesh.normal_indices = {0, 0, 0, MeshData::kNoIndex, MeshData::kNoIndex, MeshData::kNoIndex};
+    mesh.material_ids = {1, 0};
+    mesh.material_names = {"red", "blue"};
+    mesh.materials.resize(2, Prism::MeshMaterial{});
+    mesh.materials[1].kd[0] = 0.75f;
+    mesh.materials[1].ns = 32;
+    mesh.material_library = "scene.mtl";
+    return mesh;
+}
+
+void writeText(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+}
+
+} // namespace
+
+TEST(MeshCacheTest, RoundTripsThroughMappedFile) {
+    const std::string path = testing::TempDir() + "prism_mesh_cache_test.pmesh";
+    const MeshData mesh = sampleMesh();
+    Prism::writeMeshCache(path, mesh);
+
+    MeshCache cache(path);
+    ASSERT_EQ(cache.vertexCount(), 4);
+    ASSERT_EQ(cache.normalCount(), 1);
+    ASSERT_EQ(cache.triangleCount(), 2);
+    ASSERT_EQ(cache.positions()[7], 1.0f);
+    ASSERT_EQ(cache.indices()[5], 3);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(cache.positions().data()) % 16, 0);
+    ASSERT_EQ(cache.materials()[1].kd[0], 0.75f);
+    ASSERT_EQ(cache.materialNames(), mesh.material_names);
+    ASSERT_EQ(cache.materialLibrary(), "scene.mtl");
+    ASSERT_EQ(cache.source(), Prism::SourceFingerprint());
+
+    MeshData copy = cache.toMeshData();
+    ASSERT_EQ(copy.positions, mesh.positions);
+    ASSERT_EQ(copy.normals, mesh.normals);
+    ASSERT_EQ(copy.indices, mesh.indices);
+    ASSERT_EQ(copy.normal_indices, mesh.normal_indices);
+    ASSERT_EQ(copy.material_ids, mesh.material_ids);
+    ASSERT_EQ(copy.materials[1].ns, 32);
+    std::remove(path.c_str());
+}
+
+TEST(MeshCacheTest, RejectsForeignAndTruncatedFiles) {
+    const std::string path = testing::TempDir() + "prism_mesh_cache_bad.pmesh";
+    writeText(path, "v 0 0 0\n");
+    ASSERT_THROW(MeshCache{path}, std::runtime_error);
+
+    Prism::writeMeshCache(path, sampleMesh());
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    writeText(path, bytes.substr(0, bytes.size() - 8));
+    ASSERT_THROW(MeshCache{path}, std::runtime_error);
+
+    bytes[8] = 99; // Format version.
+    writeText(path, bytes);
+    ASSERT_THROW(MeshCache{path}, std::runtime_error);
+    std::remove(path.c_str());
+
+    MeshData inconsistent = sampleMesh();
+    inconsistent.material_ids.pop_back();
+    ASSERT_THROW(Prism::writeMeshCache(path, inconsistent), std::invalid_argument);
+}
+
+TEST(MeshCacheTest, ImportsObjReaderMesh) {
+    const std::string base = testing::TempDir() + "prism_mesh_cache_import";
+    writeText(base + ".mtl", "newmtl unused\nKd 0 0 1\nnewmtl a\nKd 1 0 0\nnewmtl b\nKd 0 1 0\n");
+    writeText(base + ".obj", "mtllib import.mtl\n"
+                             "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\nvn 0 0 1\n"
+                             "usemtl a\nf 1/1/1 2/1/1 3/1/1\n"
+                             "usemtl b\nf 2/1/1 4/1/1 3/1/1\n"
+                             "usemtl a\nf 3/1/1 2/1/1 1/1/1\n");
+
+    objReader reader(base + ".obj");
+    const colormap& library = reader.getColormap();
+    ASSERT_EQ(library.size(), 3);
+    ASSERT_EQ(library.getMaterialId("b"), 2);
+    ASSERT_EQ(library.getMaterialId("missing"), -1);
+    ASSERT_EQ(library.getMaterial(2).kd.getY(), 1.0);
+    ASSERT_EQ(reader.getFaces()[1].materialId, 2);
+
+    MeshData mesh = Prism::meshDataFromObjReader(reader);
+    ASSERT_EQ(mesh.vertexCount(), 4);
+    ASSERT_EQ(mesh.normalCount(), 1);
+    ASSERT_EQ(mesh.indices, (std::vector<uint32_t>{0, 1, 2, 1, 3, 2, 2, 1, 0}));
+    ASSERT_EQ(mesh.material_ids, (std::vector<uint32_t>{0, 1, 0}));
+    ASSERT_EQ(mesh.materials.size(), 2);
+    ASSERT_EQ(mesh.materials[1].kd[1], 1.0f);
+    ASSERT_EQ(mesh.material_names, (std::vector<std::string>{"a", "b"}));
+
+    // Getters hand out the reader's own buffers; taking them moves them out without a copy.
+    ASSERT_EQ(&reader.getFaces(), &reader.getFaces());
+    const Face* faces = reader.getFaces().data();
+    const std::vector<Face> taken = reader.takeFaces();
+    ASSERT_EQ(taken.data(), faces);
+    ASSERT_TRUE(reader.getFaces().empty());
+
+    objReader moved(base + ".obj");
+    const MeshData from_moved = Prism::meshDataFromObjReader(std::move(moved));
+    ASSERT_EQ(from_moved.positions, mesh.positions);
+    ASSERT_EQ(from_moved.indices, mesh.indices);
+    ASSERT_EQ(from_moved.material_ids, mesh.material_ids);
+    ASSERT_TRUE(moved.getVertices().empty());
+    ASSERT_TRUE(moved.getFacePoints().empty());
+
+    const Prism::SourceFingerprint source = Prism::fingerprintSources(base + ".obj", base + ".mtl");
+    ASSERT_GT(source.obj_size, 0);
+    ASSERT_GT(source.mtl_size, 0);
+    Prism::writeMeshCache(base + ".pmesh", mesh, source);
+    {
+        MeshCache cache(base + ".pmesh");
+        ASSERT_EQ(cache.triangleCount(), 3);
+        ASSERT_EQ(cache.materialNames()[1], "b");
+        ASSERT_EQ(cache.source(), source);
+    }
+
+    // Editing either source file changes the fingerprint, so the cache is seen to be stale.
+    writeText(base + ".mtl", "newmtl a\nKd 1 0 0\nnewmtl b\nKd 0 1 0\n");
+    ASSERT_NE(Prism::fingerprintSources(base + ".obj", base + ".mtl"), source);
+    std::remove((base + ".mtl").c_str());
+    const Prism::SourceFingerprint missing =
+        Prism::fingerprintSources(base + ".obj", base + ".mtl");
+    ASSERT_EQ(missing.obj_size, source.obj_size);
+    ASSERT_EQ(missing.mtl_size, 0);
+    ASSERT_EQ(missing.mtl_time, 0);
+
+    std::remove((base + ".obj").c_str());
+    std::remove((base + ".pmesh").c_str());
+}
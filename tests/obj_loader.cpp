@@ -0,0 +1,117 @@
+#include "Prism/mapped_file.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/thread_pool.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Prism::MeshData;
+
+namespace {
+
+MeshData parse(const std::string& text) {
+    return Prism::parseObj(text.data(), text.size());
+}
+
+} // namespace
+
+TEST(ObjLoaderTest, ParsesVerticesNormalsAndFaces) {
+    const std::string text = "# a triangle\n"
+                             "mtllib cubo.mtl\n"
+                             "v 0 0 0\n"
+                             "v 1.5 -2e-1 +3\n"
+                             "v 0 1 0\r\n"
+                             "vt 0 0\n"
+                             "vn 0 0 1\n"
+                             "usemtl Material\n"
+                             "f 1/1/1 2/1/1 3/1/1\n"
+                             "f 1//1 3//1 2//1\n"
+                             "f 3 2 1";
+    MeshData mesh = parse(text);
+
+    ASSERT_EQ(mesh.vertexCount(), 3);
+    ASSERT_EQ(mesh.normalCount(), 1);
+    ASSERT_EQ(mesh.triangleCount(), 3);
+    ASSERT_FLOAT_EQ(mesh.positions[3], 1.5f);
+    ASSERT_FLOAT_EQ(mesh.positions[4], -0.2f);
+    ASSERT_FLOAT_EQ(mesh.positions[5], 3.0f);
+    ASSERT_EQ(mesh.indices, (std::vector<uint32_t>{0, 1, 2, 0, 2, 1, 2, 1, 0}));
+    ASSERT_EQ(mesh.normal_indices[3], 0);
+    ASSERT_EQ(mesh.normal_indices[8], MeshData::kNoIndex);
+    ASSERT_EQ(mesh.material_library, "cubo.mtl");
+    ASSERT_EQ(mesh.material_names, std::vector<std::string>{"Material"});
+    ASSERT_EQ(mesh.material_ids, (std::vector<uint32_t>{0, 0, 0}));
+}
+
+TEST(ObjLoaderTest, TriangulatesPolygonsAndResolvesRelativeIndices) {
+    MeshData mesh = parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf -4 -3 -2 -1\n");
+    ASSERT_EQ(mesh.indices, (std::vector<uint32_t>{0, 1, 2, 0, 2, 3}));
+    ASSERT_EQ(mesh.material_ids, (std::vector<uint32_t>{MeshData::kNoIndex, MeshData::kNoIndex}));
+}
+
+TEST(ObjLoaderTest, RejectsMalformedInput) {
+    ASSERT_THROW(parse("v 1 2\n"), std::runtime_error);
+    ASSERT_THROW(parse("v 0 0 0\nf 1 2\n"), std::runtime_error);
+    ASSERT_THROW(parse("v 0 0 0\nv 1 0 0\nf 1 2 3\n"), std::runtime_error);
+    ASSERT_THROW(parse("v 0 0 0\nf 1 1 -2\n"), std::runtime_error);
+    ASSERT_THROW(parse("v 0 0 0\nf 1 1 0\n"), std::runtime_error);
+    ASSERT_THROW(parse("v 0 0 0\nf 1 1 1x\n"), std::runtime_error);
+    ASSERT_THROW(Prism::parseObj("", 0, nullptr, 0), std::invalid_argument);
+}
+
+TEST(ObjLoaderTest, ParallelChunksMatchSerialParse) {
+    std::ostringstream text;
+    text << "mtllib scene.mtl\n";
+    for (int i = 0; i < 200; ++i) {
+        text << "v " << i << " " << i * 0.5 << " -" << i << "\n";
+        text << "vn 0 0 1\n";
+        if (i % 50 == 10) {
+            text << "usemtl m" << (i / 50) % 2 << "\n";
+        }
+        if (i >= 3) {
+            text << "f -1//-1 " << i - 1 << "//" << i << " -3//1 " << i - 2 << "\n";
+        }
+    }
+    const std::string data = text.str();
+
+    MeshData serial = Prism::parseObj(data.data(), data.size());
+    Prism::ThreadPool pool(4);
+    MeshData parallel = Prism::parseObj(data.data(), data.size(), &pool, 64);
+
+    ASSERT_EQ(serial.triangleCount(), 2 * 197);
+    ASSERT_EQ(parallel.positions, serial.positions);
+    ASSERT_EQ(parallel.normals, serial.normals);
+    ASSERT_EQ(parallel.indices, serial.indices);
+    ASSERT_EQ(parallel.normal_indices, serial.normal_indices);
+    ASSERT_EQ(parallel.material_ids, serial.material_ids);
+    ASSERT_EQ(parallel.material_names, (std::vector<std::string>{"m0", "m1"}));
+    ASSERT_EQ(parallel.material_library, "scene.mtl");
+    ASSERT_EQ(serial.material_ids.front(), MeshData::kNoIndex);
+    ASSERT_EQ(serial.material_ids.back(), 1);
+}
+
+TEST(ObjLoaderTest, LoadsMappedFile) {
+    const std::string path = testing::TempDir() + "prism_obj_loader_test.obj";
+    {
+        std::ofstream out(path);
+        out << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+    }
+    {
+        Prism::MappedFile file(path);
+        ASSERT_EQ(file.size(), 32);
+        Prism::MappedFile moved(std::move(file));
+        ASSERT_EQ(file.data(), nullptr);
+        ASSERT_EQ(std::string(moved.data(), 7), "v 0 0 0");
+    }
+
+    MeshData mesh = Prism::loadObj(path);
+    ASSERT_EQ(mesh.triangleCount(), 1);
+    std::remove(path.c_str());
+
+    ASSERT_THROW(Prism::loadObj(path), std::runtime_error);
+}
@@ -3,7 +3,9 @@
 #include "Prism/point.hpp"
 #include "Prism/vector.hpp"
 #include "TestHelpers.hpp"
+#include <cmath>
 #include <gtest/gtest.h>
+#include <type_traits>
 
 using namespace Prism;
 using std::vector;
@@ -25,11 +27,8 @@ TEST(RayTest, ConstructorWithDirection) {
     Vector3 dir(1.0L, 0.0L, 0.0L);
     Ray ray(origin, dir);
 
-    ASSERT_NE(ray.origin, nullptr);
-    ASSERT_NE(ray.direction, nullptr);
-
-    EXPECT_DOUBLE_EQ(ray.origin->x, 0.0L);
-    EXPECT_DOUBLE_EQ(ray.direction->x, 1.0L);
+    EXPECT_DOUBLE_EQ(ray.origin.x, 0.0L);
+    EXPECT_DOUBLE_EQ(ray.direction.x, 1.0L);
 }
 
 TEST(RayTest, ConstructorWithTarget) {
@@ -37,21 +36,34 @@ TEST(RayTest, ConstructorWithTarget) {
     Point3 target(0.0L, 0.0L, 2.0L);
     Ray ray(origin, target);
 
-    ASSERT_NE(ray.origin, nullptr);
-    ASSERT_NE(ray.direction, nullptr);
-
-    EXPECT_DOUBLE_EQ(ray.origin->x, 0.0L);
-    EXPECT_DOUBLE_EQ(ray.direction->z, 1.0L); // pointing towards +z
+    EXPECT_DOUBLE_EQ(ray.origin.x, 0.0L);
+    EXPECT_DOUBLE_EQ(ray.direction.z, 1.0L); // pointing towards +z
 }
 
-TEST(RayTest, DirectionReturnsCorrectPointer) {
+TEST(RayTest, DirectionReturnsCorrectVector) {
     Point3 origin(0.0L, 0.0L, 0.0L);
     Vector3 dir(0.0L, 1.0L, 0.0L);
     Ray ray(origin, dir);
 
-    Vector3* d = ray.Direction();
-    ASSERT_NE(d, nullptr);
-    EXPECT_DOUBLE_EQ(d->y, 1.0L);
+    const Vector3& d = ray.Direction();
+    EXPECT_DOUBLE_EQ(d.y, 1.0L);
+}
+
+TEST(RayTest, StoresInverseDirection) {
+    Ray ray(Point3(0.0L, 0.0L, 0.0L), Vector3(0.0L, 3.0L, -4.0L));
+
+    EXPECT_NEAR(ray.inv_direction.y, 1 / 0.6L, kEpsilon);
+    EXPECT_NEAR(ray.inv_direction.z, 1 / -0.8L, kEpsilon);
+    EXPECT_TRUE(std::isinf(ray.inv_direction.x));
+}
+
+TEST(RayTest, IsPlainValue) {
+    EXPECT_TRUE(std::is_trivially_copyable<Ray>::value);
+
+    Ray original(Point3(1.0L, 2.0L, 3.0L), Vector3(0.0L, 0.0L, 1.0L));
+    Ray copy = original;
+    original.origin.x = 10.0L;
+    EXPECT_DOUBLE_EQ(copy.origin.x, 1.0L);
 }
 
 TEST(RayTest, GethitFindsIntersection) {
@@ -67,7 +79,7 @@ TEST(RayTest, GethitFindsIntersection) {
 
     HitRecord hit = ray.Gethit(objects, t_min, t_max);
 
-    EXPECT_NEAR(hit.t, 2.0L, 1e-9);
+    EXPECT_NEAR(hit.t, 2.0L, kEpsilon);
     EXPECT_EQ(hit.p.x, 1.0L);
     EXPECT_EQ(hit.p.y, 1.0L);
     EXPECT_EQ(hit.normal.y, -1.0L);
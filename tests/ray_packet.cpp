@@ -0,0 +1,122 @@
+#include "Prism/camera.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/ray_packet.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/triangle_mesh.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace Prism;
+using std::vector;
+
+namespace {
+
+// Unbounded object: the plane y = -3, tested against every ray outside the BVH.
+class TestFloor : public Object {
+  public:
+    bool hit(const Ray& ray, ld t_min, ld t_max, HitRecord& rec) const override {
+        if (ray.direction.y == 0) {
+            return false;
+        }
+        const ld t = (-3 - ray.origin.y) / ray.direction.y;
+        if (t <= t_min || t >= t_max) {
+            return false;
+        }
+        rec.t = t;
+        rec.p = ray.origin + ray.direction * t;
+        rec.material = nullptr;
+        rec.set_face_normal(ray, Vector3(0, 1, 0));
+        return true;
+    }
+};
+
+// Bumpy grid in front of the camera, in the plane z = -8.
+MeshData Grid() {
+    return GridMesh(12, 12, [](float x, float y) { return -8 + 0.3f * std::sin(x * y); });
+}
+
+} // namespace
+
+TEST(RayPacketTest, CameraPacketMatchesGetRay) {
+    // 10x7 pixels: the tiles on the right and bottom edges are partial.
+    Camera cam(Point3(1, 2, 3), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 3.0, 7, 10);
+    RayPacket packet;
+    for (int y0 = 0; y0 < cam.pixel_height; y0 += RayPacket::kHeight) {
+        for (int x0 = 0; x0 < cam.pixel_width; x0 += RayPacket::kWidth) {
+            cam.getPacket(x0, y0, packet);
+            ASSERT_EQ(packet.x0, x0);
+            ASSERT_EQ(packet.y0, y0);
+            for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+                const int x = x0 + lane % RayPacket::kWidth;
+                const int y = y0 + lane / RayPacket::kWidth;
+                ASSERT_EQ(packet.active[lane], x < cam.pixel_width && y < cam.pixel_height);
+                if (!packet.active[lane]) {
+                    continue;
+                }
+                const Ray expected = cam.getRay(x, y);
+                const Ray ray = packet.ray(lane);
+                AssertPointAlmostEqual(ray.origin, expected.origin);
+                AssertVectorAlmostEqual(ray.direction, expected.direction);
+                ASSERT_NEAR(ray.direction.x * ray.inv_direction.x, 1, kEpsilon);
+                ASSERT_NEAR(ray.direction.y * ray.inv_direction.y, 1, kEpsilon);
+                ASSERT_NEAR(ray.direction.z * ray.inv_direction.z, 1, kEpsilon);
+            }
+        }
+    }
+
+    ASSERT_THROW(cam.getPacket(10, 0, packet), std::out_of_range);
+    ASSERT_THROW(cam.getPacket(0, -1, packet), std::out_of_range);
+}
+
+TEST(RayPacketTest, SceneMatchesSingleRays) {
+    TriangleMesh mesh(Grid());
+    TestFloor floor;
+    vector<TestSphere> spheres;
+    for (int i = -2; i <= 2; ++i) {
+        spheres.emplace_back(Point3(i * 1.5, 0.5 * i, -5), 0.6);
+    }
+    vector<Object*> objects = {&mesh, &floor};
+    for (TestSphere& sphere : spheres) {
+        objects.push_back(&sphere);
+    }
+    Scene scene(objects);
+
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 30, 30);
+    RayPacket packet;
+    PacketHit hits;
+    int hit_count = 0;
+    for (int y0 = 0; y0 < cam.pixel_height; y0 += RayPacket::kHeight) {
+        for (int x0 = 0; x0 < cam.pixel_width; x0 += RayPacket::kWidth) {
+            cam.getPacket(x0, y0, packet);
+            scene.hit(packet, 0.001L, 100.0L, hits);
+            for (int lane = 0; lane < RayPacket::kSize; ++lane) {
+                if (!packet.active[lane]) {
+                    ASSERT_FALSE(hits.hit[lane]);
+                    continue;
+                }
+                HitRecord expected;
+                const bool hit = scene.hit(packet.ray(lane), 0.001L, 100.0L, expected);
+                ASSERT_EQ(hits.hit[lane], hit);
+                if (hit) {
+                    ++hit_count;
+                    ASSERT_NEAR(hits.records[lane].t, expected.t, kEpsilon);
+                    ASSERT_NEAR(hits.t_max[lane], expected.t, kEpsilon);
+                    AssertVectorAlmostEqual(hits.records[lane].normal, expected.normal);
+                }
+            }
+        }
+    }
+    ASSERT_GT(hit_count, 0);
+    ASSERT_LT(hit_count, cam.pixel_width * cam.pixel_height);
+
+    Scene unbuilt;
+    unbuilt.add(&floor);
+    ASSERT_THROW(unbuilt.hit(packet, 0.001L, 100.0L, hits), std::logic_error);
+}
@@ -0,0 +1,80 @@
+#include "Prism/renderer.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/image.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace Prism;
+
+namespace {
+
+Vector3 ShadeNormal(const Scene& scene, const Ray& ray) {
+    HitRecord rec;
+    if (scene.hit(ray, 0.001L, 1000.0L, rec)) {
+        return (rec.normal + 1) * 0.5;
+    }
+    return Vector3(0, 0, 0);
+}
+
+} // namespace
+
+TEST(RendererTest, TilesCoverImageExactlyOnce) {
+    const int width = 70;
+    const int height = 45;
+    std::vector<Tile> tiles = Renderer::makeTiles(width, height, 16);
+    ASSERT_EQ(tiles.size(), 5 * 3);
+
+    std::vector<int> covered(width * height, 0);
+    for (const auto& tile : tiles) {
+        ASSERT_LE(tile.x1 - tile.x0, 16);
+        ASSERT_LE(tile.y1 - tile.y0, 16);
+        for (int y = tile.y0; y < tile.y1; ++y) {
+            for (int x = tile.x0; x < tile.x1; ++x) {
+                covered[y * width + x]++;
+            }
+        }
+    }
+    for (int count : covered) {
+        ASSERT_EQ(count, 1);
+    }
+}
+
+TEST(RendererTest, MatchesCameraIterator) {
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0L, 2.0L, 2.0L, 12, 20);
+    Renderer renderer(3, 8);
+
+    Image image = renderer.render(cam, [](const Ray& ray) { return ray.direction; });
+    ASSERT_EQ(image.width(), 20);
+    ASSERT_EQ(image.height(), 12);
+
+    size_t index = 0;
+    for (const auto& ray : cam) {
+        AssertVectorAlmostEqual(image.pixels()[index], ray.direction);
+        index++;
+    }
+}
+
+TEST(RendererTest, OutputIndependentOfThreadCount) {
+    TestSphere sphere(Point3(0, 0, -3), 1);
+    TestSphere other(Point3(1, 1, -4), 0.75);
+    Scene scene({&sphere, &other});
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0L, 2.0L, 2.0L, 33, 47);
+
+    auto shade = [&](const Ray& ray) { return ShadeNormal(scene, ray); };
+    Image single = Renderer(1, 7).render(cam, shade);
+    Image many = Renderer(4, 5).render(cam, shade);
+
+    ASSERT_EQ(single.pixels(), many.pixels());
+}
+
+TEST(RendererTest, RejectsInvalidTileSize) {
+    ASSERT_THROW(Renderer(1, 0), std::invalid_argument);
+    ASSERT_THROW(Image(0, 10), std::invalid_argument);
+}
@@ -0,0 +1,269 @@
+#include "Prism/sampler.hpp"
+#include "Prism/accumulator.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/renderer.hpp"
+#include "Prism/vector.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace Prism;
+
+namespace {
+
+// Checks that the first 2^m points of two dimensions put exactly one point in every elementary
+// interval of area 2^-m, i.e. that they form a (0, m, 2)-net.
+void ExpectNet(const std::vector<Sample2D>& points, int m) {
+    for (int i = 0; i <= m; ++i) {
+        const int columns = 1 << i, rows = 1 << (m - i);
+        std::vector<int> cells(points.size(), 0);
+        for (const Sample2D& p : points) {
+            ++cells[static_cast<int>(p.v * rows) * columns + static_cast<int>(p.u * columns)];
+        }
+        for (int count : cells) {
+            ASSERT_EQ(count, 1) << columns << "x" << rows;
+        }
+    }
+}
+
+std::vector<Sample2D> PixelSamples(Sampler& sampler, int x, int y, int count, int skip) {
+    std::vector<Sample2D> points;
+    for (int i = 0; i < count; ++i) {
+        sampler.startPixelSample(x, y, i);
+        for (int d = 0; d < skip; ++d) {
+            sampler.get1D();
+        }
+        points.push_back(sampler.get2D());
+    }
+    return points;
+}
+
+// Murmur3 finalizer, as in sampler.cpp; seeds the initial pattern of VoidAndCluster.
+uint32_t Mix(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// Void-and-cluster (Ulichney 1993) ranking of a toroidal tile, with a Gaussian filter: the
+// generator of the precomputed blue-noise table.
+std::vector<int> VoidAndCluster(int size) {
+    const int count = size * size;
+    constexpr int kRadius = 7;
+    constexpr float kSigma = 1.5f;
+
+    std::array<float, (2 * kRadius + 1) * (2 * kRadius + 1)> filter{};
+    for (int dy = -kRadius; dy <= kRadius; ++dy) {
+        for (int dx = -kRadius; dx <= kRadius; ++dx) {
+            filter[(dy + kRadius) * (2 * kRadius + 1) + dx + kRadius] =
+                std::exp(-(dx * dx + dy * dy) / (2 * kSigma * kSigma));
+        }
+    }
+
+    std::vector<float> energy(count, 0.0f);
+    std::vector<uint8_t> on(count, 0);
+    const auto toggle = [&](int i, float sign) {
+        on[i] = sign > 0;
+        const int x = i % size, y = i / size;
+        for (int dy = -kRadius; dy <= kRadius; ++dy) {
+            const int row = (y + dy + size) % size * size;
+            for (int dx = -kRadius; dx <= kRadius; ++dx) {
+                energy[row + (x + dx + size) % size] +=
+                    sign * filter[(dy + kRadius) * (2 * kRadius + 1) + dx + kRadius];
+            }
+        }
+    };
+    // Tightest cluster: the set pixel with the most energy. Largest void: the unset pixel with
+    // the least.
+    const auto extreme = [&](uint8_t state) {
+        int best = -1;
+        for (int i = 0; i < count; ++i) {
+            if (on[i] == state && (best < 0 || (state ? energy[i] > energy[best]
+                                                      : energy[i] < energy[best]))) {
+                best = i;
+            }
+        }
+        return best;
+    };
+
+    // Initial binary pattern: random pixels, relaxed until the tightest cluster is the void.
+    int ones = 0;
+    for (uint32_t n = 0; ones < count / 10; ++n) {
+        const int i = static_cast<int>(Mix(n) % count);
+        if (!on[i]) {
+            toggle(i, 1);
+            ++ones;
+        }
+    }
+    for (;;) {
+        const int cluster = extreme(1);
+        toggle(cluster, -1);
+        const int hole = extreme(0);
+        toggle(hole, 1);
+        if (hole == cluster) {
+            break;
+        }
+    }
+    const std::vector<float> prototype_energy = energy;
+    const std::vector<uint8_t> prototype = on;
+
+    std::vector<int> rank(count);
+    for (int r = ones - 1; r >= 0; --r) {
+        const int cluster = extreme(1);
+        toggle(cluster, -1);
+        rank[cluster] = r;
+    }
+    energy = prototype_energy;
+    on = prototype;
+    for (int r = ones; r < count; ++r) {
+        const int hole = extreme(0);
+        toggle(hole, 1);
+        rank[hole] = r;
+    }
+    return rank;
+}
+
+} // namespace
+
+TEST(SamplerTest, SobolTableMatchesReference) {
+    // Second dimension: 0, 1/2, 3/4, 1/4, 5/8, 1/8, ...
+    const uint32_t expected[] = {0x0, 0x80000000u, 0xC0000000u, 0x40000000u, 0xA0000000u,
+                                 0x20000000u};
+    for (uint32_t i = 0; i < 6; ++i) {
+        ASSERT_EQ(SobolSampler::sobol(i, 1), expected[i]) << i;
+    }
+    ASSERT_EQ(SobolSampler::sobol(5, 0), 0xA0000000u);
+
+    // Every tabulated dimension is stratified in one dimension.
+    for (int d = 0; d < SobolSampler::kSobolDimensions; ++d) {
+        std::set<uint32_t> strata;
+        for (uint32_t i = 0; i < 256; ++i) {
+            strata.insert(SobolSampler::sobol(i, d) >> 24);
+        }
+        ASSERT_EQ(strata.size(), 256u) << d;
+    }
+}
+
+TEST(SamplerTest, ScrambledSobolIsStratifiedInEveryPixel) {
+    SobolSampler sampler(7);
+    const std::vector<Sample2D> a = PixelSamples(sampler, 3, 5, 256, 0);
+    const std::vector<Sample2D> b = PixelSamples(sampler, 4, 5, 256, 0);
+    ExpectNet(a, 8);
+    ExpectNet(b, 8);
+    ExpectNet(std::vector<Sample2D>(a.begin(), a.begin() + 16), 4);
+    ASSERT_NE(a[0].u, b[0].u);
+
+    // Dimensions past the table are still uniform: their mean converges.
+    ld mean = 0;
+    for (int i = 0; i < 1024; ++i) {
+        sampler.startPixelSample(0, 0, i);
+        for (int d = 0; d < 2 * SobolSampler::kSobolDimensions + 3; ++d) {
+            sampler.get1D();
+        }
+        mean += sampler.get1D();
+    }
+    ASSERT_NEAR(mean / 1024, 0.5, 0.01);
+}
+
+TEST(SamplerTest, SamplesAreReproducible) {
+    SobolSampler sobol;
+    BlueNoiseSampler blue;
+    for (Sampler* sampler : {static_cast<Sampler*>(&sobol), static_cast<Sampler*>(&blue)}) {
+        sampler->startPixelSample(10, 20, 3);
+        sampler->get1D();
+        const std::unique_ptr<Sampler> copy = sampler->clone();
+        const Sample2D first = sampler->get2D();
+        const Sample2D cloned = copy->get2D();
+        ASSERT_EQ(first.u, cloned.u);
+        ASSERT_EQ(first.v, cloned.v);
+        sampler->startPixelSample(10, 20, 3);
+        sampler->get1D();
+        ASSERT_EQ(sampler->get2D().u, first.u);
+        ASSERT_GE(first.u, 0);
+        ASSERT_LT(first.u, 1);
+    }
+}
+
+TEST(SamplerTest, BlueNoiseTileIsBlue) {
+    const int size = BlueNoiseSampler::kBlueNoiseSize;
+    std::set<float> values;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            values.insert(BlueNoiseSampler::blueNoise(x, y));
+        }
+    }
+    ASSERT_EQ(values.size(), size_t(size) * size);
+    ASSERT_EQ(BlueNoiseSampler::blueNoise(-1, 2 * size), BlueNoiseSampler::blueNoise(size - 1, 0));
+
+    // Little low-frequency energy: every 8x8 window averages close to 1/2, where white noise
+    // would stray by several times more.
+    ld worst = 0;
+    for (int y0 = 0; y0 < size; y0 += 4) {
+        for (int x0 = 0; x0 < size; x0 += 4) {
+            ld sum = 0;
+            for (int y = y0; y < y0 + 8; ++y) {
+                for (int x = x0; x < x0 + 8; ++x) {
+                    sum += BlueNoiseSampler::blueNoise(x, y);
+                }
+            }
+            worst = std::max(worst, std::abs(sum / 64 - ld(0.5)));
+        }
+    }
+    ASSERT_LT(worst, 0.04);
+
+    // The samples of a pixel are a rotated stratified set: their mean is within a stratum of 1/2.
+    BlueNoiseSampler sampler;
+    for (int x = 0; x < 8; ++x) {
+        ld mean = 0;
+        for (const Sample2D& p : PixelSamples(sampler, x, 2, 64, 1)) {
+            mean += p.u + p.v;
+        }
+        ASSERT_NEAR(mean / 128, 0.5, 1.0 / 64) << x;
+    }
+}
+
+TEST(SamplerTest, BlueNoiseTableMatchesGenerator) {
+    const int size = BlueNoiseSampler::kBlueNoiseSize;
+    const std::vector<int> rank = VoidAndCluster(size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            const float expected = (rank[y * size + x] + 0.5f) / (size * size);
+            ASSERT_EQ(BlueNoiseSampler::blueNoise(x, y), expected) << x << ", " << y;
+        }
+    }
+}
+
+TEST(SamplerTest, RendererDrawsShadingDimensionsFromSampler) {
+    const Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 6, 6);
+    Renderer renderer(2, 4);
+    ASSERT_NE(dynamic_cast<const SobolSampler*>(&renderer.sampler()), nullptr);
+    renderer.setSampler(BlueNoiseSampler());
+    ASSERT_NE(dynamic_cast<const BlueNoiseSampler*>(&renderer.sampler()), nullptr);
+    renderer.setSampler(SobolSampler(3));
+
+    // Estimates the integral of u^2 over [0, 1): stratified samples get much closer to 1/3 than
+    // independent ones would (about 0.3 / sqrt(64) = 0.037).
+    const Renderer::SampledShader shade = [](const Ray&, Sampler& sampler) {
+        const ld u = sampler.get1D();
+        return Vector3(u * u, 0, 0);
+    };
+    Accumulator buffer(6, 6);
+    for (int pass = 0; pass < 64; ++pass) {
+        ASSERT_TRUE(renderer.renderPass(cam, shade, buffer));
+    }
+    for (int y = 0; y < 6; ++y) {
+        for (int x = 0; x < 6; ++x) {
+            ASSERT_NEAR(buffer.mean(x, y).x, 1.0 / 3, 0.005);
+        }
+    }
+}
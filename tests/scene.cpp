@@ -0,0 +1,109 @@
+#include "Prism/scene.hpp"
+#include "Prism/fixed_matrix.hpp"
+#include "Prism/instance.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/triangle_mesh.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Prism;
+using std::vector;
+
+TEST(SceneTest, HitFindsClosestObject) {
+    TestSphere near_sphere(Point3(0, 0, -5), 1);
+    TestSphere far_sphere(Point3(0, 0, -20), 1);
+    Scene scene({&far_sphere, &near_sphere});
+
+    Ray ray(Point3(0, 0, 0), Vector3(0, 0, -1));
+    HitRecord rec;
+    ASSERT_TRUE(scene.hit(ray, 0.001L, 1000.0L, rec));
+    ASSERT_NEAR(rec.t, 4.0L, kEpsilon);
+    ASSERT_TRUE(rec.front_face);
+}
+
+TEST(SceneTest, MissAndRange) {
+    TestSphere sphere(Point3(0, 0, -5), 1);
+    Scene scene({&sphere});
+
+    HitRecord rec;
+    ASSERT_FALSE(scene.hit(Ray(Point3(0, 0, 0), Vector3(0, 1, 0)), 0.001L, 1000.0L, rec));
+    ASSERT_FALSE(scene.hit(Ray(Point3(0, 0, 0), Vector3(0, 0, -1)), 0.001L, 3.0L, rec));
+}
+
+TEST(SceneTest, RequiresBuildAfterAdd) {
+    TestSphere sphere(Point3(0, 0, -5), 1);
+    Scene scene;
+    scene.add(&sphere);
+
+    Ray ray(Point3(0, 0, 0), Vector3(0, 0, -1));
+    HitRecord rec;
+    ASSERT_FALSE(scene.isBuilt());
+    ASSERT_THROW(scene.hit(ray, 0.001L, 1000.0L, rec), std::logic_error);
+
+    scene.build();
+    ASSERT_TRUE(scene.hit(ray, 0.001L, 1000.0L, rec));
+}
+
+TEST(SceneTest, GethitThroughScene) {
+    TestSphere sphere(Point3(0, 0, -5), 1);
+    Scene scene({&sphere});
+
+    Ray ray(Point3(0, 0, 0), Vector3(0, 0, -1));
+    HitRecord hit = ray.Gethit(scene, 0.001L, 1000.0L);
+    EXPECT_NEAR(hit.t, 4.0L, kEpsilon);
+    AssertPointAlmostEqual(hit.p, Point3(0, 0, -4));
+
+    Ray miss(Point3(0, 0, 0), Vector3(0, 0, 1));
+    EXPECT_EQ(miss.Gethit(scene, 0.001L, 1000.0L).t, 1000.0L);
+}
+
+TEST(SceneTest, OccludedAgreesWithClosestHit) {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    MeshData data;
+    for (uint32_t i = 0; i < 300; ++i) {
+        const float cx = pos(gen), cy = pos(gen), cz = pos(gen);
+        for (int k = 0; k < 3; ++k) {
+            const float p[3] = {cx + offset(gen), cy + offset(gen), cz + offset(gen)};
+            data.positions.insert(data.positions.end(), p, p + 3);
+            data.indices.push_back(3 * i + k);
+        }
+    }
+    data.normal_indices.assign(data.indices.size(), MeshData::kNoIndex);
+    data.material_ids.assign(300, MeshData::kNoIndex);
+    TriangleMesh mesh(data);
+    Instance instance(mesh, translation(Vector3(0, 0, -25)) * rotation(Vector3(0, 1, 0), 0.5));
+    TestSphere near_sphere(Point3(2, 0, -4), 1);
+    TestSphere far_sphere(Point3(-3, 2, -30), 4);
+    const Scene scene({&instance, &near_sphere, &far_sphere, &mesh});
+
+    std::uniform_real_distribution<double> dir(-1.0, 1.0);
+    int blocked = 0;
+    for (int i = 0; i < 1000; ++i) {
+        const Ray ray(Point3(0, 0, 0), Vector3(dir(gen), dir(gen), dir(gen) - 1));
+        HitRecord rec;
+        const bool hit = scene.hit(ray, 0.001L, 1000.0L, rec);
+        ASSERT_EQ(scene.occluded(ray, 0.001L, 1000.0L), hit);
+        if (hit) {
+            ++blocked;
+            // Nothing lies before the closest hit, and the closest hit itself blocks.
+            ASSERT_FALSE(scene.occluded(ray, 0.001L, rec.t * ld(0.999)));
+            ASSERT_TRUE(scene.occluded(ray, 0.001L, rec.t * ld(1.001)));
+        }
+    }
+    ASSERT_GT(blocked, 100);
+    ASSERT_LT(blocked, 1000);
+
+    Scene unbuilt;
+    unbuilt.add(&near_sphere);
+    ASSERT_THROW(unbuilt.occluded(Ray(Point3(0, 0, 0), Vector3(0, 0, -1)), 0.001L, 1000.0L),
+                 std::logic_error);
+}
@@ -0,0 +1,144 @@
+#include "Prism/shadow_queue.hpp"
+#include "Prism/aabb.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/image.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/renderer.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Prism;
+
+namespace {
+
+// Direct light from every light of the scene at a hit, with the shadow tests left to the caller.
+template <typename Light> Vector3 Shade(const LitScene& lit, const Ray& ray, Light&& light) {
+    HitRecord rec;
+    if (!lit.scene.hit(ray, 0.001L, 1000.0L, rec)) {
+        return Vector3(0.1, 0.1, 0.1);
+    }
+    for (const Point3& position : lit.lights) {
+        const Vector3 to_light = position - rec.p;
+        const ld distance = to_light.magnitude();
+        const ld cosine = rec.normal.dot(to_light) / distance;
+        if (cosine > 0) {
+            light(Ray(rec.p, to_light), distance, Vector3(cosine, cosine, cosine) * ld(0.3));
+        }
+    }
+    return Vector3(0.05, 0.05, 0.05);
+}
+
+} // namespace
+
+TEST(ShadowQueueTest, SortsByOctantThenOrigin) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> coord(-5.0, 5.0);
+    ShadowQueue queue;
+    for (uint32_t i = 0; i < 500; ++i) {
+        queue.setPixel(i);
+        queue.push(Ray(Point3(coord(gen), coord(gen), coord(gen)),
+                       Vector3(coord(gen), coord(gen), coord(gen))),
+                   0.001L, 10, Vector3(1, 0, 0));
+    }
+    queue.sort();
+    ASSERT_EQ(queue.size(), 500u);
+
+    AABB origins;
+    for (const ShadowRay& shadow : queue.rays()) {
+        origins.expand(shadow.ray.origin);
+    }
+    std::vector<bool> seen(500, false);
+    uint64_t previous = 0;
+    for (const ShadowRay& shadow : queue.rays()) {
+        const uint64_t key = ShadowQueue::sortKey(shadow.ray, origins);
+        ASSERT_GE(key, previous);
+        previous = key;
+        ASSERT_FALSE(seen[shadow.pixel]);
+        seen[shadow.pixel] = true;
+    }
+    // Every octant is present and they come one after the other.
+    const auto octant = [](const ShadowRay& s) {
+        return (s.ray.direction.x < 0) + 2 * (s.ray.direction.y < 0) + 4 * (s.ray.direction.z < 0);
+    };
+    ASSERT_EQ(octant(queue.rays().front()), 0);
+    ASSERT_EQ(octant(queue.rays().back()), 7);
+
+    // Nearby origins get nearby keys: the two halves of the box along x are not interleaved.
+    const Ray low(Point3(-4, 0, 0), Vector3(1, 1, 1));
+    const Ray high(Point3(4, 0, 0), Vector3(1, 1, 1));
+    const Ray other(Point3(-4, 0, 0), Vector3(-1, 1, 1));
+    const AABB box(Point3(-5, -5, -5), Point3(5, 5, 5));
+    ASSERT_LT(ShadowQueue::sortKey(low, box), ShadowQueue::sortKey(high, box));
+    ASSERT_LT(ShadowQueue::sortKey(high, box), ShadowQueue::sortKey(other, box));
+}
+
+TEST(ShadowQueueTest, TracesLikeOccluded) {
+    const LitScene lit;
+    ShadowQueue queue;
+    Camera cam(Point3(0, 2, 2), Point3(0, 0, -5), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 24, 24);
+    for (int y = 0; y < cam.pixel_height; ++y) {
+        for (int x = 0; x < cam.pixel_width; ++x) {
+            queue.setPixel(static_cast<uint32_t>(y * cam.pixel_width + x));
+            Shade(lit, cam.getRay(x, y), [&](const Ray& ray, ld distance, const Vector3& light) {
+                queue.push(ray, 0.001L, distance, light);
+            });
+        }
+    }
+    const std::vector<ShadowRay> pushed = queue.rays();
+
+    size_t expected_blocked = 0;
+    std::vector<int> expected_visible(cam.pixel_width * cam.pixel_height, 0);
+    for (const ShadowRay& shadow : pushed) {
+        if (lit.scene.occluded(shadow.ray, shadow.t_min, shadow.t_max)) {
+            ++expected_blocked;
+        } else {
+            ++expected_visible[shadow.pixel];
+        }
+    }
+    std::vector<int> visible(expected_visible.size(), 0);
+    const size_t blocked = queue.trace(lit.scene, [&](const ShadowRay& shadow) {
+        ++visible[shadow.pixel];
+    });
+    ASSERT_EQ(blocked, expected_blocked);
+    ASSERT_GT(blocked, 0u);
+    ASSERT_EQ(visible, expected_visible);
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(ShadowQueueTest, DeferredRenderMatchesImmediateShadows) {
+    const LitScene lit;
+    Camera cam(Point3(0, 2, 2), Point3(0, 0, -5), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 30, 40);
+
+    const Image immediate = Renderer(2, 8).render(cam, [&](const Ray& ray) {
+        Vector3 lights(0, 0, 0);
+        const Vector3 base =
+            Shade(lit, ray, [&](const Ray& shadow, ld distance, const Vector3& light) {
+                if (!lit.scene.occluded(shadow, 0.001L, distance)) {
+                    lights = lights + light;
+                }
+            });
+        return base + lights;
+    });
+    const Renderer::DeferredShader deferred = [&](const Ray& ray, ShadowQueue& queue) {
+        return Shade(lit, ray, [&](const Ray& shadow, ld distance, const Vector3& light) {
+            queue.push(shadow, 0.001L, distance, light);
+        });
+    };
+    const Image single = Renderer(1, 8).renderDeferred(cam, deferred, lit.scene);
+    const Image many = Renderer(4, 5).renderDeferred(cam, deferred, lit.scene);
+
+    ASSERT_EQ(single.pixels(), many.pixels());
+    for (size_t i = 0; i < single.pixels().size(); ++i) {
+        AssertVectorAlmostEqual(single.pixels()[i], immediate.pixels()[i], 1e-5);
+    }
+
+    Scene unbuilt;
+    ASSERT_THROW(Renderer(1, 8).renderDeferred(cam, deferred, unbuilt), std::logic_error);
+}
@@ -0,0 +1,125 @@
+#include "Prism/stats.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/image.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/renderer.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace Prism;
+
+TEST(StatsTest, SumsThreadsAndResets) {
+    resetStats();
+    addStat(StatCounter::ObjectTests, 5);
+    addStageTime(StatStage::Load, 2000000000);
+    std::thread worker([] {
+        addStat(StatCounter::ObjectTests, 7);
+        addStat(StatCounter::BVHNodes);
+    });
+    worker.join();
+
+    // The worker exited, so its statistics must have been kept.
+    StatsSnapshot stats = statsSnapshot();
+    ASSERT_EQ(stats.counter(StatCounter::ObjectTests), 12);
+    ASSERT_EQ(stats.counter(StatCounter::BVHNodes), 1);
+    ASSERT_EQ(stats.counter(StatCounter::CameraRays), 0);
+    ASSERT_DOUBLE_EQ(stats.seconds(StatStage::Load), 2.0);
+
+    resetStats();
+    stats = statsSnapshot();
+    for (int i = 0; i < kStatCounterCount; ++i) {
+        ASSERT_EQ(stats.counters[i], 0);
+    }
+    ASSERT_EQ(stats.seconds(StatStage::Load), 0);
+}
+
+TEST(StatsTest, WritesJsonSummary) {
+    StatsSnapshot stats;
+    stats.counters[static_cast<int>(StatCounter::SceneHits)] = 42;
+    stats.stage_nanoseconds[static_cast<int>(StatStage::Trace)] = 1500000000;
+
+    std::ostringstream out;
+    writeStatsJson(out, stats);
+    const std::string json = out.str();
+    ASSERT_NE(json.find(kStatsEnabled ? "\"enabled\": true" : "\"enabled\": false"),
+              std::string::npos);
+    ASSERT_NE(json.find("\"scene_hits\": 42"), std::string::npos);
+    ASSERT_NE(json.find("\"camera_rays\": 0"), std::string::npos);
+    ASSERT_NE(json.find("\"trace\": 1.5"), std::string::npos);
+    ASSERT_NE(json.find("\"write\": 0"), std::string::npos);
+    ASSERT_EQ(json.front(), '{');
+    ASSERT_EQ(json.substr(json.size() - 3), "}}\n");
+}
+
+TEST(StatsTest, CountsRenderOnlyWhenEnabled) {
+    TestSphere sphere(Point3(0, 0, -5), 1);
+    Scene scene({&sphere});
+    Camera cam(Point3(0, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 20, 30);
+    Renderer renderer(2, 8);
+
+    resetStats();
+    renderer.render(cam, [&scene](const Ray& ray) {
+        HitRecord rec;
+        return scene.hit(ray, 0.001L, 1000.0L, rec) ? Vector3(1, 1, 1) : Vector3(0, 0, 0);
+    });
+    const StatsSnapshot stats = statsSnapshot();
+
+    const uint64_t pixels = 20 * 30;
+    if (kStatsEnabled) {
+        ASSERT_EQ(stats.counter(StatCounter::CameraRays), pixels);
+        ASSERT_EQ(stats.counter(StatCounter::SceneHits) + stats.counter(StatCounter::SceneMisses),
+                  pixels);
+        ASSERT_GT(stats.counter(StatCounter::SceneHits), 0);
+        ASSERT_GT(stats.counter(StatCounter::SceneMisses), 0);
+        ASSERT_GE(stats.counter(StatCounter::BVHNodes), pixels);
+        // Only rays entering the sphere bounds reach the sphere itself.
+        ASSERT_GE(stats.counter(StatCounter::ObjectTests), stats.counter(StatCounter::SceneHits));
+        ASSERT_LT(stats.counter(StatCounter::ObjectTests), pixels);
+        ASSERT_GT(stats.seconds(StatStage::Trace), 0);
+        ASSERT_GE(stats.seconds(StatStage::Shade), stats.seconds(StatStage::Trace));
+    } else {
+        for (int i = 0; i < kStatCounterCount; ++i) {
+            ASSERT_EQ(stats.counters[i], 0);
+        }
+        for (int i = 0; i < kStatStageCount; ++i) {
+            ASSERT_EQ(stats.stage_nanoseconds[i], 0);
+        }
+    }
+}
+
+TEST(StatsTest, CountsOcclusionApartFromClosestHits) {
+    TestSphere sphere(Point3(0, 0, -5), 1);
+    Scene scene({&sphere});
+
+    resetStats();
+    int blocked = 0;
+    for (int i = 0; i < 20; ++i) {
+        blocked += scene.occluded(Ray(Point3(0, 0, 0), Vector3(i * 0.02L, 0, -1)), 0.001L, 100.0L);
+    }
+    const StatsSnapshot stats = statsSnapshot();
+    ASSERT_GT(blocked, 0);
+    ASSERT_LT(blocked, 20);
+    if (kStatsEnabled) {
+        ASSERT_EQ(stats.counter(StatCounter::OccludedRays), blocked);
+        ASSERT_EQ(stats.counter(StatCounter::UnoccludedRays), 20 - blocked);
+        ASSERT_GE(stats.counter(StatCounter::OcclusionNodes), 20);
+        ASSERT_GE(stats.counter(StatCounter::OcclusionTests), blocked);
+        ASSERT_GT(stats.seconds(StatStage::Occlusion), 0);
+        ASSERT_EQ(stats.counter(StatCounter::BVHNodes), 0);
+        ASSERT_EQ(stats.counter(StatCounter::SceneHits) + stats.counter(StatCounter::SceneMisses),
+                  0);
+        ASSERT_EQ(stats.seconds(StatStage::Trace), 0);
+    }
+
+    std::ostringstream out;
+    writeStatsJson(out, stats);
+    ASSERT_NE(out.str().find("\"occluded_rays\": "), std::string::npos);
+    ASSERT_NE(out.str().find("\"occlusion\": "), std::string::npos);
+}
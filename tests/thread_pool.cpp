@@ -0,0 +1,59 @@
+#include "Prism/thread_pool.hpp"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using Prism::ThreadPool;
+
+TEST(ThreadPoolTest, RunsEveryIterationOnce) {
+    ThreadPool pool(4);
+    ASSERT_EQ(pool.size(), 4);
+
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallelFor(visits.size(), [&](size_t i) { visits[i]++; });
+
+    for (const auto& count : visits) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, DefaultsToHardwareThreads) {
+    ThreadPool pool;
+    ASSERT_GE(pool.size(), 1);
+
+    int calls = 0;
+    pool.parallelFor(0, [&](size_t) { calls++; });
+    ASSERT_EQ(calls, 0);
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock) {
+    ThreadPool pool(2);
+    std::atomic<int> total{0};
+
+    pool.parallelFor(8, [&](size_t) {
+        pool.parallelFor(8, [&](size_t) { total++; });
+    });
+
+    ASSERT_EQ(total.load(), 64);
+}
+
+TEST(ThreadPoolTest, RethrowsExceptions) {
+    ThreadPool pool(3);
+    std::atomic<int> finished{0};
+
+    ASSERT_THROW(pool.parallelFor(16,
+                                  [&](size_t i) {
+                                      finished++;
+                                      if (i == 5) {
+                                          throw std::runtime_error("task failed");
+                                      }
+                                  }),
+                 std::runtime_error);
+    ASSERT_EQ(finished.load(), 16);
+
+    // The pool stays usable after a failed batch.
+    std::atomic<int> after{0};
+    pool.parallelFor(4, [&](size_t) { after++; });
+    ASSERT_EQ(after.load(), 4);
+}
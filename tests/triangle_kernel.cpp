@@ -0,0 +1,102 @@
+#include "Prism/triangle_kernel.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using Prism::BlockHit;
+using Prism::BlockRay;
+using Prism::SimdLevel;
+using Prism::TriangleBlock;
+
+namespace {
+
+// Restores the detected instruction set when a test that switches kernels ends.
+class SimdLevelGuard {
+  public:
+    ~SimdLevelGuard() {
+        Prism::setSimdLevel(Prism::detectSimdLevel());
+    }
+};
+
+std::vector<SimdLevel> SupportedLevels() {
+    std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+    if (Prism::detectSimdLevel() != SimdLevel::Scalar) {
+        levels.push_back(SimdLevel::SSE4);
+    }
+    if (Prism::detectSimdLevel() == SimdLevel::AVX2) {
+        levels.push_back(SimdLevel::AVX2);
+    }
+    return levels;
+}
+
+} // namespace
+
+TEST(TriangleKernelTest, FindsClosestLaneAndIgnoresPadding) {
+    SimdLevelGuard guard;
+    // Squares of triangles at z = -1 ... -5 in lanes 4 ... 0; lanes 5 to 7 are padding.
+    TriangleBlock block{};
+    for (int lane = 0; lane < 5; ++lane) {
+        const float z = -5.0f + lane;
+        const float p0[3] = {-1, -1, z}, p1[3] = {1, -1, z}, p2[3] = {-1, 1, z};
+        block.set(lane, p0, p1, p2);
+    }
+    const BlockRay ray = {{-0.5f, -0.25f, 0}, {0, 0, -1}};
+
+    for (SimdLevel level : SupportedLevels()) {
+        Prism::setSimdLevel(level);
+        ASSERT_EQ(Prism::simdLevel(), level);
+        BlockHit hit;
+        ASSERT_EQ(Prism::intersectTriangleBlock(block, ray, 0.001f, 100.0f, hit), 4)
+            << Prism::simdLevelName(level);
+        ASSERT_FLOAT_EQ(hit.t, 1.0f);
+        ASSERT_FLOAT_EQ(hit.u, 0.25f);
+        ASSERT_FLOAT_EQ(hit.v, 0.375f);
+
+        ASSERT_EQ(Prism::intersectTriangleBlock(block, ray, 1.5f, 100.0f, hit), 3);
+        ASSERT_EQ(Prism::intersectTriangleBlock(block, ray, 0.001f, 0.5f, hit), -1);
+        const BlockRay outside = {{0.5f, 0.5f, 0}, {0, 0, -1}};
+        ASSERT_EQ(Prism::intersectTriangleBlock(block, outside, 0.001f, 100.0f, hit), -1);
+    }
+}
+
+TEST(TriangleKernelTest, VectorKernelsMatchScalar) {
+    SimdLevelGuard guard;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> pos(-2.0f, 2.0f);
+
+    for (int trial = 0; trial < 2000; ++trial) {
+        TriangleBlock block{};
+        for (int lane = 0; lane < Prism::kTriangleBlockWidth; ++lane) {
+            const float p0[3] = {pos(gen), pos(gen), pos(gen) - 4};
+            const float p1[3] = {pos(gen), pos(gen), pos(gen) - 4};
+            const float p2[3] = {pos(gen), pos(gen), pos(gen) - 4};
+            block.set(lane, p0, p1, p2);
+        }
+        const BlockRay ray = {{0, 0, 0}, {pos(gen) / 4, pos(gen) / 4, -1}};
+
+        Prism::setSimdLevel(SimdLevel::Scalar);
+        BlockHit expected{};
+        const int expected_lane =
+            Prism::intersectTriangleBlock(block, ray, 0.001f, 1e30f, expected);
+        for (SimdLevel level : SupportedLevels()) {
+            Prism::setSimdLevel(level);
+            BlockHit hit{};
+            ASSERT_EQ(Prism::intersectTriangleBlock(block, ray, 0.001f, 1e30f, hit), expected_lane)
+                << Prism::simdLevelName(level);
+            if (expected_lane >= 0) {
+                ASSERT_FLOAT_EQ(hit.t, expected.t);
+                ASSERT_FLOAT_EQ(hit.u, expected.u);
+                ASSERT_FLOAT_EQ(hit.v, expected.v);
+            }
+        }
+    }
+}
+
+TEST(TriangleKernelTest, RejectsUnsupportedLevel) {
+    SimdLevelGuard guard;
+    if (Prism::detectSimdLevel() == SimdLevel::AVX2) {
+        GTEST_SKIP() << "Every level is supported here";
+    }
+    ASSERT_THROW(Prism::setSimdLevel(SimdLevel::AVX2), std::invalid_argument);
+}
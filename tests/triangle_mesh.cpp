@@ -0,0 +1,165 @@
+#include "Prism/material.hpp"
+#include "Prism/obj_loader.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/triangle_mesh.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Prism;
+using std::vector;
+
+namespace {
+
+// Unit quad in the plane z = -5, split into two triangles.
+MeshData Quad() {
+    MeshData mesh;
+    mesh.positions = {-1, -1, -5, 1, -1, -5, 1, 1, -5, -1, 1, -5};
+    mesh.indices = {0, 1, 2, 0, 2, 3};
+    mesh.normal_indices.assign(6, MeshData::kNoIndex);
+    mesh.material_ids = {MeshData::kNoIndex, MeshData::kNoIndex};
+    return mesh;
+}
+
+} // namespace
+
+TEST(TriangleMeshTest, HitsQuad) {
+    TriangleMesh mesh(Quad());
+    ASSERT_EQ(mesh.triangleCount(), 2);
+    ASSERT_EQ(mesh.vertexCount(), 4);
+
+    HitRecord rec;
+    ASSERT_TRUE(mesh.hit(Ray(Point3(0.5, -0.25, 0), Vector3(0, 0, -1)), 0.001L, 100.0L, rec));
+    ASSERT_NEAR(rec.t, 5, kEpsilon);
+    AssertPointAlmostEqual(rec.p, Point3(0.5, -0.25, -5));
+    AssertVectorAlmostEqual(rec.normal, Vector3(0, 0, 1));
+    ASSERT_TRUE(rec.front_face);
+    ASSERT_EQ(rec.material, nullptr);
+
+    ASSERT_FALSE(mesh.hit(Ray(Point3(1.5, 0, 0), Vector3(0, 0, -1)), 0.001L, 100.0L, rec));
+    ASSERT_FALSE(mesh.hit(Ray(Point3(0, 0, 0), Vector3(0, 0, -1)), 0.001L, 4.0L, rec));
+    ASSERT_FALSE(mesh.hit(Ray(Point3(0, 0, 0), Vector3(1, 0, 0)), 0.001L, 100.0L, rec));
+
+    // Distances beyond the float range of the kernel are clamped, not converted as is.
+    const Ray down(Point3(0.5, -0.25, 0), Vector3(0, 0, -1));
+    ASSERT_TRUE(mesh.hit(down, 0.001L, std::numeric_limits<ld>::max(), rec));
+    ASSERT_NEAR(rec.t, 5, kEpsilon);
+    ASSERT_TRUE(mesh.hit(down, 0.001L, std::numeric_limits<ld>::infinity(), rec));
+    ASSERT_TRUE(mesh.occluded(down, 0.001L, std::numeric_limits<ld>::max()));
+
+    AABB box;
+    ASSERT_TRUE(mesh.boundingBox(box));
+    AssertPointAlmostEqual(box.min, Point3(-1, -1, -5));
+    AssertPointAlmostEqual(box.max, Point3(1, 1, -5));
+}
+
+TEST(TriangleMeshTest, InterpolatesNormalsAndSharesMaterials) {
+    MeshData mesh = Quad();
+    mesh.normals = {0, 0, 1, 1, 0, 0};
+    mesh.normal_indices = {0, 1, 0, 0, 0, 0};
+    mesh.material_names = {"red", "green"};
+    mesh.materials.resize(2, MeshMaterial{});
+    mesh.materials[1].kd[1] = 1;
+    mesh.material_ids = {0, 1};
+
+    MaterialTable table;
+    table.add(Material());
+    TriangleMesh first(mesh, &table);
+    TriangleMesh second(mesh, &table);
+    ASSERT_EQ(table.size(), 5);
+
+    HitRecord rec;
+    // Upper-left triangle: flat normal and the second material.
+    ASSERT_TRUE(second.hit(Ray(Point3(-0.5, 0.5, 0), Vector3(0, 0, -1)), 0.001L, 100.0L, rec));
+    AssertVectorAlmostEqual(rec.normal, Vector3(0, 0, 1));
+    ASSERT_EQ(rec.material, &table[4]);
+    ASSERT_EQ(rec.material->kd.y, 1);
+
+    // Lower-right triangle: the normal of vertex 1 pulls the shading normal towards +x.
+    ASSERT_TRUE(first.hit(Ray(Point3(0.5, -0.5, 0), Vector3(0, 0, -1)), 0.001L, 100.0L, rec));
+    ASSERT_GT(rec.normal.x, 0);
+    ASSERT_NEAR(rec.normal.magnitude(), 1, kEpsilon);
+    ASSERT_EQ(rec.material, &table[1]);
+}
+
+TEST(TriangleMeshTest, FallsBackToGeometricNormal) {
+    // Lower-right triangle: opposite vertex normals cancel out half way along the first edge.
+    // Upper-left triangle: zero vertex normals.
+    MeshData mesh = Quad();
+    mesh.normals = {0, 0, 1, 0, 0, -1, 0, 0, 0};
+    mesh.normal_indices = {0, 1, 0, 2, 2, 2};
+    TriangleMesh tri_mesh(mesh);
+
+    HitRecord rec;
+    ASSERT_TRUE(tri_mesh.hit(Ray(Point3(0.5, -0.5, 0), Vector3(0, 0, -1)), 0.001L, 100.0L, rec));
+    AssertVectorAlmostEqual(rec.normal, Vector3(0, 0, 1));
+    ASSERT_TRUE(tri_mesh.hit(Ray(Point3(-0.5, 0.5, 0), Vector3(0, 0, -1)), 0.001L, 100.0L, rec));
+    AssertVectorAlmostEqual(rec.normal, Vector3(0, 0, 1));
+}
+
+TEST(TriangleMeshTest, MatchesLinearScan) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+    MeshData mesh;
+    vector<std::unique_ptr<TriangleMesh>> singles;
+    vector<Object*> objects;
+    for (uint32_t i = 0; i < 300; ++i) {
+        MeshData single;
+        const float cx = pos(gen), cy = pos(gen), cz = pos(gen);
+        for (int k = 0; k < 3; ++k) {
+            const float p[3] = {cx + offset(gen), cy + offset(gen), cz + offset(gen)};
+            single.positions.insert(single.positions.end(), p, p + 3);
+            mesh.positions.insert(mesh.positions.end(), p, p + 3);
+            mesh.indices.push_back(3 * i + k);
+        }
+        single.indices = {0, 1, 2};
+        single.normal_indices.assign(3, MeshData::kNoIndex);
+        single.material_ids = {MeshData::kNoIndex};
+        singles.push_back(std::make_unique<TriangleMesh>(single));
+        objects.push_back(singles.back().get());
+    }
+    mesh.normal_indices.assign(mesh.indices.size(), MeshData::kNoIndex);
+    mesh.material_ids.assign(300, MeshData::kNoIndex);
+    TriangleMesh accelerated(mesh);
+
+    std::uniform_real_distribution<double> dir(-1.0, 1.0);
+    int hits = 0;
+    for (int i = 0; i < 500; ++i) {
+        Ray ray(Point3(0, 0, 0), Vector3(dir(gen), dir(gen), dir(gen)));
+        HitRecord expected = ray.Gethit(objects, 0.001L, 1000.0L);
+        HitRecord rec;
+        bool hit = accelerated.hit(ray, 0.001L, 1000.0L, rec);
+        ASSERT_EQ(hit, expected.t < 1000.0L);
+        if (hit) {
+            ++hits;
+            ASSERT_NEAR(rec.t, expected.t, kEpsilon);
+        }
+    }
+    ASSERT_GT(hits, 0);
+}
+
+TEST(TriangleMeshTest, RejectsInvalidIndicesAndStaysCompact) {
+    MeshData bad_vertex = Quad();
+    bad_vertex.indices[4] = 4;
+    ASSERT_THROW(TriangleMesh{bad_vertex}, std::invalid_argument);
+
+    MeshData bad_normal = Quad();
+    bad_normal.normal_indices[0] = 0;
+    ASSERT_THROW(TriangleMesh{bad_normal}, std::invalid_argument);
+
+    MeshData bad_material = Quad();
+    bad_material.material_ids[1] = 0;
+    ASSERT_THROW(TriangleMesh{bad_material}, std::invalid_argument);
+
+    // A 64x64 grid: shared vertices, 32-bit indices and 16-bit ids take about 20 bytes a triangle.
+    TriangleMesh mesh(GridMesh(64, 64, [](float, float) { return 0.0f; }));
+    ASSERT_LT(mesh.memoryUsage() / mesh.triangleCount(), 24);
+}
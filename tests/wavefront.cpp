@@ -0,0 +1,166 @@
+#include "Prism/wavefront.hpp"
+#include "Prism/accumulator.hpp"
+#include "Prism/camera.hpp"
+#include "Prism/objects.hpp"
+#include "Prism/point.hpp"
+#include "Prism/ray.hpp"
+#include "Prism/renderer.hpp"
+#include "Prism/scene.hpp"
+#include "Prism/vector.hpp"
+#include "TestHelpers.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace Prism;
+
+namespace {
+
+// Coloured point lights at the first two light positions of the scene.
+std::vector<PointLight> Lights(const LitScene& lit) {
+    return {{lit.lights[0], Vector3(20, 18, 15)}, {lit.lights[1], Vector3(5, 10, 20)}};
+}
+
+Camera LitCamera() {
+    return Camera(Point3(0, 2, 2), Point3(0, 0, -5), Vector3(0, 1, 0), 1.0, 2.0, 2.0, 20, 30);
+}
+
+} // namespace
+
+TEST(WavefrontTest, FurnaceGathersEveryBounce) {
+    // Inside a closed sphere that emits 1 and reflects half, a path of n bounces sees
+    // 1 + 1/2 + ... + 1/2^n wherever it goes.
+    TestSphere shell(Point3(0, 0, 0), 5);
+    const Scene scene({&shell});
+    Camera cam(Point3(1, 0, 0), Point3(0, 0, -1), Vector3(0, 1, 0), 1.0, 2.0, 3.0, 8, 12);
+
+    WavefrontSettings settings;
+    settings.max_depth = 3;
+    settings.roulette_depth = 100;
+    settings.default_material.ke = Vector3(1, 1, 1);
+    settings.chunk_size = 10;
+    WavefrontIntegrator integrator(2, settings);
+    Accumulator accumulator(12, 8);
+    integrator.renderPass(cam, scene, accumulator);
+    integrator.renderPass(cam, scene, accumulator);
+
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 12; ++x) {
+            ASSERT_EQ(accumulator.samples(x, y), 2u);
+            AssertVectorAlmostEqual(accumulator.mean(x, y), Vector3(1.875, 1.875, 1.875), 1e-5);
+        }
+    }
+    const WavefrontStats& stats = integrator.stats();
+    ASSERT_EQ(stats.extension_rays, 2u * 4 * 12 * 8);
+    ASSERT_EQ(stats.shadow_rays, 0u);
+    for (int stage = 0; stage < kWavefrontStageCount; ++stage) {
+        ASSERT_GE(stats.stage_seconds[stage], 0);
+    }
+    ASSERT_STREQ(wavefrontStageName(WavefrontStage::Extend), "extend");
+
+    // Russian roulette ends paths early but keeps the same expected value.
+    settings.roulette_depth = 1;
+    integrator.setSettings(settings);
+    Accumulator roulette(12, 8);
+    for (int pass = 0; pass < 64; ++pass) {
+        integrator.renderPass(cam, scene, roulette);
+    }
+    ld sum = 0;
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 12; ++x) {
+            sum += roulette.mean(x, y).x;
+        }
+    }
+    ASSERT_NEAR(sum / (12 * 8), 1.875, 0.02);
+    ASSERT_LT(integrator.stats().extension_rays, 2u * 4 * 12 * 8 + 64u * 4 * 12 * 8);
+}
+
+TEST(WavefrontTest, DirectLightMatchesRenderer) {
+    const LitScene lit;
+    const Camera cam = LitCamera();
+    WavefrontSettings settings;
+    settings.max_depth = 0;
+    settings.background = Vector3(0.1, 0.2, 0.3);
+    WavefrontIntegrator integrator(2, settings);
+    const std::vector<PointLight> lights = Lights(lit);
+    integrator.setLights(lights);
+    Accumulator wavefront(cam.pixel_width, cam.pixel_height);
+
+    const ld pi = std::acos(ld(-1));
+    const Renderer::SampledShader direct = [&](const Ray& ray, Sampler&) {
+        HitRecord rec;
+        if (!lit.scene.hit(ray, settings.ray_epsilon, 1e30L, rec)) {
+            return settings.background;
+        }
+        Vector3 color(0, 0, 0);
+        for (const PointLight& light : lights) {
+            const Vector3 to_light = light.position - rec.p;
+            const ld distance = to_light.magnitude();
+            const ld cosine = rec.normal.dot(to_light) / distance;
+            if (cosine > 0 && !lit.scene.occluded(Ray(rec.p, to_light), settings.ray_epsilon,
+                                                  distance - settings.ray_epsilon)) {
+                color = color + light.intensity * (ld(0.5) * cosine / (pi * distance * distance));
+            }
+        }
+        return color;
+    };
+    Accumulator expected(cam.pixel_width, cam.pixel_height);
+    Renderer renderer(2, 8);
+    for (int pass = 0; pass < 2; ++pass) {
+        integrator.renderPass(cam, lit.scene, wavefront);
+        renderer.renderPass(cam, direct, expected);
+    }
+
+    for (int y = 0; y < cam.pixel_height; ++y) {
+        for (int x = 0; x < cam.pixel_width; ++x) {
+            AssertVectorAlmostEqual(wavefront.mean(x, y), expected.mean(x, y), 1e-4);
+        }
+    }
+    ASSERT_GT(integrator.stats().shadow_rays, 0u);
+}
+
+TEST(WavefrontTest, PassesDoNotDependOnThreads) {
+    const LitScene lit;
+    const Camera cam = LitCamera();
+    WavefrontSettings settings;
+    settings.max_depth = 5;
+    settings.roulette_depth = 1;
+    settings.background = Vector3(0.2, 0.2, 0.3);
+
+    std::vector<Accumulator> results;
+    for (size_t threads : {1, 4}) {
+        settings.chunk_size = threads == 1 ? 4096 : 7;
+        WavefrontIntegrator integrator(threads, settings);
+        integrator.setLights(Lights(lit));
+        results.emplace_back(cam.pixel_width, cam.pixel_height);
+        for (int pass = 0; pass < 3; ++pass) {
+            integrator.renderPass(cam, lit.scene, results.back());
+        }
+    }
+    for (int y = 0; y < cam.pixel_height; ++y) {
+        for (int x = 0; x < cam.pixel_width; ++x) {
+            ASSERT_EQ(results[0].mean(x, y).x, results[1].mean(x, y).x);
+            ASSERT_EQ(results[0].mean(x, y).y, results[1].mean(x, y).y);
+            ASSERT_EQ(results[0].mean(x, y).z, results[1].mean(x, y).z);
+        }
+    }
+}
+
+TEST(WavefrontTest, RejectsInvalidInput) {
+    WavefrontSettings settings;
+    settings.chunk_size = 0;
+    ASSERT_THROW(WavefrontIntegrator(1, settings), std::invalid_argument);
+    settings.chunk_size = 16;
+    settings.max_depth = -1;
+    ASSERT_THROW(WavefrontIntegrator(1, settings), std::invalid_argument);
+
+    WavefrontIntegrator integrator(1);
+    const LitScene lit;
+    const Camera cam = LitCamera();
+    Accumulator wrong(cam.pixel_width + 1, cam.pixel_height);
+    ASSERT_THROW(integrator.renderPass(cam, lit.scene, wrong), std::invalid_argument);
+    Scene unbuilt;
+    Accumulator accumulator(cam.pixel_width, cam.pixel_height);
+    ASSERT_THROW(integrator.renderPass(cam, unbuilt, accumulator), std::logic_error);
+}